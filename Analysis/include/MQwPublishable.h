@@ -68,6 +68,17 @@ class MQwPublishable_child {
      * @return Pointer to the variable's data element, or nullptr if not found
      */
     const VQwHardwareChannel* RequestExternalPointer(const TString& name) const;
+    /**
+     * \brief Bind a pointer to an external variable by name
+     * Resolves the variable the first time it is called (after the parent has
+     * published its values) and keeps a const pointer to the data element,
+     * which stays valid for the whole run.  Per-event code then reads the
+     * source directly instead of looking it up by name and copying it.
+     * @param name Name of the desired variable
+     * @param value Bound pointer; only resolved while it is null
+     * @return True if the variable is bound, false if not found
+     */
+    Bool_t BindExternalValue(const TString& name, const VQwHardwareChannel*& value) const;
     /**
       * \brief Publish a variable from this child into the parent container.
       * @param name    Variable key to publish under.
@@ -17,6 +17,7 @@
 class TTree;
 class QwBlinder;
 class QwParameterFile;
+class QwADC18_BankDecoder;
 #ifdef __USE_DATABASE__
 class QwErrDBInterface;
 #endif
@@ -46,6 +47,16 @@ class QwADC18_Channel: public VQwHardwareChannel, public MQwMockable {
 
   static const Double_t kTimePerSample;
 
+  /// Fields of one ADC18 data word, as extracted by DecodeDataWord
+  struct DataWord {
+    UInt_t rawd;   ///< Raw data word
+    UInt_t dtype;  ///< Data type (0 diff, 1 peak, 2 base, 4 DAC)
+    UInt_t dvalue; ///< Divider value
+    UInt_t snum;   ///< Sample number (peak and base words only)
+    UInt_t value;  ///< Value field, sign extended for diff words
+  };
+  static DataWord DecodeDataWord(UInt_t rawd);
+
   using MQwMockable::LoadMockDataParameters;
 
   using VQwHardwareChannel::GetRawValue;
@@ -103,6 +114,7 @@ class QwADC18_Channel: public VQwHardwareChannel, public MQwMockable {
   };
 
   void  ClearEventData() override;
+  void  ClearRunState() override;
 
   /// Internally generate random event data
   void  RandomizeEventData(int helicity = 0.0, double time = 0.0) override;
@@ -124,6 +136,7 @@ class QwADC18_Channel: public VQwHardwareChannel, public MQwMockable {
   /// Decode the event data from a CODA buffer
   Bool_t IsHeaderWord(UInt_t word) const;
   Int_t ProcessDataWord(UInt_t word);
+  Int_t ProcessDataWord(const DataWord& word);
   Int_t ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left, UInt_t index = 0) override;
 
   /// Process the event data according to pedestal and calibration factor
@@ -132,6 +145,8 @@ class QwADC18_Channel: public VQwHardwareChannel, public MQwMockable {
   QwADC18_Channel& operator=  (const QwADC18_Channel &value);
   void AssignScaledValue(const QwADC18_Channel &value, Double_t scale);
   void AssignValueFrom(const VQwDataElement* valueptr) override;
+  void PackEventData(std::vector<char>& record) const override;
+  void UnpackEventData(const char*& record) override;
   void AddValueFrom(const VQwHardwareChannel* valueptr) override;
   void SubtractValueFrom(const VQwHardwareChannel* valueptr) override;
   void MultiplyBy(const VQwHardwareChannel* valueptr) override;
@@ -263,6 +278,12 @@ class QwADC18_Channel: public VQwHardwareChannel, public MQwMockable {
  protected:
   QwADC18_Channel& operator/= (const QwADC18_Channel &value);
 
+ private:
+  /// Decode this channel from the buffer, or from the words pre-decoded by the bank decoder
+  Int_t DecodeEvBuffer(UInt_t* buffer, UInt_t num_words_left, const DataWord* decoded);
+
+  friend class QwADC18_BankDecoder;
+
  private:
   UInt_t   fDiff_Raw;
   UInt_t   fBase_Raw;
@@ -337,3 +358,57 @@ class QwADC18_Channel: public VQwHardwareChannel, public MQwMockable {
   const static Bool_t bDEBUG=kFALSE;///<debugging display purposes
 
 };
+
+
+/**
+ * \class QwADC18_BankDecoder
+ * \ingroup QwAnalysis_ADC
+ * \brief Decodes a complete ADC18 bank once for all channels in it
+ *
+ * Walks the modules of a ROC bank in a single pass, checks the module
+ * header and data words, and stores the decoded fields of every word in
+ * a flat array indexed by the word offset in the bank.  While a bank is
+ * active, QwADC18_Channel::ProcessEvBuffer takes its words from this
+ * array instead of unpacking them again; words in modules that fail the
+ * checks are left to the per-channel decoder.
+ *
+ * With SetVerify(kTRUE) every channel is also decoded by the per-channel
+ * decoder and the two results are compared, as a self-test on recorded
+ * banks.
+ */
+class QwADC18_BankDecoder {
+ public:
+  QwADC18_BankDecoder()
+  : fBank(0), fNumWords(0), fVerify(kFALSE),
+    fNumberOfBanks(0), fNumberOfComparisons(0), fNumberOfMismatches(0) { };
+  ~QwADC18_BankDecoder();
+
+  /// Decode the bank and make it the active bank for this thread
+  Bool_t Decode(const UInt_t* buffer, UInt_t num_words);
+  /// Stop serving channels from this bank
+  void Release();
+
+  /// Active bank decoder for this thread, or NULL
+  static QwADC18_BankDecoder* GetActive() { return fActive; };
+
+  /// Decoded words starting at this buffer position, or NULL if not in a decoded module
+  const QwADC18_Channel::DataWord* Find(const UInt_t* word) const;
+
+  void   SetVerify(Bool_t verify) { fVerify = verify; };
+  Bool_t IsVerifying() const { return fVerify; };
+  void   RecordComparison(const QwADC18_Channel& channel, Bool_t match);
+  UInt_t GetNumberOfMismatches() const { return fNumberOfMismatches; };
+
+ private:
+  const UInt_t* fBank;   ///< Start of the active bank
+  UInt_t fNumWords;      ///< Number of words in the active bank
+  std::vector<QwADC18_Channel::DataWord> fWords; ///< Decoded words, by offset in the bank
+  std::vector<Bool_t> fDecoded; ///< Whether the word at this offset was decoded
+
+  Bool_t fVerify;        ///< Compare against the per-channel decoder
+  UInt_t fNumberOfBanks;
+  UInt_t fNumberOfComparisons;
+  UInt_t fNumberOfMismatches;
+
+  static thread_local QwADC18_BankDecoder* fActive;
+};
@@ -0,0 +1,74 @@
+/*!
+ * \file   QwBlockChannelValues.h
+ * \brief  Packed event values of a block-integrating ADC channel
+ */
+
+#pragma once
+
+// System headers
+#include <cstring>
+
+// ROOT headers
+#include "Rtypes.h"
+
+/**
+ * \class QwBlockChannelValues
+ * \ingroup QwAnalysis_ADC
+ * \brief Packed event values of a VQWK or Moller ADC channel
+ *
+ * Holds the four block values and the hardware sum as five lanes, with
+ * their second moments and the scalar event fields, so that derived
+ * devices can combine several channels in one pass over plain arrays
+ * instead of through a sequence of whole-channel operations.
+ *
+ * All channel arithmetic works lane by lane, so a device kernel that
+ * runs the complete chain of operations for one lane at a time gives
+ * the same bits as the chain of channel operations, provided it keeps
+ * the order of the floating point operations of the channel code.
+ */
+class QwBlockChannelValues {
+ public:
+  static const Int_t kBlocks = 4;           ///< Number of blocks
+  static const Int_t kLanes = kBlocks + 1;  ///< Blocks and the hardware sum
+  static const Int_t kSum = kBlocks;        ///< Lane of the hardware sum
+
+  Double_t fValue[kLanes];      ///< Block values and hardware sum
+  Double_t fValueM2[kLanes];    ///< Second moments of the lanes
+  Double_t fSumError;           ///< Uncertainty on the hardware sum
+  UInt_t   fNumberOfSamples;
+  UInt_t   fSequenceNumber;
+  UInt_t   fGoodEventCount;
+  UInt_t   fErrorFlag;
+
+  /**
+   * Divide one lane in place as operator/= of the channels does, including
+   * the propagation of the second moment and the treatment of zeros: a
+   * zero block gives zero, while a non-zero hardware sum divided by zero
+   * keeps the numerator.
+   */
+  static void DivideLane(Int_t lane, Double_t& value, Double_t& valueM2,
+                         Double_t denom, Double_t denomM2) {
+    if (value != 0.0 && denom != 0.0) {
+      Double_t ratio = value / denom;
+      valueM2 = ratio * ratio *
+        (valueM2 / value / value + denomM2 / denom / denom);
+      value = ratio;
+    } else if (value == 0.0 || lane != kSum) {
+      value = 0.0;
+      valueM2 = 0.0;
+    } else {
+      valueM2 = 0.0;
+    }
+  }
+
+  /// Bitwise comparison, for the self-tests against the channel arithmetic
+  Bool_t IsIdentical(const QwBlockChannelValues& value) const {
+    return std::memcmp(fValue, value.fValue, sizeof(fValue)) == 0
+      && std::memcmp(fValueM2, value.fValueM2, sizeof(fValueM2)) == 0
+      && std::memcmp(&fSumError, &value.fSumError, sizeof(fSumError)) == 0
+      && fNumberOfSamples == value.fNumberOfSamples
+      && fSequenceNumber == value.fSequenceNumber
+      && fGoodEventCount == value.fGoodEventCount
+      && fErrorFlag == value.fErrorFlag;
+  }
+};
@@ -19,6 +19,7 @@
 
 #include "MQwCodaControlEvent.h"
 #include "QwParameterFile.h"
+#include "QwEventIndex.h"
 
 #include <unordered_map>
 
@@ -83,6 +84,8 @@ class QwEventBuffer {
 
   /// \brief Sets internal flags based on the QwOptions
   void ProcessOptions(QwOptions &options);
+  /// \brief Use and build event index files, independent of the options
+  void SetUseEventIndex(Bool_t use = kTRUE) { fUseEventIndex = use; };
 
   void PrintRunTimes();
 
@@ -117,6 +120,9 @@ class QwEventBuffer {
 
   Int_t ReOpenStream();
 
+  /// \brief Read up to the next EPICS event, seeking with the event index when possible
+  Int_t GetNextEPICSEvent();
+
   Int_t OpenDataFile(UInt_t current_run, Short_t seg);
   Int_t OpenDataFile(UInt_t current_run, const TString rw = "R");
   Int_t OpenDataFile(const TString filename, const TString rw = "R");
@@ -216,6 +222,20 @@ class QwEventBuffer {
 
   std::pair<Int_t, Int_t> fSegmentRange;
 
+ protected:
+  ///  Event index of the current data file
+  QwEventIndex fEventIndex;
+  Bool_t  fUseEventIndex;      ///< Use and build event index files
+  TString fEventIndexDir;      ///< Directory for event index files
+  Bool_t  fEventIndexLoaded;   ///< The current file is indexed and opened for random access
+  Bool_t  fBuildingEventIndex; ///< The current file is being indexed while it is read
+  UInt_t  fNextEventPosition;  ///< Position of the next event in the current file
+  UInt_t  fSeekTarget;         ///< Event number of the last seek
+  std::vector<UInt_t> fSeekPlan; ///< Positions still to be read before reaching the seek target
+  size_t  fSeekStep;           ///< Next entry in the seek plan
+
+  void FinishEventIndex();
+
  protected:
 
   static std::string fDefaultDataDirectory;
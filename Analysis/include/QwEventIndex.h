@@ -0,0 +1,85 @@
+/*!
+ * \file   QwEventIndex.h
+ * \brief  Sidecar index of event positions in a CODA data file
+ */
+
+#pragma once
+
+// System headers
+#include <vector>
+
+// ROOT headers
+#include "Rtypes.h"
+#include "TString.h"
+
+/**
+ * \class QwEventIndex
+ * \ingroup QwAnalysis
+ * \brief Index of the positions of events in a CODA data file
+ *
+ * The index records the position (the number of events before it in the
+ * file) of every non-physics event (EPICS, ROC configuration and control
+ * events), and of one physics event in every kPhysicsStride.  It is kept
+ * in a small text file next to the data file (or in a separate index
+ * directory), together with the size and modification time of the data
+ * file so that stale indices are ignored.
+ *
+ * QwEventBuffer builds the index while it reads a file from start to end,
+ * and uses it to seek directly to the start of an event range, or to the
+ * next EPICS event, when the file can be opened for random access.
+ */
+class QwEventIndex {
+ public:
+  /// Kind of an indexed event
+  enum EQwIndexedEventType {
+    kPhysicsEvent = 'P',
+    kEPICSEvent = 'E',
+    kROCConfigurationEvent = 'C',
+    kOtherEvent = 'O'
+  };
+  /// Physics events between two indexed physics events
+  static const UInt_t kPhysicsStride;
+
+  /// One indexed event
+  struct Entry {
+    UInt_t fPosition;    ///< Number of events before this one in the file
+    UInt_t fEventNumber; ///< CODA event number
+    Char_t fType;        ///< EQwIndexedEventType
+  };
+
+ public:
+  QwEventIndex(): fDataFileSize(0), fDataFileTime(0), fNumberOfEvents(0), fLastPhysicsEvent(0) { };
+  virtual ~QwEventIndex() { };
+
+  /// \brief Index file name for a data file, in the given directory (or next to the data file)
+  static TString GetIndexFileName(const TString& datafile, const TString& indexdir = "");
+
+  /// \brief Start a new index for a data file
+  void  Clear(const TString& datafile);
+  /// \brief Add the event at this position in the file
+  void  AddEvent(UInt_t position, UInt_t evtnum, EQwIndexedEventType type);
+  /// \brief Mark the index complete after reading the whole file
+  void  SetNumberOfEvents(UInt_t nevents) { fNumberOfEvents = nevents; };
+  /// \brief Whether the index covers a whole data file
+  Bool_t IsComplete() const { return fNumberOfEvents > 0; };
+
+  /// \brief Read the index for a data file; fails when it is missing or stale
+  Bool_t Read(const TString& indexfile, const TString& datafile);
+  /// \brief Write the index file
+  Bool_t Write(const TString& indexfile) const;
+
+  /// \brief Position of the first EPICS event at or after a position, or -1
+  Int_t FindNextEPICSEvent(UInt_t position) const;
+  /// \brief Positions to read to reach a physics event number from a position
+  Bool_t GetSeekPlan(UInt_t evtnum, UInt_t position, std::vector<UInt_t>& plan) const;
+
+ private:
+  /// \brief Size and modification time of a data file
+  static Bool_t GetFileStamp(const TString& datafile, Long64_t& size, Long64_t& time);
+
+  Long64_t fDataFileSize;     ///< Size of the indexed data file
+  Long64_t fDataFileTime;     ///< Modification time of the indexed data file
+  UInt_t   fNumberOfEvents;   ///< Number of events in the file (zero while building)
+  UInt_t   fLastPhysicsEvent; ///< Event number of the last indexed physics event
+  std::vector<Entry> fEntries; ///< Indexed events, in file order
+};
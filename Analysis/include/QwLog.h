@@ -11,6 +11,8 @@
 // System headers
 #include <iostream>
 #include <iomanip>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 using std::string;
@@ -28,35 +30,168 @@ using std::string;
 // Forward declarations
 class QwOptions;
 
+/*! \def QW_LOG_MAX_LEVEL
+ *  \brief Highest log level that is compiled in
+ *
+ * Log statements above this level are removed by the compiler, including the
+ * evaluation of their arguments.  Compile with e.g. -DQW_LOG_MAX_LEVEL=2 to
+ * remove all verbose and debug output (this is done when WITH_DEBUG is off).
+ */
+#ifndef QW_LOG_MAX_LEVEL
+#define QW_LOG_MAX_LEVEL 4
+#endif
+
+/*! \def QwLogAt
+ *  \brief Log drain for a level that is only evaluated when the level is active
+ *
+ * The arguments streamed into the drain are not evaluated (nor formatted) when
+ * nothing would be printed.  The drain is a single expression, so that it
+ * can follow an unbraced 'if' without taking its 'else', and it holds the
+ * log lock until the end of the statement (see QwLogGuard).
+ */
+#define QwLogAt(level) \
+  (! gQwLog.IsActive(level)) ? (void) 0 : \
+  QwLogVoidify() & QwLogGuard()(level,__PRETTY_FUNCTION__)
+
+/*! \def QwLogLimited
+ *  \brief Rate-limited log drain, with a separate limit for every call site
+ *         and instance
+ *
+ * The first 'max' messages of a call site for an instance (usually 'this')
+ * are printed, after that only the messages when the number of occurrences
+ * reaches 2*max, 4*max, 8*max, etc.  Printed messages are prefixed with the
+ * number of suppressed messages.  The limit 'max' must be a constant.
+ */
+#define QwLogLimited(level,instance,max) \
+  (! gQwLog.IsActive(level) \
+   || ! ([]() -> QwLogRateLimit& { \
+           static QwLogRateLimit qw_log_rate_limit(__FILE__,__LINE__,max); \
+           return qw_log_rate_limit; }()).Allow(instance)) ? (void) 0 : \
+  QwLogVoidify() & QwLogGuard()(level,__PRETTY_FUNCTION__) << QwLogRateLimit::Prefix()
+
 /*! \def QwOut
  *  \brief Predefined log drain for explicit output
  */
-#define QwOut      gQwLog(QwLog::kAlways,__PRETTY_FUNCTION__)
+#define QwOut      QwLogGuard()(QwLog::kAlways,__PRETTY_FUNCTION__)
 
 /*! \def QwError
  *  \brief Predefined log drain for errors
  */
-#define QwError    gQwLog(QwLog::kError,__PRETTY_FUNCTION__)
+#define QwError    QwLogAt(QwLog::kError)
 
 /*! \def QwWarning
  *  \brief Predefined log drain for warnings
  */
-#define QwWarning  gQwLog(QwLog::kWarning,__PRETTY_FUNCTION__)
+#define QwWarning  QwLogAt(QwLog::kWarning)
 
 /*! \def QwMessage
  *  \brief Predefined log drain for regular messages
  */
-#define QwMessage  gQwLog(QwLog::kMessage,__PRETTY_FUNCTION__)
+#define QwMessage  QwLogAt(QwLog::kMessage)
 
 /*! \def QwVerbose
  *  \brief Predefined log drain for verbose messages
  */
-#define QwVerbose  if (gQwLog.GetLogLevel() >= QwLog::kVerbose) gQwLog(QwLog::kVerbose,__PRETTY_FUNCTION__)
+#define QwVerbose  QwLogAt(QwLog::kVerbose)
 
 /*! \def QwDebug
  *  \brief Predefined log drain for debugging output
  */
-#define QwDebug    if (gQwLog.GetLogLevel() >= QwLog::kDebug) gQwLog(QwLog::kDebug,__PRETTY_FUNCTION__)
+#define QwDebug    QwLogAt(QwLog::kDebug)
+
+/*! \def QwErrorLimited
+ *  \brief Rate-limited log drain for errors in per-event code
+ */
+#define QwErrorLimited(instance,max)    QwLogLimited(QwLog::kError,instance,max)
+
+/*! \def QwWarningLimited
+ *  \brief Rate-limited log drain for warnings in per-event code
+ */
+#define QwWarningLimited(instance,max)  QwLogLimited(QwLog::kWarning,instance,max)
+
+/*! \def QwMessageLimited
+ *  \brief Rate-limited log drain for regular messages in per-event code
+ */
+#define QwMessageLimited(instance,max)  QwLogLimited(QwLog::kMessage,instance,max)
+
+
+/**
+ *  \class QwLogVoidify
+ *  \ingroup QwAnalysis
+ *  \brief Turns a log statement into a void expression
+ *
+ * Should not be used directly; it lets QwLogAt be a conditional expression.
+ * The operator& binds more loosely than the streamed operator<<, so the
+ * whole statement is streamed before it is discarded.
+ */
+class QwLogVoidify {
+  public:
+    void operator&(std::ostream&) { };
+};
+
+
+/**
+ *  \class QwLogRateLimit
+ *  \ingroup QwAnalysis
+ *  \brief Occurrence counters of a rate-limited log call site, per instance
+ *
+ * Should not be used directly; use the QwLogLimited macros instead.  Every
+ * instance (e.g. every channel) logging from the call site has its own
+ * counter, so that a noisy channel does not hide the messages of the
+ * others.  The counters are guarded by a mutex, since the subsystems of an
+ * event can be processed concurrently.  The number of suppressed messages
+ * is reported when the program exits.
+ */
+class QwLogRateLimit {
+
+  public:
+
+    /*! \brief The constructor
+     */
+    QwLogRateLimit(const char* file, int line, unsigned long max)
+    : fFile(file), fLine(line), fMax(max > 0? max: 1),
+      fCount(0), fTotalSuppressed(0) { };
+
+    /*! \brief The destructor reports the total number of suppressed messages
+     */
+    ~QwLogRateLimit();
+
+    /*! \brief Count an occurrence for an instance and determine whether it
+     *         should be printed
+     */
+    bool Allow(const void* instance);
+
+    /*! \brief Prefix of the message allowed last on this thread, with the
+     *         number of messages suppressed before it
+     */
+    struct Prefix { };
+    friend std::ostream& operator<<(std::ostream& stream, const Prefix&) {
+      if (fReportSuppressed > 0)
+        stream << "[" << fReportSuppressed << " similar messages suppressed] ";
+      return stream;
+    };
+
+  private:
+
+    /// Occurrences for one instance
+    struct Counter {
+      unsigned long fCount;
+      unsigned long fNext;
+      unsigned long fSuppressed;
+      Counter(): fCount(0), fNext(0), fSuppressed(0) { };
+    };
+
+    const char*   fFile;
+    int           fLine;
+    unsigned long fMax;
+    unsigned long fCount;
+    unsigned long fTotalSuppressed;
+    std::map<const void*, Counter> fCounters;
+    std::mutex    fMutex;
+
+    /// Suppressed messages to report with the message allowed last on this thread
+    static thread_local unsigned long fReportSuppressed;
+};
 
 
 /**
@@ -132,6 +267,15 @@ class QwLog : public std::ostream {
       return std::max(fScreenThreshold, fFileThreshold);
     };
 
+    /*! \brief Determine whether output at this level could be printed at all
+     */
+    bool                        IsActive(const QwLogLevel level) const {
+      if (level > QW_LOG_MAX_LEVEL) return false;
+      if (! fDebugFunctionRegexString.empty()) return true;
+      return (fScreen && level <= fScreenThreshold)
+          || (fFile   && level <= fFileThreshold);
+    };
+
     /*! \brief Set the stream log level
      */
     QwLog&                      operator()(const QwLogLevel level,
@@ -177,6 +321,9 @@ class QwLog : public std::ostream {
     //! File thresholds and stream
     QwLogLevel    fFileThreshold;
     std::ostream *fFile;
+    //! Buffer that writes the file from a separate thread (if enabled)
+    std::streambuf *fFileBuffer;
+    bool          fUseAsyncFile;
     //! Log level of this stream
     QwLogLevel fLogLevel;
 
@@ -195,6 +342,41 @@ class QwLog : public std::ostream {
     static bool fScreenInColor;
     static bool fScreenAtNewLine;
 
+    //! Lock held by the statements streaming into the log
+    std::recursive_mutex fMutex;
+    friend class QwLogGuard;
+
 };
 
 extern QwLog gQwLog;
+
+
+/**
+ *  \class QwLogGuard
+ *  \ingroup QwAnalysis
+ *  \brief Holds the log lock while a statement streams into the log
+ *
+ * Should not be used directly; the predefined drains create one.  A
+ * temporary lives until the end of the full expression that creates it, so
+ * the guard keeps the messages of other threads (e.g. from subsystems that
+ * are processed concurrently) out of the line until the statement, with its
+ * QwLog::endl, is complete.  The lock is recursive, so that the arguments
+ * of a message may log themselves.
+ */
+class QwLogGuard {
+
+  public:
+
+    QwLogGuard() { gQwLog.fMutex.lock(); };
+    ~QwLogGuard() { gQwLog.fMutex.unlock(); };
+
+    QwLogGuard(const QwLogGuard&) = delete;
+    QwLogGuard& operator=(const QwLogGuard&) = delete;
+
+    /*! \brief Set the stream log level, as QwLog::operator()
+     */
+    QwLog& operator()(const QwLog::QwLogLevel level,
+                      const std::string func_sig = "<unknown>") {
+      return gQwLog(level, func_sig);
+    };
+};
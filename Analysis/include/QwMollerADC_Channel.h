@@ -21,6 +21,8 @@
 
 // Forward declarations
 class QwBlinder;
+class QwBlockChannelValues;
+class QwMollerADC_BankDecoder;
 class QwParameterFile;
 #ifdef __USE_DATABASE__
 class QwErrDBInterface;
@@ -125,6 +127,7 @@ class QwMollerADC_Channel: public VQwHardwareChannel, public MQwMockable {
   };
 
   void  ClearEventData() override;
+  void  ClearRunState() override;
 
   /// Internally generate random event data
   void  RandomizeEventData(int helicity = 0.0, double time = 0.0) override;
@@ -154,6 +157,8 @@ class QwMollerADC_Channel: public VQwHardwareChannel, public MQwMockable {
   QwMollerADC_Channel& operator=  (const QwMollerADC_Channel &value);
   void AssignScaledValue(const QwMollerADC_Channel &value, Double_t scale);
   void AssignValueFrom(const VQwDataElement* valueptr) override;
+  void PackEventData(std::vector<char>& record) const override;
+  void UnpackEventData(const char*& record) override;
   void AddValueFrom(const VQwHardwareChannel* valueptr) override;
   void SubtractValueFrom(const VQwHardwareChannel* valueptr) override;
   void MultiplyBy(const VQwHardwareChannel* valueptr) override;
@@ -180,6 +185,12 @@ class QwMollerADC_Channel: public VQwHardwareChannel, public MQwMockable {
   void AddChannelOffset(Double_t Offset);
   void Scale(Double_t Offset) override;
 
+  /// \brief Copy the event values into a packed record
+  void GetBlockValues(QwBlockChannelValues& values) const;
+  /// \brief Set the event values from a packed record, as the arithmetic
+  ///        operations would (the raw values are not touched)
+  void SetBlockValues(const QwBlockChannelValues& values);
+
 
   /**
    * Accumulate event values into the running sum with optional scaling.
@@ -314,6 +325,18 @@ private:
   Int_t GetRawHardwareSum() const       { return GetRawValue(0);};
   Int_t GetRawSoftwareSum() const {return fSoftwareBlockSum_raw;};
 
+  /// Decode this channel from the buffer with the per-channel decoder
+  Int_t DecodeEvBuffer(UInt_t* buffer, UInt_t num_words_left);
+  /// Take this channel from a record decoded by the bank decoder
+  Int_t LoadDecodedRecord(const QwMollerADC_BankDecoder& bank, UInt_t record);
+  /// Hardware checks which depend only on the raw data of this event
+  static UInt_t RawHWChecks(Int_t hardwaresum, Int_t softwaresum) {
+    return (hardwaresum != softwaresum ? kErrorFlag_SW_HW : 0)
+         | (hardwaresum == 0 ? kErrorFlag_ZeroHW : 0);
+  };
+
+  friend class QwMollerADC_BankDecoder;
+
  private:
   static const Bool_t kDEBUG;
   static const Int_t  kWordsPerChannel; //no.of words per channel in the CODA buffer
@@ -369,6 +392,9 @@ private:
   UInt_t fNumberOfSamples;     ///< Number of samples  read through the module
   UInt_t fNumberOfSamples_map; ///< Number of samples in the expected to  read through the module. This value is set in the QwBeamline map file
 
+  UInt_t fRawHWChecks = 0;            ///< Raw data hardware checks of this event, from the decoder
+  Bool_t fHasRawHWChecks = kFALSE;    ///< Whether the decoder set fRawHWChecks for this event
+
 
   // Set of error counters for each HW test.
   Int_t fErrorCount_HWSat;    ///< check to see ADC channel is saturated
@@ -389,6 +415,7 @@ private:
   Int_t fSequenceNo_Prev; ///< Keep the sequence number of the last event
   Int_t fSequenceNo_Counter; ///< Internal counter to keep track of the sequence number
   Double_t fPrev_HardwareBlockSum; ///< Previous Module-based sum of the four sub-blocks
+  UInt_t fMockSequenceNumber; ///< Number of mock data events encoded for this channel
 
 
 
@@ -413,4 +440,72 @@ private:
 
 
 
+};
+
+
+/**
+ * \class QwMollerADC_BankDecoder
+ * \ingroup QwAnalysis_ADC
+ * \brief Decodes all MollerADC channel records of a bank in one pass
+ *
+ * The records of all channels of all modules in a bank are unpacked at
+ * once into flat arrays, one per field, together with the hardware checks
+ * which depend only on the raw data of the event: the mismatch of the
+ * software and hardware block sums, and the zero hardware sum.  While a
+ * bank is active, QwMollerADC_Channel::ProcessEvBuffer takes its record
+ * from these arrays instead of unpacking it again.
+ *
+ * With SetVerify(kTRUE) every channel is also decoded by the per-channel
+ * decoder and the two results are compared, as a self-test.
+ */
+class QwMollerADC_BankDecoder {
+ public:
+  static const Int_t kBlocks = 4;  ///< Blocks per record
+
+  QwMollerADC_BankDecoder()
+  : fBank(0), fNumWords(0), fFirstWord(0), fNumRecords(0), fVerify(kFALSE),
+    fNumberOfBanks(0), fNumberOfComparisons(0), fNumberOfMismatches(0) { };
+  ~QwMollerADC_BankDecoder();
+
+  /// Decode the records starting at a word offset and make this the active bank for this thread
+  void Decode(const UInt_t* buffer, UInt_t num_words, UInt_t first_word);
+  /// Stop serving channels from this bank
+  void Release();
+
+  /// Active bank decoder for this thread, or NULL
+  static QwMollerADC_BankDecoder* GetActive() { return fActive; };
+
+  /// Record starting at this buffer position, or -1 if none
+  Int_t Find(const UInt_t* word) const;
+
+  void   SetVerify(Bool_t verify) { fVerify = verify; };
+  Bool_t IsVerifying() const { return fVerify; };
+  void   RecordComparison(const QwMollerADC_Channel& channel, Bool_t match);
+  UInt_t GetNumberOfMismatches() const { return fNumberOfMismatches; };
+
+ private:
+  friend class QwMollerADC_Channel;
+
+  const UInt_t* fBank;   ///< Start of the active bank
+  UInt_t fNumWords;      ///< Number of words in the active bank
+  UInt_t fFirstWord;     ///< Offset of the first record in the bank
+  UInt_t fNumRecords;    ///< Number of complete records in the bank
+
+  /// Decoded fields, by record (and block)
+  std::vector<Int_t>    fBlock_raw;       // [record*kBlocks+block]
+  std::vector<Long64_t> fBlockSumSq_raw;  // [record*kBlocks+block]
+  std::vector<Int_t>    fBlock_min;       // [record*kBlocks+block]
+  std::vector<Int_t>    fBlock_max;       // [record*kBlocks+block]
+  std::vector<Int_t>    fHardwareBlockSum_raw;
+  std::vector<Int_t>    fSoftwareBlockSum_raw;
+  std::vector<UInt_t>   fSequenceNumber;
+  std::vector<UInt_t>   fNumberOfSamples;
+  std::vector<UInt_t>   fRawHWChecks;
+
+  Bool_t fVerify;        ///< Compare against the per-channel decoder
+  UInt_t fNumberOfBanks;
+  UInt_t fNumberOfComparisons;
+  UInt_t fNumberOfMismatches;
+
+  static thread_local QwMollerADC_BankDecoder* fActive;
 };
@@ -69,6 +69,23 @@ class QwParameterFile {
     /// Set the current run number for looking up the appropriate parameter file
     static void SetCurrentRunNumber(const UInt_t runnumber) { fCurrentRunNumber = runnumber; };
 
+    /// \brief Use the parameter files in a configuration snapshot, when it is valid for this run
+    static Bool_t LoadSnapshot(const std::string& filename);
+    /// \brief Write the parameter files used for this run to a configuration snapshot
+    static Bool_t SaveSnapshot(const std::string& filename);
+
+    /// Start the record of the parameter files read for a new run, keeping the previous one
+    static void StartConfigurationRecord() { fPreviousConfiguration.swap(fConfiguration); fConfiguration.clear(); };
+    /// Add the parameter files of the previous run, whose objects are used again, to the record
+    static void KeepPreviousConfiguration() { fConfiguration.insert(fPreviousConfiguration.begin(), fPreviousConfiguration.end()); };
+    /// \brief Check that the parameter files of the previous run would be read unchanged for the current run
+    static Bool_t IsConfigurationUnchanged();
+
+    /// Number of parameter files looked up in the search paths so far
+    static UInt_t GetNumberOfResolutions() { return fNumberOfResolutions; };
+    /// Time spent looking up parameter files in the search paths so far (in seconds)
+    static Double_t GetResolutionTime() { return fResolutionTime; };
+
     /// Set various sets of special characters
     void SetCommentChars(const std::string value)    { fCommentChars = value; };
     void SetWhitespaceChars(const std::string value) { fWhitespaceChars = value; };
@@ -270,13 +287,53 @@ class QwParameterFile {
   private:
 
     /// Find the first file in a directory that conforms to the run label
-    int FindFile(const fs::path& dir_path,    // in this directory,
-                 const std::string& file_stem, // search for this stem,
-                 const std::string& file_ext,  // search for this extension,
-                 fs::path& path_found);       // placing path here if found
+    static int FindFile(const fs::path& dir_path,    // in this directory,
+                        const std::string& file_stem, // search for this stem,
+                        const std::string& file_ext,  // search for this extension,
+                        fs::path& path_found);       // placing path here if found
 
     /// Open a file
     bool OpenFile(const fs::path& path_found);
+
+    /// File in a search path that matches a stem and extension
+    struct Candidate {
+      std::string fFileName;       ///< File name in the search path
+      Bool_t fHasRunLabel;         ///< File name has a run label after the stem
+      std::pair<int,int> fRunRange; ///< Run range of the run label
+    };
+    /// Index of a search path: the sorted file names, and the candidates for
+    /// each (stem, extension) that was looked up so far
+    struct SearchPathIndex {
+      Bool_t fListed{kFALSE};      ///< Directory was listed
+      Bool_t fExists{kFALSE};      ///< Directory existed when it was listed
+      fs::file_time_type fTime;    ///< Modification time of the directory
+      std::vector<std::string> fFileNames;
+      std::map<std::pair<std::string,std::string>, std::vector<Candidate> > fCandidates;
+    };
+    /// Candidates for a stem and extension in a search path, or null when
+    /// the search path does not exist
+    static const std::vector<Candidate>* GetCandidates(const fs::path& directory,
+                                                       const std::string& file_stem,
+                                                       const std::string& file_ext);
+
+    /// Parameter file in a configuration snapshot
+    struct SnapshotEntry {
+      std::string fPath;      ///< Resolved path of the file
+      std::string fContents;  ///< Contents of the file
+      Long64_t    fSize;      ///< Size of the file
+      Long64_t    fTime;      ///< Modification time of the file
+      ULong64_t   fHash;      ///< Hash of the contents
+    };
+    /// Add this file to the configuration snapshot and record
+    void AddToSnapshot(const std::string& name);
+    /// Best match for a file name in the search paths, with its score
+    static Int_t FindBestFile(const fs::path& file, fs::path& best_path, Bool_t warn = kTRUE);
+    /// Check that a snapshot entry still matches its file
+    static Bool_t IsCurrent(const SnapshotEntry& entry);
+    /// Modification times of the search paths
+    static std::vector<Long64_t> GetSearchPathTimes();
+    /// Hash of the contents of a file
+    static ULong64_t Hash(const std::string& contents);
   //  TString fCurrentSecName;     // Stores the name of the current section  read
   //  TString fCurrentModuleName;  // Stores the name of the current module  read
     TString fBestParamFileName;
@@ -298,6 +355,31 @@ class QwParameterFile {
     // Current run number
     static UInt_t fCurrentRunNumber;
 
+    // Index of the search paths, rebuilt when a directory changes
+    static std::map<std::string, SearchPathIndex> fSearchPathIndex;
+
+    // Statistics of the parameter file lookups
+    static UInt_t fNumberOfResolutions;
+    static Double_t fResolutionTime;
+
+    // Configuration snapshot: the files loaded from it, the files used for
+    // this run, and the runs for which the same files would be found
+    static Bool_t fSnapshotEnabled;
+    static Bool_t fSnapshotChanged;
+    static std::map<std::string, SnapshotEntry> fSnapshotLoaded;
+    static std::map<std::string, SnapshotEntry> fSnapshotUsed;
+    static std::pair<int,int> fSnapshotRunRange;
+    // Snapshot file in fSnapshotLoaded, its run range, and the modification
+    // times of the search paths for which it was checked
+    static std::string fSnapshotLoadedFile;
+    static std::pair<int,int> fSnapshotLoadedRange;
+    static std::vector<Long64_t> fSnapshotSearchPathTimes;
+
+    // Parameter files read since the configuration record was started,
+    // and those of the previous record
+    static std::map<std::string, SnapshotEntry> fConfiguration;
+    static std::map<std::string, SnapshotEntry> fPreviousConfiguration;
+
     // Default comment, whitespace, section, module characters
     static const std::string kDefaultCommentChars;
     static const std::string kDefaultWhitespaceChars;
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <sstream>
 #include <stdexcept>
+#include <deque>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
@@ -38,6 +39,7 @@ using std::type_info;
 // Qweak headers
 #include "QwOptions.h"
 #include "TMapFile.h"
+class QwSharedMemoryWriter;
 
 // If one defines more than this number of words in the full ntuple,
 // the results are going to get very very crazy.
@@ -365,14 +367,27 @@ private:
  * with support for branch construction, event filtering, and tree sharing.
  * Handles both new tree creation and attachment to existing trees, enabling
  * multiple subsystems to contribute data to a single ROOT tree.
+ *
+ * By default every object writes one leaflist branch, so that readers
+ * have to read all leaves of a device to get one of them.  In the split
+ * column modes every leaf is written as a separate branch named
+ * "branch.leaf" instead, and in kSplitFloatColumns the double leaves of
+ * asym_ and diff_ branches are stored as floats.
  */
 class QwRootTree {
 
   public:
 
+    /// Layout of the branches constructed for an object
+    enum EQwColumnMode {
+      kLeafListColumns,   ///< One leaflist branch per device
+      kSplitColumns,      ///< One branch per leaf
+      kSplitFloatColumns  ///< One branch per leaf, asym_ and diff_ leaves as floats
+    };
+
     /// Constructor with name, and description
     QwRootTree(const std::string& name, const std::string& desc, const std::string& prefix = "")
-    : fName(name),fDesc(desc),fPrefix(prefix),fType("type undefined"),
+    : fName(name),fDesc(desc),fPrefix(prefix),fType("type undefined"),fColumnMode(kLeafListColumns),
       fCurrentEvent(0),fNumEventsCycle(0),fNumEventsToSave(0),fNumEventsToSkip(0) {
       // Construct tree
       ConstructNewTree();
@@ -381,15 +396,16 @@ class QwRootTree {
     /// Constructor with existing tree
     QwRootTree(const QwRootTree* tree, const std::string& prefix = "")
     : fName(tree->GetName()),fDesc(tree->GetDesc()),fPrefix(prefix),fType("type undefined"),
-      fCurrentEvent(0),fNumEventsCycle(0),fNumEventsToSave(0),fNumEventsToSkip(0) {
+      fColumnMode(tree->fColumnMode),fCurrentEvent(0),fNumEventsCycle(0),fNumEventsToSave(0),fNumEventsToSkip(0) {
       QwMessage << "Existing tree: " << tree->GetName() << ", " << tree->GetDesc() << QwLog::endl;
       fTree = tree->fTree;
     }
 
     /// Constructor with name, description, and object
     template < class T >
-    QwRootTree(const std::string& name, const std::string& desc, T& object, const std::string& prefix = "")
-    : fName(name),fDesc(desc),fPrefix(prefix),fType("type undefined"),
+    QwRootTree(const std::string& name, const std::string& desc, T& object, const std::string& prefix = "",
+               EQwColumnMode columns = kLeafListColumns)
+    : fName(name),fDesc(desc),fPrefix(prefix),fType("type undefined"),fColumnMode(columns),
       fCurrentEvent(0),fNumEventsCycle(0),fNumEventsToSave(0),fNumEventsToSkip(0) {
       // Construct tree
       ConstructNewTree();
@@ -405,7 +421,7 @@ class QwRootTree {
     template < class T >
     QwRootTree(const QwRootTree* tree, T& object, const std::string& prefix = "")
     : fName(tree->GetName()),fDesc(tree->GetDesc()),fPrefix(prefix),fType("type undefined"),
-      fCurrentEvent(0),fNumEventsCycle(0),fNumEventsToSave(0),fNumEventsToSkip(0) {
+      fColumnMode(tree->fColumnMode),fCurrentEvent(0),fNumEventsCycle(0),fNumEventsToSave(0),fNumEventsToSkip(0) {
       QwMessage << "Existing tree: " << tree->GetName() << ", " << tree->GetDesc() << QwLog::endl;
       fTree = tree->fTree;
 
@@ -455,7 +471,16 @@ class QwRootTree {
       fVector.reserve(BRANCH_VECTOR_MAX_SIZE);
       // Associate branches with vector
       TString prefix = Form("%s",fPrefix.c_str());
-      object.ConstructBranchAndVector(fTree, prefix, fVector);
+      if (fColumnMode == kLeafListColumns) {
+        object.ConstructBranchAndVector(fTree, prefix, fVector);
+      } else {
+        // Let the object construct its leaflist branches on a scratch tree,
+        // and split them into columns on this tree
+        TTree scratch(fName.c_str(), fDesc.c_str());
+        scratch.SetDirectory(0);
+        object.ConstructBranchAndVector(&scratch, prefix, fVector);
+        ConstructColumnBranches(&scratch);
+      }
 
       // Store the type of object
       fType = typeid(object).name();
@@ -469,6 +494,14 @@ class QwRootTree {
       }
     }
 
+    /// \brief Construct one branch per leaf of the branches on a scratch tree
+    void ConstructColumnBranches(TTree* scratch);
+
+    /// \brief Leaves of this object with their offsets in the branch vector
+    void GetColumns(std::vector<std::string>& names,
+                    std::vector<size_t>& offsets,
+                    std::vector<char>& types) const;
+
 
   public:
 
@@ -478,6 +511,9 @@ class QwRootTree {
       if (typeid(object).name() == fType) {
         // Fill the branch vector
         object.FillTreeVector(fVector);
+        // Convert the columns stored as floats
+        for (size_t i = 0; i < fFloatColumns.size(); i++)
+          *fFloatColumns[i].second = *fFloatColumns[i].first;
       } else {
         QwError << "Attempting to fill tree vector for type " << fType << " with "
                 << "object of type " << typeid(object).name() << QwLog::endl;
@@ -531,6 +567,10 @@ class QwRootTree {
     TTree* fTree;
     /// Vector of leaves
     QwRootTreeBranchVector fVector;
+    /// Float storage of double leaves, with stable addresses for the branches
+    std::deque<Float_t> fFloatStorage;
+    /// Source leaves and float storage of the columns stored as floats
+    std::vector< std::pair<const Double_t*, Float_t*> > fFloatColumns;
 
 
     /// Name, description
@@ -548,6 +588,8 @@ class QwRootTree {
 
     /// Object type
     std::string fType;
+    /// Layout of the branches
+    EQwColumnMode fColumnMode;
 
     /// Get the object type
     std::string GetType() const { return fType; };
@@ -875,6 +917,11 @@ class QwRootFile {
     /// Is the map file active?
     Bool_t IsMapFile()  const { return (fMapFile); };
 
+    /// \brief Create the shared-memory writer requested by the options, or none
+    static QwSharedMemoryWriter* CreateSharedMemoryWriter(const TString& run_label);
+    /// \brief Publish the histograms and trees constructed from now on
+    void SetSharedMemoryWriter(QwSharedMemoryWriter* writer);
+
     /// \brief Construct indices from one tree to another tree
     void ConstructIndices(const std::string& from, const std::string& to, bool reverse = true);
 
@@ -919,6 +966,7 @@ class QwRootFile {
       static Int_t update_count = 0;
       update_count++;
       if ((fUpdateInterval > 0) && ( update_count % fUpdateInterval == 0)) Update();
+      if (fSharedMemory) SharedMemoryHistogramsFilled();
 
       // Debug directory registration
       std::string type = typeid(object).name();
@@ -973,7 +1021,9 @@ class QwRootFile {
     /// Fill the tree with name
     Int_t FillTree(const std::string& name) {
       if (! HasTreeByName(name)) return 0;
-      else return fTreeByName[name].front()->Fill();
+      Int_t retval = fTreeByName[name].front()->Fill();
+      if (fSharedMemory && retval > 0) PublishTreeEntries(name);
+      return retval;
     }
 
     /// Fill all registered trees
@@ -982,7 +1032,9 @@ class QwRootFile {
       Int_t retval = 0;
       std::map< const std::string, std::vector<QwRootTree*> >::iterator iter;
       for (iter = fTreeByName.begin(); iter != fTreeByName.end(); iter++) {
-        retval += iter->second.front()->Fill();
+        Int_t nbytes = iter->second.front()->Fill();
+        if (fSharedMemory && nbytes > 0) PublishTreeEntries(iter->first);
+        retval += nbytes;
       }
       return retval;
     }
@@ -1236,6 +1288,37 @@ class QwRootFile {
         if (fDisabledTrees.at(i).Match(name)) return true;
       return false;
     }
+
+    /// Shared-memory live histogram region, shared by all files of the
+    /// process and owned by the caller of SetSharedMemoryWriter
+    QwSharedMemoryWriter* fSharedMemory;
+    /// Ring in shared memory of each tree object
+    std::map<const QwRootTree*, Int_t> fRingByTree;
+    /// \brief Register the histograms in a directory with the shared-memory writer
+    void AddSharedMemoryHistograms(TDirectory* dir, const std::string& name);
+    /// \brief Register a tree object with the shared-memory writer
+    void AddSharedMemoryRing(const QwRootTree* tree, const std::string& name);
+    /// \brief Count a histogram fill for the shared-memory writer
+    void SharedMemoryHistogramsFilled();
+    /// \brief Append the current entries of the tree objects with name to their rings
+    void PublishTreeEntries(const std::string& name);
+
+    /// List of trees written with one branch per leaf
+    std::vector< TPRegexp > fSplitTrees;
+    /// Store asym_ and diff_ leaves of split trees as floats
+    Bool_t fSplitTreeFloats;
+
+    /// Add regexp to list of split tree names
+    void SplitTree(const TString& regexp) {
+      fSplitTrees.push_back(regexp);
+    }
+    /// Branch layout for a tree name
+    QwRootTree::EQwColumnMode GetColumnMode(const std::string& name) {
+      for (size_t i = 0; i < fSplitTrees.size(); i++)
+        if (fSplitTrees.at(i).Match(name))
+          return fSplitTreeFloats? QwRootTree::kSplitFloatColumns: QwRootTree::kSplitColumns;
+      return QwRootTree::kLeafListColumns;
+    }
     /// Add regexp to list of disabled histogram directories
     void DisableHisto(const TString& regexp) {
       fDisabledHistos.push_back(regexp);
@@ -1393,7 +1476,7 @@ void QwRootFile::ConstructTreeBranches(
     this->cd();
 
     // New tree with name, description, object, prefix
-    tree = new QwRootTree(name, desc, object, prefix);
+    tree = new QwRootTree(name, desc, object, prefix, GetColumnMode(name));
 
     // Settings only relevant for new trees
     if (name == "evt")
@@ -1417,6 +1500,10 @@ void QwRootFile::ConstructTreeBranches(
     tree = new QwRootTree(fTreeByName[name].front(), object, prefix);
   }
 
+  // Publish the entries of this object in shared memory
+  if (fSharedMemory)
+    AddSharedMemoryRing(tree, prefix.empty()? name: name + "/" + prefix);
+
    // Add the branches to the list of trees by name, object, type
   const void* addr = static_cast<const void*>(&object);
   const std::type_index type = typeid(object);
@@ -1634,6 +1721,9 @@ void QwRootFile::ConstructHistograms(const std::string& name, T& object)
     fDirsByType[type].push_back(name);
 
     object.ConstructHistograms(fDirsByName[name]);
+
+    // Publish the histograms in shared memory
+    if (fSharedMemory) AddSharedMemoryHistograms(fDirsByName[name], name);
   }
 
   // No support for directories in a map file
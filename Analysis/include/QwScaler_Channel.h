@@ -115,6 +115,7 @@ public:
   void LoadChannelParameters(QwParameterFile &paramfile) override;
 
   void  ClearEventData() override;
+  void  ClearRunState() override;
 
   void  RandomizeEventData(int helicity = 0, double time = 0.0) override;
   void  SetEventData(Double_t value);
@@ -133,6 +134,12 @@ public:
   void  EncodeEventData(std::vector<UInt_t> &buffer) override = 0;
   Int_t ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left, UInt_t index = 0) override = 0;
 
+  /// Bits of the scaler word that hold the count, and their shift
+  virtual UInt_t GetDataMask() const = 0;
+  virtual UInt_t GetDataShift() const = 0;
+  /// \brief Set the header and raw count of a scaler word decoded by the caller
+  void  SetRawWord(UInt_t header, UInt_t value_raw);
+
 //-----------------------------------------------------------------------------------------------
   void SmearByResolution(double resolution) override;
 //-----------------------------------------------------------------------------------------------
@@ -147,6 +154,8 @@ public:
   VQwScaler_Channel& operator=  (const VQwScaler_Channel &value);
   void AssignScaledValue(const VQwScaler_Channel &value, Double_t scale);
   void AssignValueFrom(const VQwDataElement* valueptr) override;
+  void PackEventData(std::vector<char>& record) const override;
+  void UnpackEventData(const char*& record) override;
   void AddValueFrom(const VQwHardwareChannel* valueptr) override;
   void SubtractValueFrom(const VQwHardwareChannel* valueptr) override;
   void MultiplyBy(const VQwHardwareChannel* valueptr) override;
@@ -287,6 +296,9 @@ class QwScaler_Channel: public VQwScaler_Channel
   void  EncodeEventData(std::vector<UInt_t> &buffer) override;
   Int_t ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left, UInt_t index = 0) override;
 
+  UInt_t GetDataMask() const override { return data_mask; };
+  UInt_t GetDataShift() const override { return data_shift; };
+
   void  ConstructBranchAndVector(TTree *tree, TString &prefix, QwRootTreeBranchVector &values) override;
   void  FillTreeVector(QwRootTreeBranchVector &values) const override;
 #ifdef HAS_RNTUPLE_SUPPORT
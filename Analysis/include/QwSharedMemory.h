@@ -0,0 +1,251 @@
+/*!
+ * \file   QwSharedMemory.h
+ * \brief  Layout of, and reader for, the shared-memory live histogram region
+ *
+ * This header is shared by the analyzer, which publishes the region with
+ * QwSharedMemoryWriter, and by online consumers such as panguin.  It only
+ * depends on the standard library and POSIX, so that consumers do not need
+ * to link against the analyzer.
+ */
+
+#pragma once
+
+// System headers
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * \namespace QwSharedMemory
+ * \ingroup QwAnalysis
+ * \brief Fixed layout of the shared-memory live histogram region
+ *
+ * The region starts with a Header, followed by the histogram and ring
+ * records, the column records of all rings, the histogram bin arrays, the
+ * histogram bin edges and the ring slots.  All offsets are in bytes from
+ * the start of the region.
+ *
+ * Histogram bins (including under- and overflow) are stored as doubles and
+ * updated in place by the producer.  Every histogram has a sequence counter
+ * that is odd while the producer writes its bins (a seqlock): a consumer
+ * copies the bins and retries when the counter changed or was odd, and
+ * gives up after a timeout in case the producer died while writing.  The
+ * bin edges are written once, when the region is created, so that
+ * histograms with variable bins are rebuilt with their own binning.
+ *
+ * Every ring keeps the most recent entries of one tree object as raw copies
+ * of its branch vector.  Each slot has its own sequence counter, 2n+1 while
+ * entry n is written and 2n+2 once it is complete, and the ring head counts
+ * the entries written so far, so that consumers never wait for the producer.
+ */
+namespace QwSharedMemory {
+
+  const uint32_t kMagic = 0x48535751;   ///< "QWSH"
+  const uint32_t kVersion = 2;
+  const size_t   kNameLength = 128;
+
+  /// Region header
+  struct Header {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint64_t fSize;                     ///< Size of the region
+    uint32_t fNumberOfHistograms;
+    uint32_t fNumberOfRings;
+    uint64_t fHistogramOffset;          ///< Offset of the histogram records
+    uint64_t fRingOffset;               ///< Offset of the ring records
+    uint32_t fRunNumber;
+    uint32_t fReserved;
+    std::atomic<uint64_t> fUpdates;     ///< Number of histogram publications
+  };
+
+  /// Histogram record
+  struct Histogram {
+    char     fName[kNameLength];        ///< Directory path and name
+    char     fTitle[kNameLength];
+    uint32_t fDimension;
+    int32_t  fNbinsX, fNbinsY;
+    double   fXmin, fXmax, fYmin, fYmax;
+    uint64_t fCellOffset;               ///< Offset of the bin array
+    uint64_t fNumberOfCells;            ///< Bins including under- and overflow
+    uint64_t fEdgeOffset;               ///< Offset of the fNbinsX+1 low edges along x,
+                                        ///< followed by fNbinsY+1 along y in two dimensions
+    double   fEntries;
+    std::atomic<uint64_t> fSequence;    ///< Seqlock counter, odd while writing
+  };
+
+  /// Column of a ring
+  struct Column {
+    char     fName[kNameLength];
+    uint64_t fOffset;                   ///< Offset of the value in an entry
+    char     fType;                     ///< Leaf type code (D, F, I, i, L, l, S, s)
+    char     fReserved[7];
+  };
+
+  /// Ring of recent tree entries
+  struct Ring {
+    char     fName[kNameLength];        ///< Tree name and object prefix
+    uint32_t fNumberOfColumns;
+    uint32_t fCapacity;                 ///< Number of slots
+    uint64_t fEntrySize;                ///< Size of an entry, multiple of 8
+    uint64_t fColumnOffset;             ///< Offset of the column records
+    uint64_t fSlotOffset;               ///< Offset of the first slot
+    std::atomic<uint64_t> fHead;        ///< Number of entries written
+  };
+
+  /// Slot of a ring, followed by fEntrySize bytes of entry data
+  struct Slot {
+    std::atomic<uint64_t> fSequence;    ///< 2n+1 while writing entry n, 2n+2 when done
+  };
+
+  /// Size of a slot of a ring
+  inline uint64_t SlotSize(uint64_t entrysize) { return sizeof(Slot) + entrysize; }
+
+  /// Copy a name into a fixed-size record field
+  inline void SetName(char* field, const std::string& name) {
+    std::strncpy(field, name.c_str(), kNameLength - 1);
+    field[kNameLength - 1] = '\0';
+  }
+
+  /// Value of a column in an entry, converted to double
+  inline double GetValue(const char* entry, const Column& column) {
+    const char* p = entry + column.fOffset;
+    switch (column.fType) {
+      case 'D': { double v;   std::memcpy(&v, p, sizeof(v)); return v; }
+      case 'F': { float v;    std::memcpy(&v, p, sizeof(v)); return v; }
+      case 'I': { int32_t v;  std::memcpy(&v, p, sizeof(v)); return v; }
+      case 'i': { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+      case 'L': { int64_t v;  std::memcpy(&v, p, sizeof(v)); return v; }
+      case 'l': { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+      case 'S': { int16_t v;  std::memcpy(&v, p, sizeof(v)); return v; }
+      case 's': { uint16_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+      default:  return 0.0;
+    }
+  }
+
+  /**
+   * \class Reader
+   * \brief Read-only view of a region published by the analyzer
+   */
+  class Reader {
+    public:
+      Reader(): fBase(0), fSize(0) { };
+      ~Reader() { Detach(); };
+
+      Reader(const Reader&) = delete;
+      Reader& operator=(const Reader&) = delete;
+
+      /// Attach to the region with the given name (as for shm_open)
+      bool Attach(const std::string& name) {
+        Detach();
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Header)) {
+          close(fd);
+          return false;
+        }
+        void* base = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) return false;
+        fBase = static_cast<char*>(base);
+        fSize = st.st_size;
+        const Header* header = GetHeader();
+        if (header->fMagic != kMagic || header->fVersion != kVersion || header->fSize != fSize) {
+          Detach();
+          return false;
+        }
+        return true;
+      }
+      /// Detach from the region
+      void Detach() {
+        if (fBase) munmap(fBase, fSize);
+        fBase = 0;
+        fSize = 0;
+      }
+      /// Whether a region is attached
+      bool IsAttached() const { return fBase != 0; };
+
+      const Header* GetHeader() const { return reinterpret_cast<const Header*>(fBase); };
+
+      /// Histogram records
+      size_t GetNumberOfHistograms() const { return fBase? GetHeader()->fNumberOfHistograms: 0; };
+      const Histogram& GetHistogram(size_t i) const {
+        return reinterpret_cast<const Histogram*>(fBase + GetHeader()->fHistogramOffset)[i];
+      };
+      /// Consistent copy of the bins and entries of a histogram; false when
+      /// none was obtained within the timeout (in seconds), as when the
+      /// producer died while writing the bins
+      bool ReadHistogram(size_t i, std::vector<double>& cells, double& entries,
+                         double timeout = 1.0) const {
+        const Histogram& histo = GetHistogram(i);
+        cells.resize(histo.fNumberOfCells);
+        const char* source = fBase + histo.fCellOffset;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        while (true) {
+          uint64_t before = histo.fSequence.load(std::memory_order_acquire);
+          if ((before & 1) == 0) {
+            std::memcpy(cells.data(), source, cells.size() * sizeof(double));
+            entries = histo.fEntries;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (histo.fSequence.load(std::memory_order_relaxed) == before) return true;
+          }
+          std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+          if (elapsed.count() > timeout) return false;
+          std::this_thread::yield();
+        }
+      }
+      /// Low edges of the bins of a histogram and the upper edge of the last
+      /// bin, along x and, in two dimensions, along y
+      void ReadEdges(size_t i, std::vector<double>& xedges, std::vector<double>& yedges) const {
+        const Histogram& histo = GetHistogram(i);
+        const double* edges = reinterpret_cast<const double*>(fBase + histo.fEdgeOffset);
+        xedges.assign(edges, edges + histo.fNbinsX + 1);
+        if (histo.fDimension == 2)
+          yedges.assign(edges + histo.fNbinsX + 1, edges + histo.fNbinsX + 1 + histo.fNbinsY + 1);
+        else
+          yedges.clear();
+      }
+
+      /// Ring records
+      size_t GetNumberOfRings() const { return fBase? GetHeader()->fNumberOfRings: 0; };
+      const Ring& GetRing(size_t i) const {
+        return reinterpret_cast<const Ring*>(fBase + GetHeader()->fRingOffset)[i];
+      };
+      const Column& GetColumn(const Ring& ring, size_t c) const {
+        return reinterpret_cast<const Column*>(fBase + ring.fColumnOffset)[c];
+      };
+      /// Copy the complete entries still in a ring, oldest first; returns the
+      /// number of entries the producer has written in total
+      uint64_t ReadRing(size_t i, std::vector< std::vector<char> >& entries) const {
+        const Ring& ring = GetRing(i);
+        uint64_t head = ring.fHead.load(std::memory_order_acquire);
+        uint64_t first = (head > ring.fCapacity)? head - ring.fCapacity: 0;
+        entries.clear();
+        std::vector<char> entry(ring.fEntrySize);
+        for (uint64_t n = first; n < head; n++) {
+          const char* slot = fBase + ring.fSlotOffset + (n % ring.fCapacity) * SlotSize(ring.fEntrySize);
+          const Slot* header = reinterpret_cast<const Slot*>(slot);
+          uint64_t before = header->fSequence.load(std::memory_order_acquire);
+          if (before != 2 * n + 2) continue;  // overwritten or still being written
+          std::memcpy(entry.data(), slot + sizeof(Slot), ring.fEntrySize);
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (header->fSequence.load(std::memory_order_relaxed) != before) continue;
+          entries.push_back(entry);
+        }
+        return head;
+      }
+
+    private:
+      char*  fBase;
+      size_t fSize;
+  };
+
+} // namespace QwSharedMemory
@@ -0,0 +1,100 @@
+/*!
+ * \file   QwSharedMemoryWriter.h
+ * \brief  Publication of live histograms and tree entries in shared memory
+ */
+
+#pragma once
+
+// System headers
+#include <set>
+#include <string>
+#include <vector>
+
+// ROOT headers
+#include "Rtypes.h"
+class TH1;
+class TDirectory;
+
+// Qweak headers
+#include "QwSharedMemory.h"
+
+/**
+ * \class QwSharedMemoryWriter
+ * \ingroup QwAnalysis
+ * \brief Producer side of the shared-memory live histogram region
+ *
+ * Histograms and tree objects are registered while the output is set up.
+ * The region is laid out and created at the first publication, after
+ * which the bins of the histograms are copied in place into the region
+ * at every PublishHistograms(), and every PublishEntry() appends the
+ * current branch vector of a tree object to its ring.  Nothing is
+ * streamed, so consumers read the region without decoding objects.
+ *
+ * A region is replaced when it is created, so there is one writer per
+ * region and process, shared by all output files of a run (see
+ * QwRootFile::SetSharedMemoryWriter).  The owner publishes the histograms
+ * a last time before the output files are closed.
+ *
+ * See QwSharedMemory.h for the layout of the region.
+ */
+class QwSharedMemoryWriter {
+  public:
+    /// \brief Create a writer for the region with the given name (as for shm_open)
+    QwSharedMemoryWriter(const std::string& name, UInt_t ringsize);
+    /// \brief Unmap the region
+    virtual ~QwSharedMemoryWriter();
+
+    QwSharedMemoryWriter(const QwSharedMemoryWriter&) = delete;
+    QwSharedMemoryWriter& operator=(const QwSharedMemoryWriter&) = delete;
+
+    /// \brief Register all histograms in a directory and its subdirectories
+    void AddHistograms(TDirectory* dir, const std::string& path);
+    /// \brief Register a tree object with its branch vector and columns
+    Int_t AddRing(const std::string& name, const void* data, size_t size,
+                  const std::vector<std::string>& names,
+                  const std::vector<size_t>& offsets,
+                  const std::vector<char>& types);
+
+    /// \brief Copy the bins of all histograms into the region
+    void PublishHistograms();
+    /// \brief Count a histogram fill, and publish every update interval
+    void HistogramsFilled() {
+      if (fUpdateInterval > 0 && ++fFills % fUpdateInterval == 0) PublishHistograms();
+    };
+    /// \brief Set the number of histogram fills between publications
+    void SetUpdateInterval(Int_t interval) { fUpdateInterval = interval; };
+    /// \brief Append the current branch vector of a tree object to its ring
+    void PublishEntry(Int_t ring);
+
+    /// \brief Set the run number in the region header
+    void SetRunNumber(UInt_t runnumber) { fRunNumber = runnumber; };
+
+  private:
+    /// \brief Lay out, create and map the region
+    Bool_t Create();
+
+    std::string fName;   ///< Name of the region
+    UInt_t fRingSize;    ///< Number of slots per ring
+    UInt_t fRunNumber;
+    Int_t fUpdateInterval; ///< Histogram fills between publications
+    Long64_t fFills;       ///< Histogram fills so far
+
+    /// Registered histograms with their names
+    std::vector< std::pair<std::string, TH1*> > fHistograms;
+    /// Registered histograms, since directories can be registered again
+    /// when more objects add histograms to them
+    std::set<const TH1*> fRegistered;
+
+    /// Registered tree object
+    struct Source {
+      std::string fName;
+      const char* fData;
+      size_t fSize;
+      std::vector<QwSharedMemory::Column> fColumns;
+    };
+    std::vector<Source> fSources;
+
+    char*  fBase;        ///< Mapped region, zero before creation
+    size_t fSize;        ///< Size of the mapped region
+    Bool_t fFailed;      ///< Creation failed, do not retry
+};
@@ -10,6 +10,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <string>
 
 #include "Rtypes.h"
 #include "TString.h"
@@ -28,6 +29,7 @@
 class VQwHardwareChannel;
 class QwParameterFile;
 class QwRootTreeBranchVector;
+class QwWorkerPool;
 
 /**
  * \class QwSubsystemArray
@@ -67,7 +69,7 @@ class QwSubsystemArray:
   /// \brief Copy constructor by reference
   QwSubsystemArray(const QwSubsystemArray& source);
   /// \brief Virtual destructor
-  ~QwSubsystemArray() override { };
+  ~QwSubsystemArray() override;
 
   /// \brief Assignment operator
   QwSubsystemArray& operator=(const QwSubsystemArray& value);
@@ -126,6 +128,12 @@ class QwSubsystemArray:
   void ProcessOptions(QwOptions &options) { ProcessOptionsSubsystems(options); };
   void LoadAllEventRanges(QwOptions &options);
 
+  /// \brief Print the heap footprint of the subsystem copies (option 'memory-report')
+  static void PrintMemoryReport();
+
+  /// \brief Release all subsystems of an array that is never used
+  void ReleaseSubsystems();
+
   /// \brief Add the subsystem to this array
   void push_back(VQwSubsystem* subsys);
 
@@ -157,6 +165,9 @@ class QwSubsystemArray:
   /// \brief Perform actions at the end of the event loop
   void  AtEndOfEventLoop();
 
+  /// \brief Clear the state kept from event to event for a new run
+  void  ClearRunState();
+
  public:
 
 
@@ -303,6 +314,36 @@ class QwSubsystemArray:
   std::vector<std::string> fSubsystemsDisabledByName; ///< List of disabled types
   std::vector<std::string> fSubsystemsDisabledByType; ///< List of disabled names
 
+  /// \brief Run one event processing stage on all subsystems
+  void ProcessEventStage(void (VQwSubsystem::*stage)());
+  /// Worker pool for parallel event processing (not shared with copies)
+  std::shared_ptr<QwWorkerPool> fWorkerPool;
+  /// Consecutive subsystems that are processed together in a stage
+  struct StageSegment {
+    size_t first;   ///< Index of the first subsystem in fStageSubsystems
+    size_t count;   ///< Number of subsystems
+    Bool_t parallel;  ///< Processed on the pool (thread-safe subsystems)
+  };
+  std::vector<VQwSubsystem*> fStageSubsystems; ///< Subsystems in array order
+  std::vector<StageSegment> fStageSegments;    ///< Segments in array order
+
+  /// Heap footprint of the copies of one subsystem
+  struct MemoryUsage {
+    size_t fCopies;      ///< Number of copies made
+    size_t fLive;        ///< Number of copies still alive
+    size_t fBytes;       ///< Bytes of the most recent copy
+    size_t fLiveBytes;   ///< Bytes held by the live copies
+    size_t fPeakBytes;   ///< Maximum of fLiveBytes
+  };
+  /// \brief Heap footprint of the copies, by subsystem name and class
+  static std::map<std::string, MemoryUsage>& GetMemoryUsage();
+  /// \brief Remove the copies in this array from the accounting
+  void ReleaseMemoryUsage();
+  /// Account for the heap footprint of copies
+  static Bool_t fMemoryReport;
+  /// Heap bytes of each subsystem copy in this array, when accounted
+  std::vector<size_t> fCopyBytes;
+
 public:
   // Mock Data Variables
     /// \brief Randomize the data in this event
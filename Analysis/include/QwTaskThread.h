@@ -0,0 +1,56 @@
+/*!
+ * \file   QwTaskThread.h
+ * \brief  Background thread running tasks in submission order
+ */
+
+#pragma once
+
+// System headers
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+/**
+ * \class QwTaskThread
+ * \ingroup QwAnalysis
+ * \brief Background thread running tasks in submission order
+ *
+ * Submit() queues a task and returns immediately; the tasks run one after
+ * the other on a single thread, so that a task may rely on all earlier
+ * tasks having finished.  Wait() returns when the queue is empty, which
+ * is where the caller picks up the results of the tasks.
+ */
+class QwTaskThread {
+ public:
+  /// \brief Start the background thread
+  QwTaskThread();
+  /// \brief Finish all queued tasks, then stop and join the thread
+  virtual ~QwTaskThread();
+
+  QwTaskThread(const QwTaskThread&) = delete;
+  QwTaskThread& operator=(const QwTaskThread&) = delete;
+
+  /// \brief Queue a task
+  void Submit(std::function<void()> task);
+  /// \brief Wait until all queued tasks are done
+  void Wait();
+  /// \brief Whether all queued tasks are done
+  bool IsIdle();
+
+ private:
+  /// Background thread: run tasks until stopped
+  void Work();
+
+  std::thread fThread;
+  std::mutex fMutex;
+  std::condition_variable fQueued;  ///< Signals a new task, or stop
+  std::condition_variable fIdle;    ///< Signals an empty queue
+
+  std::deque< std::function<void()> > fTasks; ///< Queued tasks
+  bool fBusy;                        ///< A task is running
+  bool fStop;                        ///< Thread should exit
+  std::exception_ptr fException;     ///< First exception thrown by a task
+};
@@ -25,6 +25,7 @@
 
 // Forward declarations
 class QwBlinder;
+class QwBlockChannelValues;
 class QwParameterFile;
 #ifdef __USE_DATABASE__
 class QwErrDBInterface;
@@ -128,6 +129,7 @@ class QwVQWK_Channel: public VQwHardwareChannel, public MQwMockable {
   };
 
   void  ClearEventData() override;
+  void  ClearRunState() override;
 
   /// Internally generate random event data
   void  RandomizeEventData(int helicity = 0.0, double time = 0.0) override;
@@ -157,6 +159,8 @@ class QwVQWK_Channel: public VQwHardwareChannel, public MQwMockable {
   QwVQWK_Channel& operator=(const QwVQWK_Channel &value);
   void AssignScaledValue(const QwVQWK_Channel &value, Double_t scale);
   void AssignValueFrom(const VQwDataElement* valueptr) override;
+  void PackEventData(std::vector<char>& record) const override;
+  void UnpackEventData(const char*& record) override;
   void AddValueFrom(const VQwHardwareChannel* valueptr) override;
   void SubtractValueFrom(const VQwHardwareChannel* valueptr) override;
   void MultiplyBy(const VQwHardwareChannel* valueptr) override;
@@ -183,6 +187,12 @@ class QwVQWK_Channel: public VQwHardwareChannel, public MQwMockable {
   void AddChannelOffset(Double_t Offset);
   void Scale(Double_t Offset) override;
 
+  /// \brief Copy the event values into a packed record
+  void GetBlockValues(QwBlockChannelValues& values) const;
+  /// \brief Set the event values from a packed record, as the arithmetic
+  ///        operations would (the raw values are not touched)
+  void SetBlockValues(const QwBlockChannelValues& values);
+
 
   /**
    * Accumulate event values into the running sum with optional scaling.
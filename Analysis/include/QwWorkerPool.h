@@ -0,0 +1,62 @@
+/*!
+ * \file   QwWorkerPool.h
+ * \brief  Fixed pool of worker threads for data-parallel loops
+ */
+
+#pragma once
+
+// System headers
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+
+/**
+ * \class QwWorkerPool
+ * \ingroup QwAnalysis
+ * \brief Fixed pool of worker threads for data-parallel loops
+ *
+ * Run() hands the indices 0..n-1 of a loop to the workers and to the
+ * calling thread, and returns when all of them have been processed, so
+ * that consecutive calls are separated by a barrier.  The threads are
+ * started once and wait between calls, which keeps the per-call overhead
+ * small enough to use the pool for every event.
+ */
+class QwWorkerPool {
+ public:
+  /// \brief Start a pool with the given number of threads, including the caller
+  explicit QwWorkerPool(unsigned int nthreads);
+  /// \brief Stop and join all workers
+  virtual ~QwWorkerPool();
+
+  QwWorkerPool(const QwWorkerPool&) = delete;
+  QwWorkerPool& operator=(const QwWorkerPool&) = delete;
+
+  /// \brief Number of threads working on a loop, including the caller
+  unsigned int GetNumberOfThreads() const { return fWorkers.size() + 1; };
+
+  /// \brief Call task(i) for i = 0..n-1 and wait until all calls are done
+  void Run(size_t n, const std::function<void(size_t)>& task);
+
+ private:
+  /// Worker thread: wait for a loop, then take indices until none are left
+  void Work();
+  /// Take indices of the current loop until none are left
+  void Drain();
+
+  std::vector<std::thread> fWorkers;
+  std::mutex fMutex;
+  std::condition_variable fStart;  ///< Signals a new loop, or stop
+  std::condition_variable fDone;   ///< Signals the end of the current loop
+
+  const std::function<void(size_t)>* fTask; ///< Task of the current loop
+  size_t fSize;                      ///< Number of indices in the current loop
+  std::atomic<size_t> fNext;         ///< Next index to hand out
+  unsigned int fBusy;                ///< Workers still in the current loop
+  unsigned long fGeneration;         ///< Number of loops started
+  bool fStop;                        ///< Workers should exit
+  std::exception_ptr fException;     ///< First exception thrown by a task
+};
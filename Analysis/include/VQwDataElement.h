@@ -203,6 +203,20 @@ class VQwDataElement: public MQwHistograms {
   ///        Return parameter is the "Eventcut Error Flag".
   virtual UInt_t UpdateErrorFlag() {return GetEventcutErrorFlag();};
 
+  /// \brief Append the addresses of the error flags of all channels in
+  ///        this element.  Elements that do not know their channels append
+  ///        a null pointer, which disables skipping them when clean.
+  virtual void CollectErrorFlags(std::vector<const UInt_t*>& flags) const {
+    flags.push_back(nullptr);
+  };
+
+  /// \brief Append the channels that hold all the event data of this
+  ///        element, in a fixed order.  Elements that do not know their
+  ///        channels append a null pointer, which disables packing them.
+  virtual void CollectChannels(std::vector<VQwHardwareChannel*>& channels) {
+    channels.push_back(nullptr);
+  };
+
   // These are related to those hardware channels that need to normalize
   // to an external clock
   virtual void SetNeedsExternalClock(Bool_t /*needed*/) {};   // Default is No!
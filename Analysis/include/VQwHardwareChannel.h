@@ -9,6 +9,7 @@
 
 // System headers
 #include <cmath>
+#include <cstring>
 #include <vector>
 #include <stdexcept>
 
@@ -145,6 +146,9 @@ public:
   void  ClearEventData() override{
     VQwDataElement::ClearEventData();
   };
+  /// \brief Clear the event data and the history kept from event to event,
+  /// for the start of a new run (see VQwSubsystem::ClearRunState)
+  virtual void  ClearRunState(){ ClearEventData(); };
 
   /*   virtual void AddChannelOffset(Double_t Offset) = 0; */
   virtual void Scale(Double_t Offset) = 0;
@@ -197,6 +201,23 @@ public:
   UInt_t UpdateErrorFlag() override {return GetEventcutErrorFlag();};
   void UpdateErrorFlag(const VQwHardwareChannel& elem){fErrorFlag |= elem.fErrorFlag;};
   virtual UInt_t GetErrorCode() const {return (fErrorFlag);};
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override {
+    flags.push_back(&fErrorFlag);
+  };
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override {
+    channels.push_back(this);
+  };
+
+  /// \brief Append the event data that operator= copies to a packed record
+  virtual void PackEventData(std::vector<char>& record) const {
+    PackValue(record, fGoodEventCount);
+    PackValue(record, fErrorFlag);
+  };
+  /// \brief Restore the event data from a packed record, and advance past it
+  virtual void UnpackEventData(const char*& record) {
+    UnpackValue(record, fGoodEventCount);
+    UnpackValue(record, fErrorFlag);
+  };
 
   virtual  void IncrementErrorCounters()=0;
   virtual  void  ProcessEvent()=0;
@@ -266,6 +287,28 @@ public:
   virtual void CopyParameters(const VQwHardwareChannel* /*valueptr*/){};
 
  protected:
+  /// \name Packed records of the event data, in the native byte layout
+  /// @{
+  template<typename T>
+  static void PackValue(std::vector<char>& record, const T& value) {
+    PackValues(record, &value, 1);
+  }
+  template<typename T>
+  static void PackValues(std::vector<char>& record, const T* values, size_t n) {
+    const char* bytes = reinterpret_cast<const char*>(values);
+    record.insert(record.end(), bytes, bytes + n * sizeof(T));
+  }
+  template<typename T>
+  static void UnpackValue(const char*& record, T& value) {
+    UnpackValues(record, &value, 1);
+  }
+  template<typename T>
+  static void UnpackValues(const char*& record, T* values, size_t n) {
+    std::memcpy(values, record, n * sizeof(T));
+    record += n * sizeof(T);
+  }
+  /// @}
+
   /*! \brief Set the number of data words in this data element */
   void SetNumberOfDataWords(const UInt_t &numwords) {fNumberOfDataWords = numwords;}
   /*! \brief Set the number of data words in this data element */
@@ -227,16 +227,36 @@ class VQwSubsystem: virtual public VQwSubsystemCloneable, public MQwHistograms,
    *         classes will require data from other subsystems.
    */
   virtual void  ExchangeProcessedData() { };
+  /*! \brief Bind the data of other subsystems that ExchangeProcessedData
+   *         reads, once all subsystems of the array have published their
+   *         values.  Not all derived classes will require this.
+   */
+  virtual void  BindExternalValues() { };
   /*! \brief Process the event data again, including data from other
    *         subsystems.  Not all derived classes will require
    *         a second stage of event data processing.
    */
   virtual void  ProcessEvent_2() { };
 
+  /*! \brief Whether the event processing stages of this subsystem may run
+   *         concurrently with those of other subsystems.  Subsystems that
+   *         share mutable state with other subsystems (e.g. static scratch
+   *         variables in device code) should return false; they are then
+   *         processed on the calling thread, in their place in the array.
+   */
+  virtual Bool_t IsThreadSafe() const { return kTRUE; };
+
 
   /// \brief Perform actions at the end of the event loop
   virtual void  AtEndOfEventLoop(){QwDebug << fSystemName << " at end of event loop" << QwLog::endl;};
 
+  /*! \brief Clear the state kept from event to event, for the start of a new
+   *         run with the same configuration (e.g. the helicity predictor or
+   *         the previous scaler readings).  The channel maps and parameters
+   *         are kept.  Subsystems with such state should override this.
+   */
+  virtual void  ClearRunState(){ ClearEventData(); };
+
 
   // Not all derived classes will have the following functions
   virtual void  RandomizeEventData(int /*helicity*/ = 0, double /*time*/ = 0.0) { };
@@ -0,0 +1,48 @@
+/*------------------------------------------------------------------------*//*!
+
+ \file QwEventIndexer.cc
+
+ \ingroup QwAnalysis
+
+ \brief main(...) function for the qweventindexer executable
+
+ Reads the requested runs from start to end and writes an event index file
+ for every data file (see QwEventIndex), so that later passes with the
+ --event-index option can seek directly to event ranges and EPICS events.
+
+*//*-------------------------------------------------------------------------*/
+
+// Qweak headers
+#include "QwLog.h"
+#include "QwOptions.h"
+#include "QwEventBuffer.h"
+
+Int_t main(Int_t argc, Char_t* argv[])
+{
+  ///  Without anything, print usage
+  if (argc == 1) {
+    gQwOptions.Usage();
+    exit(0);
+  }
+
+  ///  Search paths for the parameter files
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QW_PRMINPUT"));
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QWANALYSIS") + "/Analysis/prminput");
+
+  gQwOptions.SetCommandLine(argc, argv);
+  gQwLog.ProcessOptions(&gQwOptions);
+
+  ///  Create the event buffer, always with event indexing
+  QwEventBuffer eventbuffer;
+  eventbuffer.ProcessOptions(gQwOptions);
+  eventbuffer.SetUseEventIndex();
+
+  ///  Read every run to the end, which writes its index
+  while (eventbuffer.OpenNextStream() == CODA_OK) {
+    QwMessage << "Indexing run " << eventbuffer.GetRunLabel() << QwLog::endl;
+    while (eventbuffer.GetNextEvent() == CODA_OK) { }
+    eventbuffer.CloseStream();
+  }
+
+  return 0;
+}
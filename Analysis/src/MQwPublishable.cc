@@ -167,6 +167,18 @@ const VQwHardwareChannel* MQwPublishable_child<U,T>::RequestExternalPointer(cons
   return NULL;
 }
 
+/* Bind a pointer to a variable from a different data array. See header for docs. */
+template<class U, class T>
+Bool_t MQwPublishable_child<U,T>::BindExternalValue(const TString& name, const VQwHardwareChannel*& value) const  {
+  if (value == 0) {
+    value = RequestExternalPointer(name);
+    if (value == 0)
+      QwWarning << "MQwPublishable_child::BindExternalValue: name \""
+                << name << "\" not found in array." << QwLog::endl;
+  }
+  return (value != 0);
+}
+
 // Publish a variable name to the subsystem array. See header for parameters.
 template<class U, class T>
 Bool_t MQwPublishable_child<U,T>::PublishInternalValue(
@@ -245,6 +245,25 @@ void QwADC18_Channel::ClearEventData()
   fErrorFlag = 0;
 }
 
+/**
+ * Clear the event data, the history of the hardware checks (previous
+ * sequence number and block sum) and the error counters of the run.
+ */
+void QwADC18_Channel::ClearRunState()
+{
+  ClearEventData();
+  fNumEvtsWithEventCutsRejected = 0;
+  fErrorCount_sample     = 0;
+  fErrorCount_SW_HW      = 0;
+  fErrorCount_Sequence   = 0;
+  fErrorCount_SameHW     = 0;
+  fErrorCount_ZeroHW     = 0;
+  fErrorCount_HWSat      = 0;
+  fADC_Same_NumEvt       = 0;
+  fSequenceNo_Prev       = 0;
+  fSequenceNo_Counter    = 0;
+}
+
 void QwADC18_Channel::RandomizeEventData(int helicity, double time)
 {
   // Calculate drift (if time is not specified, it stays constant at zero)
@@ -330,58 +349,106 @@ Bool_t QwADC18_Channel::IsHeaderWord(UInt_t rawd) const
   return ((rawd & mask31x) != 0);
 }
 
+/*!  Static member function to extract the fields of an ADC18 data word.
+ *   This does not depend on the channel state, so the words of a whole
+ *   bank can be decoded at once (see QwADC18_BankDecoder).
+ */
+QwADC18_Channel::DataWord QwADC18_Channel::DecodeDataWord(UInt_t rawd)
+{
+  DataWord word;
+  word.rawd   = rawd;
+  word.dtype  = (rawd & mask2422x) >> 22;
+  word.dvalue = (rawd & mask2625x) >> 25;
+  word.snum   = (word.dtype == 1 || word.dtype == 2) ?
+                ((rawd & mask2118x) >> 18) : 0;
+  switch (word.dtype) {
+    case 0: // Diff word
+      word.value = rawd & mask200x;
+      if (rawd & mask21x) word.value = -((~word.value & 0x1fffffff) + 1);
+      break;
+    case 1: // Peak word
+    case 2: // Base word
+      word.value = rawd & mask170x;
+      break;
+    case 4: // DAC word
+      word.value = rawd & mask150x;
+      break;
+    default:
+      word.value = 0;
+  }
+  return word;
+}
+
 Int_t QwADC18_Channel::ProcessDataWord(UInt_t rawd)
 {
-  // "Actual" values from data word
-  UInt_t act_dtype  = (rawd & mask2422x) >> 22;
-  [[maybe_unused]]
-  UInt_t act_chan   = (act_dtype != 4) ?
-                      ((rawd & mask3029x) >> 29) : 0;
-  UInt_t act_dvalue = (rawd & mask2625x) >> 25;
-  UInt_t act_snum   = (act_dtype == 1 || act_dtype == 2) ?
-                      ((rawd & mask2118x) >> 18) : 0;
+  return ProcessDataWord(DecodeDataWord(rawd));
+}
 
+Int_t QwADC18_Channel::ProcessDataWord(const DataWord& word)
+{
   // Interpret by data type
-  UInt_t value_raw = 0;
-  switch (act_dtype) {
+  switch (word.dtype) {
     case 0: // Diff word
-      static UInt_t prev_dvalue = act_dvalue;
-      if (act_dvalue != prev_dvalue) {
-        QwError << "QwADC18_Channel::ProcessEvBuffer: Number of samples changed " << act_dvalue << " " << prev_dvalue << QwLog::endl;
+      static UInt_t prev_dvalue = word.dvalue;
+      if (word.dvalue != prev_dvalue) {
+        QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Number of samples changed " << word.dvalue << " " << prev_dvalue << QwLog::endl;
         return 0;
       }
-      value_raw = rawd & mask200x;
-      if (rawd & mask21x) value_raw = -((~value_raw & 0x1fffffff) + 1);
-      fNumberOfSamples = (1 << act_dvalue);
-      return value_raw;
+      fNumberOfSamples = (1 << word.dvalue);
+      return word.value;
       break;
     case 1: // Peak word
     case 2: // Base word
-      if (act_snum != fNumberOfSamples) {
-        QwError << "QwADC18_Channel::ProcessEvBuffer: Number of samples changed " << act_snum << " " << fNumberOfSamples << QwLog::endl;
+      if (word.snum != fNumberOfSamples) {
+        QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Number of samples changed " << word.snum << " " << fNumberOfSamples << QwLog::endl;
         return 0;
       }
-      if (act_dvalue != 0) {
-        QwError << "QwADC18_Channel::ProcessEvBuffer: Divider value non-zero 0x" << std::hex << rawd << std::dec << QwLog::endl;
+      if (word.dvalue != 0) {
+        QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Divider value non-zero 0x" << std::hex << word.rawd << std::dec << QwLog::endl;
         return 0;
       }
-      return rawd & mask170x;
+      return word.value;
       break;
     case 4: // DAC word
-      if (act_dvalue != 0) {
-        QwError << "QwADC18_Channel::ProcessEvBuffer: Divider value non-zero 0x" << std::hex << rawd << std::dec << QwLog::endl;
+      if (word.dvalue != 0) {
+        QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Divider value non-zero 0x" << std::hex << word.rawd << std::dec << QwLog::endl;
         return 0;
       }
-      return rawd & mask150x;
+      return word.value;
       break;
     default:
-      QwError << "QwADC18_Channel::ProcessEvBuffer: Unknown data type 0x" << std::hex << rawd << std::dec << QwLog::endl;
+      QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Unknown data type 0x" << std::hex << word.rawd << std::dec << QwLog::endl;
       return 0;
   }
 }
 
-// FIXME here goes the decoding of raw data from CODA blocks
 Int_t QwADC18_Channel::ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left, UInt_t index)
+{
+  // Use the pre-decoded words when this channel is in the active bank
+  QwADC18_BankDecoder* bank = QwADC18_BankDecoder::GetActive();
+  const DataWord* decoded = (bank != 0) ? bank->Find(buffer) : 0;
+  if (decoded == 0)
+    return DecodeEvBuffer(buffer, num_words_left, 0);
+  if (! bank->IsVerifying() || IsNameEmpty())
+    return DecodeEvBuffer(buffer, num_words_left, decoded);
+
+  // Self-test: decode a copy of this channel with the per-channel decoder
+  QwADC18_Channel reference(*this);
+  reference.fNumberOfSamples = fNumberOfSamples;
+  Int_t reference_words = reference.DecodeEvBuffer(buffer, num_words_left, 0);
+  Int_t words_read = DecodeEvBuffer(buffer, num_words_left, decoded);
+  bank->RecordComparison(*this,
+                         words_read == reference_words
+                      && fValue_Raw == reference.fValue_Raw
+                      && fDiff_Raw  == reference.fDiff_Raw
+                      && fPeak_Raw  == reference.fPeak_Raw
+                      && fBase_Raw  == reference.fBase_Raw
+                      && fNumberOfSamples == reference.fNumberOfSamples);
+  return words_read;
+}
+
+// FIXME here goes the decoding of raw data from CODA blocks
+Int_t QwADC18_Channel::DecodeEvBuffer(UInt_t* buffer, UInt_t num_words_left, const DataWord* decoded)
 {
   Bool_t debug = false;
 
@@ -418,14 +485,15 @@ Int_t QwADC18_Channel::ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left, UI
 
       // Check if enough words left
       if (num_words_left < kHeaderWordsPerModule) {
-        QwError << "QwADC18_Channel::ProcessEvBuffer: Not enough words left!" << QwLog::endl;
+        QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Not enough words left!" << QwLog::endl;
         return num_words_left;
       }
 
       // FIXME Catch 0xfa180bad
 
       // Header word: read DAC value
-      fValue_Raw = ProcessDataWord(buffer[kHeaderWordsPerModule-1]);
+      fValue_Raw = decoded ? ProcessDataWord(decoded[kHeaderWordsPerModule-1])
+                           : ProcessDataWord(buffer[kHeaderWordsPerModule-1]);
 
       words_read = kHeaderWordsPerModule;
 
@@ -443,20 +511,26 @@ Int_t QwADC18_Channel::ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left, UI
 
       // Check if enough words left
       if (num_words_left < kDataWordsPerChannel) {
-        QwError << "QwADC18_Channel::ProcessEvBuffer: Not enough words left!" << QwLog::endl;
+        QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Not enough words left!" << QwLog::endl;
         return num_words_left;
       }
 
       // Data channel words: read diff, peak, base
-      fDiff_Raw = ProcessDataWord(buffer[0]);
-      fPeak_Raw = ProcessDataWord(buffer[1]);
-      fBase_Raw = ProcessDataWord(buffer[2]);
+      if (decoded) {
+        fDiff_Raw = ProcessDataWord(decoded[0]);
+        fPeak_Raw = ProcessDataWord(decoded[1]);
+        fBase_Raw = ProcessDataWord(decoded[2]);
+      } else {
+        fDiff_Raw = ProcessDataWord(buffer[0]);
+        fPeak_Raw = ProcessDataWord(buffer[1]);
+        fBase_Raw = ProcessDataWord(buffer[2]);
+      }
 
       words_read = kDataWordsPerChannel;
     }
 
   } else {
-    QwError << "QwADC18_Channel::ProcessEvBuffer: Not enough words!" << QwLog::endl;
+    QwErrorLimited(this,10) << "QwADC18_Channel::ProcessEvBuffer: Not enough words!" << QwLog::endl;
   }
 
   return words_read;
@@ -748,6 +822,35 @@ QwADC18_Channel& QwADC18_Channel::operator= (const QwADC18_Channel &value)
   return *this;
 }
 
+/// Packs the same event data as operator= copies
+void QwADC18_Channel::PackEventData(std::vector<char>& record) const
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::PackEventData(record);
+    PackValue(record, fDiff_Raw);
+    PackValue(record, fPeak_Raw);
+    PackValue(record, fBase_Raw);
+    PackValue(record, fValue_Raw);
+    PackValue(record, fValue);
+    PackValue(record, fValueError);
+    PackValue(record, fValueM2);
+  }
+}
+
+void QwADC18_Channel::UnpackEventData(const char*& record)
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::UnpackEventData(record);
+    UnpackValue(record, fDiff_Raw);
+    UnpackValue(record, fPeak_Raw);
+    UnpackValue(record, fBase_Raw);
+    UnpackValue(record, fValue_Raw);
+    UnpackValue(record, fValue);
+    UnpackValue(record, fValueError);
+    UnpackValue(record, fValueM2);
+  }
+}
+
 void QwADC18_Channel::AssignScaledValue(const QwADC18_Channel &value,
 				 Double_t scale)
 {
@@ -1477,3 +1580,95 @@ void QwADC18_Channel::AddErrEntriesToList(std::vector<QwErrDBInterface> &row_lis
 
 }
 #endif
+
+
+thread_local QwADC18_BankDecoder* QwADC18_BankDecoder::fActive = 0;
+
+QwADC18_BankDecoder::~QwADC18_BankDecoder()
+{
+  if (fActive == this) fActive = 0;
+  if (fVerify && fNumberOfBanks > 0) {
+    QwMessage << "ADC18 bank decoder self-test: " << fNumberOfComparisons
+              << " channel reads in " << fNumberOfBanks << " banks, "
+              << fNumberOfMismatches << " mismatches" << QwLog::endl;
+  }
+}
+
+/*!  Decode all complete modules in an ADC18 bank.
+ *   A module is decoded when its first word has the header bit set and
+ *   none of its channel data words do; anything else is left for the
+ *   per-channel decoder, which reports the problem as before.
+ *   @param buffer    Start of the ADC18 bank (the bank header word)
+ *   @param num_words Number of words in the bank
+ *   @return   kTRUE when all modules in the bank were decoded
+ */
+Bool_t QwADC18_BankDecoder::Decode(const UInt_t* buffer, UInt_t num_words)
+{
+  const UInt_t words_per_module = QwADC18_Channel::kHeaderWordsPerModule
+    + QwADC18_Channel::kMaxChannels * QwADC18_Channel::kDataWordsPerChannel
+    + QwADC18_Channel::kFooterWordsPerModule;
+
+  fBank = buffer;
+  fNumWords = num_words;
+  fWords.resize(num_words);
+  fDecoded.assign(num_words, kFALSE);
+
+  Bool_t status = kTRUE;
+  UInt_t module = QwADC18_Channel::kHeaderWordsPerBank;
+  for ( ; module + words_per_module <= num_words; module += words_per_module) {
+    // Check the module header and the channel data words
+    Bool_t good = ((buffer[module] & QwADC18_Channel::mask31x) != 0);
+    UInt_t first = module + QwADC18_Channel::kHeaderWordsPerModule;
+    UInt_t last  = module + words_per_module - QwADC18_Channel::kFooterWordsPerModule;
+    for (UInt_t i = first; good && i < last; i++)
+      good = ((buffer[i] & QwADC18_Channel::mask31x) == 0);
+    if (! good) {
+      status = kFALSE;
+      continue;
+    }
+    for (UInt_t i = module; i < module + words_per_module; i++) {
+      fWords[i] = QwADC18_Channel::DecodeDataWord(buffer[i]);
+      fDecoded[i] = kTRUE;
+    }
+  }
+  // Check that only the bank footer is left
+  if (module + QwADC18_Channel::kFooterWordsPerBank != num_words) {
+    QwWarningLimited(this,10) << "QwADC18_BankDecoder::Decode: "
+                         << num_words << " words do not make complete modules"
+                         << QwLog::endl;
+    status = kFALSE;
+  }
+
+  fNumberOfBanks++;
+  fActive = this;
+  return status;
+}
+
+void QwADC18_BankDecoder::Release()
+{
+  if (fActive == this) fActive = 0;
+  fBank = 0;
+  fNumWords = 0;
+}
+
+const QwADC18_Channel::DataWord* QwADC18_BankDecoder::Find(const UInt_t* word) const
+{
+  if (fBank == 0 || word < fBank || word >= fBank + fNumWords) return 0;
+  UInt_t offset = word - fBank;
+  if (! fDecoded[offset]) return 0;
+  // Headers are followed by the module header words, channels by their data words
+  UInt_t n = ((fWords[offset].rawd & QwADC18_Channel::mask31x) != 0) ?
+    QwADC18_Channel::kHeaderWordsPerModule : QwADC18_Channel::kDataWordsPerChannel;
+  if (offset + n > fNumWords || ! fDecoded[offset + n - 1]) return 0;
+  return &fWords[offset];
+}
+
+void QwADC18_BankDecoder::RecordComparison(const QwADC18_Channel& channel, Bool_t match)
+{
+  fNumberOfComparisons++;
+  if (! match) {
+    fNumberOfMismatches++;
+    QwErrorLimited(&channel,10) << "QwADC18_BankDecoder: bank and per-channel decoders differ for "
+                       << channel.GetElementName() << QwLog::endl;
+  }
+}
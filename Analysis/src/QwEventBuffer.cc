@@ -59,6 +59,12 @@ const UInt_t QwEventBuffer::kNullDataWord = 0x4e554c4c;
 QwEventBuffer::QwEventBuffer()
   :    fRunListFile(nullptr),
        fEventListFile(nullptr),
+       fUseEventIndex(kFALSE),
+       fEventIndexLoaded(kFALSE),
+       fBuildingEventIndex(kFALSE),
+       fNextEventPosition(0),
+       fSeekTarget(0),
+       fSeekStep(0),
        fDataFileStem(fDefaultDataFileStem),
        fDataFileExtension(fDefaultDataFileExtension),
        fDataDirectory(fDefaultDataDirectory),
@@ -124,6 +130,12 @@ void QwEventBuffer::DefineOptions(QwOptions &options)
   options.AddOptions()
     ("directfile", po::value<string>(),
     "Run over single event file");
+  options.AddOptions()
+    ("event-index", po::value<bool>()->default_bool_value(false),
+     "use event index files (<datafile>.idx) to seek in data files, and write them after reading a whole file");
+  options.AddOptions()
+    ("event-index-dir", po::value<string>()->default_value(""),
+     "directory for event index files (default is next to the data files)");
   //  Special flag to allow sub-bank IDs less than 31
   options.AddDefaultOptions()
     ("allow-low-subbank-ids", po::value<bool>()->default_bool_value(false),
@@ -226,6 +238,8 @@ void QwEventBuffer::ProcessOptions(QwOptions &options)
   fChainDataFiles = options.GetValue<bool>("chainfiles");
   fDataFileStem = options.GetValue<string>("codafile-stem");
   fDataFileExtension = options.GetValue<string>("codafile-ext");
+  fUseEventIndex = options.GetValue<bool>("event-index");
+  fEventIndexDir = options.GetValue<string>("event-index-dir");
         fDataVersion = options.GetValue<int>("coda-version");
 
         if(fDataVersion == 2){
@@ -466,6 +480,14 @@ Int_t QwEventBuffer::GetNextEvent()
   //  events that are within the event range.
   Int_t status = CODA_OK;
   do {
+    //  Seek directly to the start of a distant event range
+    if (fEventIndexLoaded && fSeekStep >= fSeekPlan.size()
+        && fEventRange.first != fSeekTarget
+        && fEventRange.first >= decoder->GetEvtNumber() + QwEventIndex::kPhysicsStride) {
+      fSeekTarget = fEventRange.first;
+      fSeekStep = 0;
+      fEventIndex.GetSeekPlan(fSeekTarget, fNextEventPosition, fSeekPlan);
+    }
     status = GetEvent();
     if (globalEXIT == 1) {
       //  QUESTION:  Should we continue to loop once we've
@@ -546,10 +568,38 @@ Int_t QwEventBuffer::GetEvent()
                 VerifyCodaVersion(evBuffer);
         }
         decoder->DecodeEventIDBank(evBuffer);
+    if (fBuildingEventIndex) {
+      QwEventIndex::EQwIndexedEventType type = QwEventIndex::kOtherEvent;
+      if (IsPhysicsEvent()) type = QwEventIndex::kPhysicsEvent;
+      else if (IsEPICSEvent()) type = QwEventIndex::kEPICSEvent;
+      else if (IsROCConfigurationEvent()) type = QwEventIndex::kROCConfigurationEvent;
+      fEventIndex.AddEvent(fNextEventPosition - 1, decoder->GetEvtNumber(), type);
+    }
   }
   return status;
 }
 
+/**
+ * Read events up to the next EPICS event.  When the data file is indexed
+ * the events in between are skipped.
+ * @return CODA status of the last read
+ */
+Int_t QwEventBuffer::GetNextEPICSEvent()
+{
+  if (fEventIndexLoaded && fSeekStep >= fSeekPlan.size()) {
+    Int_t position = fEventIndex.FindNextEPICSEvent(fNextEventPosition);
+    if (position >= 0) {
+      fSeekPlan.assign(1, position);
+      fSeekStep = 0;
+    }
+  }
+  Int_t status = CODA_OK;
+  do {
+    status = GetNextEvent();
+  } while (status == CODA_OK && ! IsEPICSEvent());
+  return status;
+}
+
 // Tries to figure out what Coda Version the Data is
 // fDataVersionVerify =
 //            2 -- Coda Version 2
@@ -587,7 +637,13 @@ Int_t QwEventBuffer::GetFileEvent(){
   //  next segment and read a new event; repeat
   //  if needed.
   do {
+    if (fSeekStep < fSeekPlan.size()) {
+      fNextEventPosition = fSeekPlan[fSeekStep++];
+      static_cast<THaCodaFile*>(fEvStream)->codaSeek(fNextEventPosition);
+    }
     status = fEvStream->codaRead();
+    if (status == CODA_OK) fNextEventPosition++;
+    if (fBuildingEventIndex && status == EOF) FinishEventIndex();
     if (fChainDataFiles && status == EOF){
       CloseThisSegment();
       //  Crash out of the loop if we can't open the
@@ -808,7 +864,7 @@ Bool_t QwEventBuffer::FillSubsystemConfigurationData(QwSubsystemArray &subsystem
             << "Found configuration event for ROC"
             << rocnum
             << QwLog::endl;
-        decoder->PrintDecoderInfo(QwMessage);
+        decoder->PrintDecoderInfo(QwLogGuard()(QwLog::kMessage,__PRETTY_FUNCTION__));
   //  Loop through the data buffer in this event.
   UInt_t *localbuff = (UInt_t*)(fEvStream->getEvBuffer());
         decoder->DecodeEventIDBank(localbuff);
@@ -1277,9 +1333,40 @@ Int_t QwEventBuffer::OpenDataFile(const TString filename, const TString rw)
     }
     globfree(&globbuf);
   }
+
+  //  Use the event index of this file, or build it while reading
+  fEventIndexLoaded = kFALSE;
+  fBuildingEventIndex = kFALSE;
+  fNextEventPosition = 0;
+  fSeekTarget = 0;
+  fSeekPlan.clear();
+  fSeekStep = 0;
+  if (fUseEventIndex && ! rw.Contains("w",TString::kIgnoreCase)
+      && ! fDataFile.EndsWith(".gz")) {
+    TString indexfile = QwEventIndex::GetIndexFileName(fDataFile, fEventIndexDir);
+    if (! fEventIndex.Read(indexfile, fDataFile)) {
+      fEventIndex.Clear(fDataFile);
+      fBuildingEventIndex = kTRUE;
+    } else if (static_cast<THaCodaFile*>(fEvStream)->codaOpenRandomAccess(fDataFile) == CODA_OK) {
+      fEventIndexLoaded = kTRUE;
+      return CODA_OK;
+    } else {
+      QwWarning << "Unable to open " << fDataFile << " for random access; "
+                << "reading it sequentially" << QwLog::endl;
+    }
+  }
   return fEvStream->codaOpen(fDataFile, rw);
 }
 
+//------------------------------------------------------------
+void QwEventBuffer::FinishEventIndex()
+{
+  //  The whole file has been read, so the index is complete
+  fBuildingEventIndex = kFALSE;
+  fEventIndex.SetNumberOfEvents(fNextEventPosition);
+  fEventIndex.Write(QwEventIndex::GetIndexFileName(fDataFile, fEventIndexDir));
+}
+
 
 //------------------------------------------------------------
 Int_t QwEventBuffer::CloseDataFile()
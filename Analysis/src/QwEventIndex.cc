@@ -0,0 +1,186 @@
+/*!
+ * \file   QwEventIndex.cc
+ * \brief  Sidecar index of event positions in a CODA data file
+ */
+
+#include "QwEventIndex.h"
+
+// System headers
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+// Qweak headers
+#include "QwLog.h"
+
+const UInt_t QwEventIndex::kPhysicsStride = 1000;
+
+/**
+ * Index file name for a data file
+ * @param datafile Data file name
+ * @param indexdir Directory for index files (empty for the data file directory)
+ * @return Index file name
+ */
+TString QwEventIndex::GetIndexFileName(const TString& datafile, const TString& indexdir)
+{
+  if (indexdir.Length() == 0)
+    return datafile + ".idx";
+  fs::path path = fs::path(indexdir.Data()) / fs::path(datafile.Data()).filename();
+  return TString(path.string()) + ".idx";
+}
+
+Bool_t QwEventIndex::GetFileStamp(const TString& datafile, Long64_t& size, Long64_t& time)
+{
+  std::error_code ec;
+  size = fs::file_size(datafile.Data(), ec);
+  if (ec) return kFALSE;
+  time = fs::last_write_time(datafile.Data(), ec).time_since_epoch().count();
+  return ! ec;
+}
+
+/**
+ * Start a new, empty index for a data file
+ * @param datafile Data file name
+ */
+void QwEventIndex::Clear(const TString& datafile)
+{
+  if (! GetFileStamp(datafile, fDataFileSize, fDataFileTime)) {
+    fDataFileSize = 0;
+    fDataFileTime = 0;
+  }
+  fNumberOfEvents = 0;
+  fLastPhysicsEvent = 0;
+  fEntries.clear();
+}
+
+/**
+ * Add an event to the index; physics events are only kept once
+ * every kPhysicsStride event numbers.
+ * @param position Number of events before this one in the file
+ * @param evtnum   CODA event number
+ * @param type     Kind of event
+ */
+void QwEventIndex::AddEvent(UInt_t position, UInt_t evtnum, EQwIndexedEventType type)
+{
+  if (type == kPhysicsEvent) {
+    if (fLastPhysicsEvent != 0 && evtnum < fLastPhysicsEvent + kPhysicsStride)
+      return;
+    fLastPhysicsEvent = evtnum;
+  }
+  Entry entry;
+  entry.fPosition = position;
+  entry.fEventNumber = evtnum;
+  entry.fType = type;
+  fEntries.push_back(entry);
+}
+
+/**
+ * Read the index for a data file
+ * @param indexfile Index file name
+ * @param datafile  Data file the index should describe
+ * @return True when the index is complete and matches the data file
+ */
+Bool_t QwEventIndex::Read(const TString& indexfile, const TString& datafile)
+{
+  std::ifstream file(indexfile.Data());
+  if (! file.good()) return kFALSE;
+
+  // Header: size and modification time of the data file, number of events
+  std::string line, tag;
+  Long64_t size = 0, time = 0;
+  UInt_t nevents = 0;
+  std::getline(file, line);
+  std::istringstream header(line);
+  header >> tag >> tag >> size >> time >> nevents;
+  Long64_t datasize = 0, datatime = 0;
+  if (header.fail() || tag != "QwEventIndex"
+      || ! GetFileStamp(datafile, datasize, datatime)
+      || size != datasize || time != datatime || nevents == 0) {
+    QwWarning << "Ignoring stale or incomplete event index " << indexfile << QwLog::endl;
+    return kFALSE;
+  }
+
+  fEntries.clear();
+  Entry entry;
+  while (file >> entry.fPosition >> entry.fEventNumber >> entry.fType)
+    fEntries.push_back(entry);
+
+  fDataFileSize = size;
+  fDataFileTime = time;
+  fNumberOfEvents = nevents;
+  QwMessage << "Read event index " << indexfile << " with "
+            << fEntries.size() << " entries" << QwLog::endl;
+  return kTRUE;
+}
+
+/**
+ * Write the index file
+ * @param indexfile Index file name
+ * @return True on success
+ */
+Bool_t QwEventIndex::Write(const TString& indexfile) const
+{
+  if (! IsComplete()) return kFALSE;
+  std::ofstream file(indexfile.Data());
+  if (! file.good()) {
+    QwWarning << "Unable to write event index " << indexfile << QwLog::endl;
+    return kFALSE;
+  }
+  file << "# QwEventIndex " << fDataFileSize << " " << fDataFileTime
+       << " " << fNumberOfEvents << std::endl;
+  for (size_t i = 0; i < fEntries.size(); i++)
+    file << fEntries[i].fPosition << " " << fEntries[i].fEventNumber
+         << " " << fEntries[i].fType << "\n";
+  file.close();
+  if (file.fail()) {
+    QwWarning << "Unable to write event index " << indexfile << QwLog::endl;
+    return kFALSE;
+  }
+  QwMessage << "Wrote event index " << indexfile << " with "
+            << fEntries.size() << " entries" << QwLog::endl;
+  return kTRUE;
+}
+
+/**
+ * Find the next EPICS event
+ * @param position Position to start looking from
+ * @return Position of the EPICS event, or -1 when there is none
+ */
+Int_t QwEventIndex::FindNextEPICSEvent(UInt_t position) const
+{
+  for (size_t i = 0; i < fEntries.size(); i++)
+    if (fEntries[i].fType == kEPICSEvent && fEntries[i].fPosition >= position)
+      return fEntries[i].fPosition;
+  return -1;
+}
+
+/**
+ * Plan how to reach a physics event number: all non-physics events between
+ * the current position and the last indexed physics event at or before
+ * the requested event number, followed by that physics event.
+ * @param evtnum   Physics event number to reach
+ * @param position Current position in the file
+ * @param plan     Positions to read, in order
+ * @return True when seeking skips part of the file
+ */
+Bool_t QwEventIndex::GetSeekPlan(UInt_t evtnum, UInt_t position, std::vector<UInt_t>& plan) const
+{
+  plan.clear();
+
+  // Last indexed physics event before the requested one
+  const Entry* start = 0;
+  for (size_t i = 0; i < fEntries.size(); i++) {
+    if (fEntries[i].fType != kPhysicsEvent) continue;
+    if (fEntries[i].fEventNumber > evtnum) break;
+    start = &fEntries[i];
+  }
+  if (start == 0 || start->fPosition <= position) return kFALSE;
+
+  // Non-physics events on the way there
+  for (size_t i = 0; i < fEntries.size() && fEntries[i].fPosition < start->fPosition; i++)
+    if (fEntries[i].fType != kPhysicsEvent && fEntries[i].fPosition >= position)
+      plan.push_back(fEntries[i].fPosition);
+  plan.push_back(start->fPosition);
+  return kTRUE;
+}
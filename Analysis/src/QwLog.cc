@@ -11,6 +11,10 @@
 // System headers
 #include <fstream>
 #include <regex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
 
 // Qweak headers
 #include "QwColor.h"
@@ -28,6 +32,118 @@ bool QwLog::fFileAtNewLine = true;
 const std::ios_base::openmode QwLog::kTruncate = std::ios::trunc;
 const std::ios_base::openmode QwLog::kAppend = std::ios::app;
 
+
+/**
+ * \class QwLogAsyncFileBuffer
+ * \brief Stream buffer that hands complete lines to a writer thread
+ *
+ * The event loop only appends to an in-memory line; the file itself is
+ * written by a separate thread, so that slow disks do not stall the analysis.
+ */
+class QwLogAsyncFileBuffer: public std::streambuf {
+  public:
+    QwLogAsyncFileBuffer(const std::string& name, const std::ios_base::openmode mode)
+    : fFile(name.c_str(), mode), fStop(false) {
+      fThread = std::thread(&QwLogAsyncFileBuffer::Run, this);
+    }
+    ~QwLogAsyncFileBuffer() override {
+      Enqueue();
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+      }
+      fCondition.notify_one();
+      fThread.join();
+    }
+
+  protected:
+    int_type overflow(int_type c) override {
+      if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+      fLine.push_back(traits_type::to_char_type(c));
+      if (c == '\n') Enqueue();
+      return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+      fLine.append(s, n);
+      if (std::memchr(s, '\n', n)) Enqueue();
+      return n;
+    }
+    int sync() override {
+      Enqueue();
+      return 0;
+    }
+
+  private:
+    /// Pass the pending text to the writer thread
+    void Enqueue() {
+      if (fLine.empty()) return;
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fQueue.push_back(std::string());
+        fQueue.back().swap(fLine);
+      }
+      fCondition.notify_one();
+    }
+    /// Writer thread: write all queued text to the file
+    void Run() {
+      std::vector<std::string> lines;
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (true) {
+        fCondition.wait(lock, [this]{ return fStop || ! fQueue.empty(); });
+        lines.swap(fQueue);
+        bool stop = fStop;
+        lock.unlock();
+        for (size_t i = 0; i < lines.size(); i++) fFile << lines[i];
+        fFile << std::flush;
+        lines.clear();
+        lock.lock();
+        if (stop && fQueue.empty()) break;
+      }
+    }
+
+    std::ofstream fFile;
+    std::string fLine;
+    std::vector<std::string> fQueue;
+    std::mutex fMutex;
+    std::condition_variable fCondition;
+    bool fStop;
+    std::thread fThread;
+};
+
+
+thread_local unsigned long QwLogRateLimit::fReportSuppressed = 0;
+
+/*! Count an occurrence for an instance: the first fMax occurrences are
+ *  allowed, then those when the count reaches 2*fMax, 4*fMax, etc.
+ */
+bool QwLogRateLimit::Allow(const void* instance)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fCount++;
+  Counter& counter = fCounters[instance];
+  if (counter.fNext == 0) counter.fNext = 2 * fMax;
+  counter.fCount++;
+  if (counter.fCount <= fMax || counter.fCount >= counter.fNext) {
+    if (counter.fCount > fMax) counter.fNext *= 2;
+    fReportSuppressed = counter.fSuppressed;
+    counter.fSuppressed = 0;
+    return true;
+  }
+  counter.fSuppressed++;
+  fTotalSuppressed++;
+  return false;
+}
+
+/*! Report the number of suppressed messages for this call site
+ */
+QwLogRateLimit::~QwLogRateLimit()
+{
+  if (fTotalSuppressed > 0) {
+    QwMessage << "Suppressed " << fTotalSuppressed << " of " << fCount
+              << " messages from " << fFile << ":" << fLine << QwLog::endl;
+  }
+}
+
 /*! The constructor initializes the screen stream and resets the file stream
  */
 QwLog::QwLog()
@@ -38,6 +154,8 @@ QwLog::QwLog()
 
   fFileThreshold = kMessage;
   fFile = 0;
+  fFileBuffer = 0;
+  fUseAsyncFile = false;
 
   fLogLevel = kMessage;
 
@@ -54,6 +172,10 @@ QwLog::~QwLog()
     delete fFile;
     fFile = 0;
   }
+  if (fFileBuffer) {
+    delete fFileBuffer;
+    fFileBuffer = 0;
+  }
 }
 
 
@@ -77,6 +199,9 @@ void QwLog::DefineOptions(QwOptions* options)
   options->AddOptions("Logging options")("QwLog.logfile",
                 po::value<string>(),
                 "log file");
+  options->AddOptions("Logging options")("QwLog.logfile-async",
+                po::value<bool>()->default_bool_value(false),
+                "write the log file from a separate thread");
   options->AddOptions("Logging options")("QwLog.loglevel-file",
                 po::value<int>()->default_value(kMessage),
                 "log level for file output");
@@ -106,6 +231,7 @@ void QwLog::DefineOptions(QwOptions* options)
 void QwLog::ProcessOptions(QwOptions* options)
 {
   // Initialize log file
+  fUseAsyncFile = options->GetValue<bool>("QwLog.logfile-async");
   if (options->HasValue("QwLog.logfile"))
     InitLogFile(options->GetValue<std::string>("QwLog.logfile"));
 
@@ -158,9 +284,18 @@ void QwLog::InitLogFile(const string name, const std::ios_base::openmode mode)
     delete fFile;
     fFile = 0;
   }
+  if (fFileBuffer) {
+    delete fFileBuffer;
+    fFileBuffer = 0;
+  }
 
   std::ios_base::openmode flags = std::ios::out | mode;
-  fFile = new std::ofstream(name.c_str(), flags);
+  if (fUseAsyncFile) {
+    fFileBuffer = new QwLogAsyncFileBuffer(name, flags);
+    fFile = new std::ostream(fFileBuffer);
+  } else {
+    fFile = new std::ofstream(name.c_str(), flags);
+  }
   fFileThreshold = kMessage;
 }
 
@@ -13,6 +13,7 @@
 #include "QwLog.h"
 #include "QwUnits.h"
 #include "QwBlinder.h"
+#include "QwBlockChannelValues.h"
 #include "QwHistogramHelper.h"
 #ifdef __USE_DATABASE__
 #include "QwDBInterface.h"
@@ -76,12 +77,11 @@ Int_t QwMollerADC_Channel::ApplyHWChecks()
       fErrorFlag |= kErrorFlag_sample;
     }
 
-    // Check SW and HW return the same sum
-    bStatus = (GetRawHardwareSum() == GetRawSoftwareSum());
-    //fEventIsGood = bStatus;
-    if (!bStatus) {
-      fErrorFlag |= kErrorFlag_SW_HW;
-    }
+    // Check SW and HW return the same sum, and further below that the
+    // HW sum is not zero; the decoders determine both with the raw data
+    UInt_t raw_checks = fHasRawHWChecks ? fRawHWChecks
+      : RawHWChecks(GetRawHardwareSum(), GetRawSoftwareSum());
+    fErrorFlag |= (raw_checks & kErrorFlag_SW_HW);
 
 
 
@@ -114,9 +114,7 @@ Int_t QwMollerADC_Channel::ApplyHWChecks()
     }
 
     //check for the hw_sum is zero
-    if (GetRawHardwareSum()==0){
-      fErrorFlag|=kErrorFlag_ZeroHW;
-    }
+    fErrorFlag |= (raw_checks & kErrorFlag_ZeroHW);
     if (!fEventIsGood)
       fSequenceNo_Counter=0;//resetting the counter after ApplyHWChecks() a failure
 
@@ -215,6 +213,7 @@ void QwMollerADC_Channel::InitializeChannel(TString name, TString datatosave)
   fSequenceNo_Prev       = 0;
   fSequenceNo_Counter    = 0;
   fPrev_HardwareBlockSum = 0.0;
+  fMockSequenceNumber    = 0;
 
   fGoodEventCount        = 0;
 
@@ -265,9 +264,30 @@ void QwMollerADC_Channel::ClearEventData()
   fNumberOfSamples  = 0;
   fGoodEventCount   = 0;
   fErrorFlag=0;
+  fHasRawHWChecks = kFALSE;
   return;
 }
 
+/**
+ * Clear the event data, the history of the hardware checks (previous
+ * sequence number and block sum) and the error counters of the run.
+ */
+void QwMollerADC_Channel::ClearRunState()
+{
+  ClearEventData();
+  fNumEvtsWithEventCutsRejected = 0;
+  fErrorCount_sample     = 0;
+  fErrorCount_SW_HW      = 0;
+  fErrorCount_Sequence   = 0;
+  fErrorCount_SameHW     = 0;
+  fErrorCount_ZeroHW     = 0;
+  fErrorCount_HWSat      = 0;
+  fADC_Same_NumEvt       = 0;
+  fSequenceNo_Prev       = 0;
+  fSequenceNo_Counter    = 0;
+  fPrev_HardwareBlockSum = 0.0;
+}
+
 void QwMollerADC_Channel::RandomizeEventData(int helicity, double time)
 {
   // updated to calculate the drift for each block individually
@@ -435,6 +455,9 @@ void QwMollerADC_Channel::EncodeEventData(std::vector<UInt_t> &buffer)
     localbuf[22] = fBlockSumSq_raw[4] >> 32;
     localbuf[23] = fBlock_min[4];
     localbuf[24] = fBlock_max[4];
+    // Count the events like the module does, so that the sequence number
+    // check of the analysis sees a continuous sequence in each mock run
+    fSequenceNumber = (++fMockSequenceNumber) & 0xFF;
     localbuf[25] = (fNumberOfSamples << 16 & 0xFFFF0000)
                 | (fSequenceNumber  << 8  & 0x0000FF00);
 
@@ -447,6 +470,57 @@ void QwMollerADC_Channel::EncodeEventData(std::vector<UInt_t> &buffer)
 
 
 Int_t QwMollerADC_Channel::ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left, UInt_t index)
+{
+  // Use the decoded record when this channel is in the active bank
+  QwMollerADC_BankDecoder* bank = QwMollerADC_BankDecoder::GetActive();
+  Int_t record = -1;
+  if (bank != 0 && ! IsNameEmpty() && num_words_left >= fNumberOfDataWords
+      && fBlocksPerEvent == QwMollerADC_BankDecoder::kBlocks)
+    record = bank->Find(buffer);
+  if (record < 0)
+    return DecodeEvBuffer(buffer, num_words_left);
+  if (! bank->IsVerifying())
+    return LoadDecodedRecord(*bank, record);
+
+  // Self-test: decode a copy of this channel with the per-channel decoder
+  QwMollerADC_Channel reference(*this);
+  Int_t reference_words = reference.DecodeEvBuffer(buffer, num_words_left);
+  Int_t words_read = LoadDecodedRecord(*bank, record);
+  Bool_t match = (words_read == reference_words
+               && fHardwareBlockSum_raw == reference.fHardwareBlockSum_raw
+               && fSoftwareBlockSum_raw == reference.fSoftwareBlockSum_raw
+               && fSequenceNumber  == reference.fSequenceNumber
+               && fNumberOfSamples == reference.fNumberOfSamples
+               && fRawHWChecks     == reference.fRawHWChecks);
+  for (Int_t i = 0; i < fBlocksPerEvent; i++)
+    match = match
+         && fBlock_raw[i]      == reference.fBlock_raw[i]
+         && fBlockSumSq_raw[i] == reference.fBlockSumSq_raw[i]
+         && fBlock_min[i]      == reference.fBlock_min[i]
+         && fBlock_max[i]      == reference.fBlock_max[i];
+  bank->RecordComparison(*this, match);
+  return words_read;
+}
+
+Int_t QwMollerADC_Channel::LoadDecodedRecord(const QwMollerADC_BankDecoder& bank, UInt_t record)
+{
+  const UInt_t k = record * QwMollerADC_BankDecoder::kBlocks;
+  for (Int_t i = 0; i < QwMollerADC_BankDecoder::kBlocks; i++) {
+    fBlock_raw[i]      = bank.fBlock_raw[k + i];
+    fBlockSumSq_raw[i] = bank.fBlockSumSq_raw[k + i];
+    fBlock_min[i]      = bank.fBlock_min[k + i];
+    fBlock_max[i]      = bank.fBlock_max[k + i];
+  }
+  fHardwareBlockSum_raw = bank.fHardwareBlockSum_raw[record];
+  fSoftwareBlockSum_raw = bank.fSoftwareBlockSum_raw[record];
+  fSequenceNumber       = bank.fSequenceNumber[record];
+  fNumberOfSamples      = bank.fNumberOfSamples[record];
+  fRawHWChecks          = bank.fRawHWChecks[record];
+  fHasRawHWChecks       = kTRUE;
+  return fNumberOfDataWords;
+}
+
+Int_t QwMollerADC_Channel::DecodeEvBuffer(UInt_t* buffer, UInt_t num_words_left)
 {
   UInt_t words_read = 0;
   UInt_t localbuf[kWordsPerChannel] = {0};
@@ -485,6 +559,9 @@ Int_t QwMollerADC_Channel::ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left
       fSequenceNumber   = (localbuf[25]>>8)  & 0xFF;
       fNumberOfSamples  = (localbuf[25]>>16) & 0xFFFF;
 
+      fRawHWChecks = RawHWChecks(fHardwareBlockSum_raw, fSoftwareBlockSum_raw);
+      fHasRawHWChecks = kTRUE;
+
       words_read = fNumberOfDataWords;
 
     } else
@@ -511,7 +588,7 @@ void QwMollerADC_Channel::ProcessEvent()
     fErrorFlag |= kErrorFlag_sample;
   } else if (fNumberOfSamples == 0) {
     //  This is probably a more serious problem.
-    QwWarning << "QwMollerADC_Channel::ProcessEvent:  Channel "
+    QwWarningLimited(this,10) << "QwMollerADC_Channel::ProcessEvent:  Channel "
               << this->GetElementName().Data()
               << " has fNumberOfSamples==0 but has valid data in the hardware sum.  "
               << "Flag this as an error."
@@ -1105,6 +1182,51 @@ QwMollerADC_Channel& QwMollerADC_Channel::operator= (const QwMollerADC_Channel &
   return *this;
 }
 
+/// Packs the same event data as operator= copies
+void QwMollerADC_Channel::PackEventData(std::vector<char>& record) const
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::PackEventData(record);
+    PackValues(record, fBlock, fBlocksPerEvent);
+    PackValues(record, fBlockM2, fBlocksPerEvent);
+    PackValue(record, fHardwareBlockSum);
+    PackValue(record, fHardwareBlockSumM2);
+    PackValue(record, fHardwareBlockSumError);
+    PackValue(record, fNumberOfSamples);
+    PackValue(record, fSequenceNumber);
+    if (fDataToSave == kRaw){
+      PackValues(record, fBlock_raw, fBlocksPerEvent);
+      PackValues(record, fBlockSumSq_raw, fBlocksPerEvent);
+      PackValues(record, fBlock_min, fBlocksPerEvent);
+      PackValues(record, fBlock_max, fBlocksPerEvent);
+      PackValue(record, fHardwareBlockSum_raw);
+      PackValue(record, fSoftwareBlockSum_raw);
+    }
+  }
+}
+
+void QwMollerADC_Channel::UnpackEventData(const char*& record)
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::UnpackEventData(record);
+    UnpackValues(record, fBlock, fBlocksPerEvent);
+    UnpackValues(record, fBlockM2, fBlocksPerEvent);
+    UnpackValue(record, fHardwareBlockSum);
+    UnpackValue(record, fHardwareBlockSumM2);
+    UnpackValue(record, fHardwareBlockSumError);
+    UnpackValue(record, fNumberOfSamples);
+    UnpackValue(record, fSequenceNumber);
+    if (fDataToSave == kRaw){
+      UnpackValues(record, fBlock_raw, fBlocksPerEvent);
+      UnpackValues(record, fBlockSumSq_raw, fBlocksPerEvent);
+      UnpackValues(record, fBlock_min, fBlocksPerEvent);
+      UnpackValues(record, fBlock_max, fBlocksPerEvent);
+      UnpackValue(record, fHardwareBlockSum_raw);
+      UnpackValue(record, fSoftwareBlockSum_raw);
+    }
+  }
+}
+
 void QwMollerADC_Channel::AssignScaledValue(const QwMollerADC_Channel &value,
                                  Double_t scale)
 {
@@ -1398,7 +1520,7 @@ QwMollerADC_Channel& QwMollerADC_Channel::operator/= (const QwMollerADC_Channel
 
   // Nanny
   if (fHardwareBlockSum != fHardwareBlockSum)
-    QwWarning << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
+    QwWarningLimited(this,10) << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
 
   return *this;
 }
@@ -1452,6 +1574,42 @@ void QwMollerADC_Channel::AddChannelOffset(Double_t offset)
   return;
 }
 
+/**
+ * Copy the blocks, the hardware sum, their second moments and the scalar
+ * event fields into a packed record for the fused device kernels.
+ */
+void QwMollerADC_Channel::GetBlockValues(QwBlockChannelValues& values) const
+{
+  for (Int_t i = 0; i < QwBlockChannelValues::kBlocks; i++) {
+    values.fValue[i]   = fBlock[i];
+    values.fValueM2[i] = fBlockM2[i];
+  }
+  values.fValue[QwBlockChannelValues::kSum]   = fHardwareBlockSum;
+  values.fValueM2[QwBlockChannelValues::kSum] = fHardwareBlockSumM2;
+  values.fSumError        = fHardwareBlockSumError;
+  values.fNumberOfSamples = fNumberOfSamples;
+  values.fSequenceNumber  = fSequenceNumber;
+  values.fGoodEventCount  = fGoodEventCount;
+  values.fErrorFlag       = fErrorFlag;
+}
+
+void QwMollerADC_Channel::SetBlockValues(const QwBlockChannelValues& values)
+{
+  if (!IsNameEmpty()) {
+    for (Int_t i = 0; i < QwBlockChannelValues::kBlocks; i++) {
+      fBlock[i]   = values.fValue[i];
+      fBlockM2[i] = values.fValueM2[i];
+    }
+    fHardwareBlockSum      = values.fValue[QwBlockChannelValues::kSum];
+    fHardwareBlockSumM2    = values.fValueM2[QwBlockChannelValues::kSum];
+    fHardwareBlockSumError = values.fSumError;
+    fNumberOfSamples = values.fNumberOfSamples;
+    fSequenceNumber  = values.fSequenceNumber;
+    fGoodEventCount  = values.fGoodEventCount;
+    fErrorFlag       = values.fErrorFlag;
+  }
+}
+
 void QwMollerADC_Channel::Scale(Double_t scale)
 {
   if (!IsNameEmpty()){
@@ -1668,7 +1826,7 @@ void QwMollerADC_Channel::AccumulateRunningSum(const QwMollerADC_Channel& value,
 
   // Nanny
   if (fHardwareBlockSum != fHardwareBlockSum)
-    QwWarning << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
+    QwWarningLimited(this,10) << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
 }
 
 
@@ -1748,8 +1906,7 @@ void QwMollerADC_Channel::Blind(const QwBlinder *blinder)
 {
   if (!IsNameEmpty()) {
     if (blinder->IsBlinderOkay() && ((fErrorFlag)==0) ){
-      for (Int_t i = 0; i < fBlocksPerEvent; i++)
-        blinder->BlindValue(fBlock[i]);
+      blinder->BlindValues(fBlock, fBlocksPerEvent);
       blinder->BlindValue(fHardwareBlockSum);
     } else {
       blinder->ModifyThisErrorCode(fErrorFlag);
@@ -1770,8 +1927,7 @@ void QwMollerADC_Channel::Blind(const QwBlinder *blinder, const QwMollerADC_Chan
 {
   if (!IsNameEmpty()) {
     if (blinder->IsBlinderOkay() && ((fErrorFlag) ==0) ){
-      for (Int_t i = 0; i < fBlocksPerEvent; i++)
-        blinder->BlindValue(fBlock[i], yield.fBlock[i]);
+      blinder->BlindValues(fBlock, yield.fBlock, fBlocksPerEvent);
       blinder->BlindValue(fHardwareBlockSum, yield.fHardwareBlockSum);
     } else {
       blinder->ModifyThisErrorCode(fErrorFlag);//update the HW error code
@@ -2007,3 +2163,110 @@ void QwMollerADC_Channel::AddErrEntriesToList(std::vector<QwErrDBInterface> &row
 
 }
 #endif
+
+
+thread_local QwMollerADC_BankDecoder* QwMollerADC_BankDecoder::fActive = 0;
+
+QwMollerADC_BankDecoder::~QwMollerADC_BankDecoder()
+{
+  if (fActive == this) fActive = 0;
+  if (fVerify && fNumberOfBanks > 0) {
+    QwMessage << "MollerADC bank decoder self-test: " << fNumberOfComparisons
+              << " channel reads in " << fNumberOfBanks << " banks, "
+              << fNumberOfMismatches << " mismatches" << QwLog::endl;
+  }
+}
+
+/*!  Decode all complete channel records in a bank, starting at the first
+ *   record.  Every field is unpacked for all records by its own loop over
+ *   the records; the record layout is the one of
+ *   QwMollerADC_Channel::DecodeEvBuffer.
+ *   @param buffer     Start of the bank
+ *   @param num_words  Number of words in the bank
+ *   @param first_word Offset of the first channel record in the bank
+ */
+void QwMollerADC_BankDecoder::Decode(const UInt_t* buffer, UInt_t num_words, UInt_t first_word)
+{
+  const UInt_t words = QwMollerADC_Channel::kWordsPerChannel;
+
+  fBank = buffer;
+  fNumWords = num_words;
+  fFirstWord = first_word;
+  fNumRecords = (num_words > first_word) ? (num_words - first_word) / words : 0;
+
+  const UInt_t n = fNumRecords;
+  fBlock_raw.resize(n * kBlocks);
+  fBlockSumSq_raw.resize(n * kBlocks);
+  fBlock_min.resize(n * kBlocks);
+  fBlock_max.resize(n * kBlocks);
+  fHardwareBlockSum_raw.resize(n);
+  fSoftwareBlockSum_raw.resize(n);
+  fSequenceNumber.resize(n);
+  fNumberOfSamples.resize(n);
+  fRawHWChecks.resize(n);
+
+  const UInt_t* record = buffer + first_word;
+  for (Int_t i = 0; i < kBlocks; i++) {
+    Int_t*    block = fBlock_raw.data();
+    Long64_t* sumsq = fBlockSumSq_raw.data();
+    Int_t*    min   = fBlock_min.data();
+    Int_t*    max   = fBlock_max.data();
+    for (UInt_t r = 0; r < n; r++) {
+      const UInt_t* word = record + r * words + i * 5;
+      block[r * kBlocks + i] = static_cast<Int_t>(word[0]);
+      sumsq[r * kBlocks + i] = static_cast<Int_t>(word[1])
+        + (Long64_t (static_cast<Int_t>(word[2])) << 32);
+      min[r * kBlocks + i]   = static_cast<Int_t>(word[3]);
+      max[r * kBlocks + i]   = static_cast<Int_t>(word[4]);
+    }
+  }
+
+  const Int_t* block = fBlock_raw.data();
+  Int_t*  hwsum   = fHardwareBlockSum_raw.data();
+  Int_t*  swsum   = fSoftwareBlockSum_raw.data();
+  UInt_t* seq     = fSequenceNumber.data();
+  UInt_t* samples = fNumberOfSamples.data();
+  UInt_t* checks  = fRawHWChecks.data();
+  for (UInt_t r = 0; r < n; r++) {
+    const UInt_t* word = record + r * words;
+    // Unsigned sum, which wraps like the sum of the per-channel decoder
+    UInt_t sum = 0;
+    for (Int_t i = 0; i < kBlocks; i++)
+      sum += static_cast<UInt_t>(block[r * kBlocks + i]);
+    swsum[r]   = static_cast<Int_t>(sum);
+    hwsum[r]   = static_cast<Int_t>(word[20]);
+    seq[r]     = (word[25] >> 8)  & 0xFF;
+    samples[r] = (word[25] >> 16) & 0xFFFF;
+    checks[r]  = QwMollerADC_Channel::RawHWChecks(hwsum[r], swsum[r]);
+  }
+
+  fNumberOfBanks++;
+  fActive = this;
+}
+
+void QwMollerADC_BankDecoder::Release()
+{
+  if (fActive == this) fActive = 0;
+  fBank = 0;
+  fNumWords = 0;
+  fNumRecords = 0;
+}
+
+Int_t QwMollerADC_BankDecoder::Find(const UInt_t* word) const
+{
+  if (fBank == 0 || word < fBank + fFirstWord) return -1;
+  UInt_t offset = word - fBank - fFirstWord;
+  if (offset % QwMollerADC_Channel::kWordsPerChannel != 0) return -1;
+  UInt_t record = offset / QwMollerADC_Channel::kWordsPerChannel;
+  return (record < fNumRecords) ? static_cast<Int_t>(record) : -1;
+}
+
+void QwMollerADC_BankDecoder::RecordComparison(const QwMollerADC_Channel& channel, Bool_t match)
+{
+  fNumberOfComparisons++;
+  if (! match) {
+    fNumberOfMismatches++;
+    QwErrorLimited(&channel,10) << "QwMollerADC_BankDecoder: bank and per-channel decoders differ for "
+                       << channel.GetElementName() << QwLog::endl;
+  }
+}
@@ -10,6 +10,7 @@
 #include <climits>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 
 // Qweak headers
 #include "QwLog.h"
@@ -20,6 +21,27 @@ std::vector<fs::path> QwParameterFile::fSearchPaths;
 // Set current run number to zero
 UInt_t QwParameterFile::fCurrentRunNumber = 0;
 
+// Index of the search paths
+std::map<std::string, QwParameterFile::SearchPathIndex> QwParameterFile::fSearchPathIndex;
+
+// Statistics of the parameter file lookups
+UInt_t QwParameterFile::fNumberOfResolutions = 0;
+Double_t QwParameterFile::fResolutionTime = 0.0;
+
+// Configuration snapshot
+Bool_t QwParameterFile::fSnapshotEnabled = kFALSE;
+Bool_t QwParameterFile::fSnapshotChanged = kFALSE;
+std::map<std::string, QwParameterFile::SnapshotEntry> QwParameterFile::fSnapshotLoaded;
+std::map<std::string, QwParameterFile::SnapshotEntry> QwParameterFile::fSnapshotUsed;
+std::pair<int,int> QwParameterFile::fSnapshotRunRange(0, INT_MAX);
+std::string QwParameterFile::fSnapshotLoadedFile;
+std::pair<int,int> QwParameterFile::fSnapshotLoadedRange(0, INT_MAX);
+std::vector<Long64_t> QwParameterFile::fSnapshotSearchPathTimes;
+
+// Configuration record
+std::map<std::string, QwParameterFile::SnapshotEntry> QwParameterFile::fConfiguration;
+std::map<std::string, QwParameterFile::SnapshotEntry> QwParameterFile::fPreviousConfiguration;
+
 // Set default comment, whitespace, section, module characters
 const std::string QwParameterFile::kDefaultCommentChars = "#!;";
 const std::string QwParameterFile::kDefaultWhitespaceChars = " \t\r";
@@ -132,33 +154,30 @@ QwParameterFile::QwParameterFile(const std::string& name)
     QwMessage << "Parameter file: "
               << QwColor(Qw::kGreen)  << file.string()
               << QwColor(Qw::kNormal) << QwLog::endl;
+    AddToSnapshot(name);
+
+    // Else, use the configuration snapshot
+  } else if (fSnapshotLoaded.count(name) > 0) {
+    const SnapshotEntry& entry = fSnapshotLoaded[name];
+    fBestParamFileNameAndPath = entry.fPath;
+    this->SetParamFilename();
+    fStream << entry.fContents;
+    QwMessage << "Parameter file: "
+              << QwColor(Qw::kGreen)  << entry.fPath
+              << QwColor(Qw::kNormal) << " (snapshot)" << QwLog::endl;
+    if (fSnapshotEnabled) fSnapshotUsed[name] = entry;
+    fConfiguration[name] = entry;
+    fConfiguration[name].fContents.clear();
 
     // Else, loop through search path and files
   } else {
 
-    // Separate file in stem and extension
-    std::string file_stem = file.stem().string();
-    std::string file_ext = file.extension().string();
-
     // Find the best match
-    Int_t best_score = 0;
+    auto start = std::chrono::steady_clock::now();
     fs::path best_path;
-    for (size_t i = 0; i < fSearchPaths.size(); i++) {
-
-      fs::path path;
-      Int_t score = FindFile(fSearchPaths[i], file_stem, file_ext, path);
-      if (score > best_score) {
-        // Found file with better score
-        best_score = score;
-        best_path  = path;
-      } else if (score == best_score) {
-        // Found file with identical score
-        QwWarning << "Equally likely parameter files encountered: " << best_path.string()
-                  << " and " << path.string() << QwLog::endl;
-        QwMessage << "Analysis will use parameter file: " << best_path.string()
-                  << QwLog::endl;
-      }
-    } // end of loop over search paths
+    Int_t best_score = FindBestFile(file, best_path);
+    fNumberOfResolutions++;
+    fResolutionTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
     // File not found
     if (best_score == 0) {
@@ -182,10 +201,312 @@ QwParameterFile::QwParameterFile(const std::string& name)
     QwMessage << "Parameter file: "
               << QwColor(Qw::kGreen)  << best_path.string()
               << QwColor(Qw::kNormal) << QwLog::endl;
+    AddToSnapshot(name);
   }
 }
 
 
+/**
+ * Find the best match for a file name in the search paths
+ * @param file Name of the file as requested
+ * @param best_path Path of the best match
+ * @param warn Warn about equally likely files
+ * @return Score of the best match, zero when no file was found
+ */
+Int_t QwParameterFile::FindBestFile(const fs::path& file, fs::path& best_path, Bool_t warn)
+{
+  // Separate file in stem and extension
+  std::string file_stem = file.stem().string();
+  std::string file_ext = file.extension().string();
+
+  Int_t best_score = 0;
+  for (size_t i = 0; i < fSearchPaths.size(); i++) {
+
+    fs::path path;
+    Int_t score = FindFile(fSearchPaths[i], file_stem, file_ext, path);
+    if (score > best_score) {
+      // Found file with better score
+      best_score = score;
+      best_path  = path;
+    } else if (score == best_score && warn) {
+      // Found file with identical score
+      QwWarning << "Equally likely parameter files encountered: " << best_path.string()
+                << " and " << path.string() << QwLog::endl;
+      QwMessage << "Analysis will use parameter file: " << best_path.string()
+                << QwLog::endl;
+    }
+  } // end of loop over search paths
+  return best_score;
+}
+
+/**
+ * Add the contents of this file to the configuration snapshot of this run,
+ * and its path and hash to the configuration record
+ * @param name Name of the file as requested
+ */
+void QwParameterFile::AddToSnapshot(const std::string& name)
+{
+  SnapshotEntry entry;
+  entry.fPath = fBestParamFileNameAndPath.Data();
+  std::error_code ec;
+  entry.fSize = fs::file_size(entry.fPath, ec);
+  entry.fTime = fs::last_write_time(entry.fPath, ec).time_since_epoch().count();
+  entry.fHash = Hash(fStream.str());
+  fConfiguration[name] = entry;
+
+  if (! fSnapshotEnabled) return;
+  entry.fContents = fStream.str();
+  fSnapshotUsed[name] = entry;
+  fSnapshotChanged = kTRUE;
+}
+
+/**
+ * Check whether the parameter files in the previous configuration record
+ * would be read unchanged for the current run: every file name
+ * must still resolve to the same path for the current run number, and the
+ * file must have the same contents.  Objects constructed from these files
+ * can then be used for the current run without being constructed again.
+ * @return True when the configuration is unchanged
+ */
+Bool_t QwParameterFile::IsConfigurationUnchanged()
+{
+  if (fPreviousConfiguration.empty()) return kFALSE;
+  for (auto entry = fPreviousConfiguration.begin(); entry != fPreviousConfiguration.end(); entry++) {
+    fs::path file(entry->first);
+    std::string path = file.string();
+    if (entry->first.find("/") != 0) {
+      fs::path best_path;
+      if (FindBestFile(file, best_path, kFALSE) == 0) return kFALSE;
+      path = best_path.string();
+    }
+    if (path != entry->second.fPath || ! IsCurrent(entry->second)) {
+      QwMessage << "Parameter file " << entry->first << " changed for run "
+                << fCurrentRunNumber << QwLog::endl;
+      return kFALSE;
+    }
+  }
+  return kTRUE;
+}
+
+/**
+ * Check whether a file still has the contents stored in a snapshot entry;
+ * the contents are only hashed when the size or modification time differ.
+ * @param entry Snapshot entry
+ * @return True when the file is unchanged
+ */
+Bool_t QwParameterFile::IsCurrent(const SnapshotEntry& entry)
+{
+  std::error_code ec;
+  Long64_t size = fs::file_size(entry.fPath, ec);
+  if (ec) return kFALSE;
+  Long64_t time = fs::last_write_time(entry.fPath, ec).time_since_epoch().count();
+  if (size == entry.fSize && time == entry.fTime) return kTRUE;
+  std::ifstream file(entry.fPath.c_str());
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return Hash(contents.str()) == entry.fHash;
+}
+
+/**
+ * 64-bit FNV-1a hash of the contents of a file
+ * @param contents Contents
+ * @return Hash
+ */
+ULong64_t QwParameterFile::Hash(const std::string& contents)
+{
+  ULong64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < contents.size(); i++) {
+    hash ^= static_cast<unsigned char>(contents[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * Modification times of the search paths, which change when files are
+ * added to, removed from or renamed in them
+ * @return Modification times in the order of the search paths
+ */
+std::vector<Long64_t> QwParameterFile::GetSearchPathTimes()
+{
+  std::vector<Long64_t> times;
+  for (size_t i = 0; i < fSearchPaths.size(); i++) {
+    std::error_code ec;
+    times.push_back(fs::last_write_time(fSearchPaths[i], ec).time_since_epoch().count());
+  }
+  return times;
+}
+
+/**
+ * Load a configuration snapshot for the current run.  The snapshot is only
+ * used when the current run is in its run range, the search paths have not
+ * changed, and all files in it are unchanged; otherwise the parameter files
+ * are found and read as usual.  In both cases the files used for this run
+ * are recorded for SaveSnapshot.
+ *
+ * For later runs in the same job the snapshot that was read or written
+ * before is used again without reading it, when the run is in its range, the
+ * search paths have not changed, and each of its files still has the same
+ * size and modification time (or else the same contents).
+ *
+ * The snapshot only saves finding and reading the parameter files; all
+ * objects are still constructed from their contents for each run.
+ * @param filename Snapshot file name
+ * @return True when the snapshot is used
+ */
+Bool_t QwParameterFile::LoadSnapshot(const std::string& filename)
+{
+  fSnapshotEnabled = kTRUE;
+  fSnapshotChanged = kFALSE;
+  fSnapshotUsed.clear();
+  fSnapshotRunRange = std::pair<int,int>(0, INT_MAX);
+
+  // Snapshot of an earlier run in this job
+  std::vector<Long64_t> times = GetSearchPathTimes();
+  if (filename == fSnapshotLoadedFile
+      && fSnapshotLoadedRange.first <= int(fCurrentRunNumber)
+      && int(fCurrentRunNumber) <= fSnapshotLoadedRange.second
+      && times == fSnapshotSearchPathTimes) {
+    Bool_t current = kTRUE;
+    for (auto entry = fSnapshotLoaded.begin(); current && entry != fSnapshotLoaded.end(); entry++)
+      current = IsCurrent(entry->second);
+    if (current) {
+      fSnapshotRunRange = fSnapshotLoadedRange;
+      QwMessage << "Using configuration snapshot " << filename << " with "
+                << fSnapshotLoaded.size() << " parameter files" << QwLog::endl;
+      return kTRUE;
+    }
+  }
+  fSnapshotLoaded.clear();
+  fSnapshotLoadedFile.clear();
+
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (! file.good()) return kFALSE;
+
+  // Binary strings and integers
+  auto read_string = [&file](std::string& value) {
+    UInt_t length = 0;
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+    value.resize(file ? length : 0);
+    file.read(&value[0], value.size());
+  };
+  auto read_value = [&file](auto& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+  };
+
+  std::string tag;
+  read_string(tag);
+  std::pair<int,int> range;
+  read_value(range.first);
+  read_value(range.second);
+  Bool_t valid = file.good() && tag == "QwParameterFileSnapshot 1"
+    && range.first <= int(fCurrentRunNumber) && int(fCurrentRunNumber) <= range.second;
+
+  // Search paths and their modification times
+  UInt_t npaths = 0;
+  read_value(npaths);
+  valid = valid && file.good() && npaths == fSearchPaths.size();
+  for (UInt_t i = 0; valid && i < npaths; i++) {
+    std::string path;
+    Long64_t time = 0;
+    read_string(path);
+    read_value(time);
+    valid = file.good() && path == fSearchPaths[i].string() && time == times[i];
+  }
+
+  // Files
+  UInt_t nfiles = 0;
+  read_value(nfiles);
+  std::map<std::string, SnapshotEntry> entries;
+  for (UInt_t i = 0; valid && i < nfiles; i++) {
+    std::string name;
+    SnapshotEntry entry;
+    read_string(name);
+    read_string(entry.fPath);
+    read_string(entry.fContents);
+    read_value(entry.fSize);
+    read_value(entry.fTime);
+    read_value(entry.fHash);
+    valid = file.good() && Hash(entry.fContents) == entry.fHash && IsCurrent(entry);
+    entries[name] = entry;
+  }
+
+  if (! valid) {
+    QwMessage << "Configuration snapshot " << filename << " is not valid for run "
+              << fCurrentRunNumber << "; reading the parameter files" << QwLog::endl;
+    return kFALSE;
+  }
+  fSnapshotLoaded.swap(entries);
+  fSnapshotLoadedFile = filename;
+  fSnapshotLoadedRange = range;
+  fSnapshotSearchPathTimes = times;
+  fSnapshotRunRange = range;
+  QwMessage << "Using configuration snapshot " << filename << " with "
+            << fSnapshotLoaded.size() << " parameter files" << QwLog::endl;
+  return kTRUE;
+}
+
+/**
+ * Write the parameter files used for this run to a configuration snapshot,
+ * together with the runs for which the same files would be found.  Nothing
+ * is written when all files came from the loaded snapshot.
+ * @param filename Snapshot file name
+ * @return True when the snapshot is up to date
+ */
+Bool_t QwParameterFile::SaveSnapshot(const std::string& filename)
+{
+  if (! fSnapshotEnabled) return kFALSE;
+  if (! fSnapshotChanged) return kTRUE;
+
+  std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+  auto write_string = [&file](const std::string& value) {
+    UInt_t length = value.size();
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(value.data(), value.size());
+  };
+  auto write_value = [&file](const auto& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  write_string("QwParameterFileSnapshot 1");
+  write_value(fSnapshotRunRange.first);
+  write_value(fSnapshotRunRange.second);
+  std::vector<Long64_t> times = GetSearchPathTimes();
+  UInt_t npaths = fSearchPaths.size();
+  write_value(npaths);
+  for (size_t i = 0; i < fSearchPaths.size(); i++) {
+    write_string(fSearchPaths[i].string());
+    write_value(times[i]);
+  }
+  UInt_t nfiles = fSnapshotUsed.size();
+  write_value(nfiles);
+  for (auto entry = fSnapshotUsed.begin(); entry != fSnapshotUsed.end(); entry++) {
+    write_string(entry->first);
+    write_string(entry->second.fPath);
+    write_string(entry->second.fContents);
+    write_value(entry->second.fSize);
+    write_value(entry->second.fTime);
+    write_value(entry->second.fHash);
+  }
+  file.close();
+  if (file.fail()) {
+    QwWarning << "Unable to write configuration snapshot " << filename << QwLog::endl;
+    return kFALSE;
+  }
+  QwMessage << "Wrote configuration snapshot " << filename << " with " << nfiles
+            << " parameter files for runs " << fSnapshotRunRange.first << " to "
+            << fSnapshotRunRange.second << QwLog::endl;
+  fSnapshotChanged = kFALSE;
+
+  // The files of this run are the snapshot for the next runs in its range
+  fSnapshotLoaded = fSnapshotUsed;
+  fSnapshotLoadedFile = filename;
+  fSnapshotLoadedRange = fSnapshotRunRange;
+  fSnapshotSearchPathTimes = times;
+  return kTRUE;
+}
+
+
 /**
  * Open a file at the specified location
  * @param file Path to file to be opened
@@ -239,6 +560,79 @@ bool QwParameterFile::OpenFile(const fs::path& file)
 }
 
 
+/**
+ * Get the files in a search path that match a stem and extension.  The
+ * directory is listed only once, and again when its modification time
+ * changes; a directory that does not exist is remembered as such until it
+ * appears.  The run labels are parsed once for every stem and extension.
+ * @param directory Directory to search in
+ * @param file_stem File name stem to search for
+ * @param file_ext File name extensions to search for
+ * @return Matching files with their run ranges, or null when the directory
+ *         does not exist
+ */
+const std::vector<QwParameterFile::Candidate>* QwParameterFile::GetCandidates(
+	const fs::path&   directory,
+	const std::string& file_stem,
+	const std::string& file_ext)
+{
+  // List the directory when it is new or has changed
+  std::error_code ec;
+  fs::file_time_type time = fs::last_write_time(directory, ec);
+  Bool_t exists = ! ec;
+  SearchPathIndex& index = fSearchPathIndex[directory.string()];
+  if (! index.fListed || exists != index.fExists || time != index.fTime) {
+    index.fListed = kTRUE;
+    index.fExists = exists;
+    index.fTime = time;
+    index.fFileNames.clear();
+    index.fCandidates.clear();
+    // note: default iterator constructor yields past-the-end
+    fs::directory_iterator end_iterator;
+    for (fs::directory_iterator file_iterator(directory, ec);
+         file_iterator != end_iterator;
+         file_iterator++) {
+      // note: filename() returns only the file name, not the path
+      index.fFileNames.push_back(file_iterator->path().filename().string());
+    }
+    std::sort(index.fFileNames.begin(), index.fFileNames.end());
+  }
+  if (! index.fExists) return 0;
+
+  // Candidates for this stem and extension
+  std::pair<std::string,std::string> key(file_stem, file_ext);
+  auto found = index.fCandidates.find(key);
+  if (found != index.fCandidates.end()) return &found->second;
+  std::vector<Candidate>& candidates = index.fCandidates[key];
+
+  // File names starting with the stem are contiguous in the sorted list
+  for (auto name = std::lower_bound(index.fFileNames.begin(), index.fFileNames.end(), file_stem);
+       name != index.fFileNames.end() && name->compare(0, file_stem.length(), file_stem) == 0;
+       name++) {
+    const std::string& file_name = *name;
+    // extension
+    if (file_name.length() < file_stem.length() + file_ext.length()) continue;
+    size_t pos_ext = file_name.length() - file_ext.length();
+    if (file_name.compare(pos_ext, file_ext.length(), file_ext) != 0) continue;
+
+    Candidate candidate;
+    candidate.fFileName = file_name;
+    candidate.fHasRunLabel = kFALSE;
+    // Determine run label length
+    size_t label_length = pos_ext - file_stem.length();
+    if (label_length > 0) {
+      // run label starts after dot ('.') and that dot is included in the label length;
+      // skip partial matches of the stem
+      if (file_name.at(file_stem.length()) != '.') continue;
+      std::string label = file_name.substr(file_stem.length() + 1, label_length - 1);
+      candidate.fHasRunLabel = kTRUE;
+      candidate.fRunRange = ParseIntRange("-",label);
+    }
+    candidates.push_back(candidate);
+  }
+  return &candidates;
+}
+
 /**
  * Find the file in a directory with highest-scoring run label
  * @param directory Directory to search in
@@ -254,7 +648,9 @@ int QwParameterFile::FindFile(
 	fs::path&         best_path)
 {
   // Return false if the directory does not exist
-  if (! fs::exists(directory)) return false;
+  const std::vector<Candidate>* found = GetCandidates(directory, file_stem, file_ext);
+  if (found == 0) return false;
+  const std::vector<Candidate>& candidates = *found;
 
   // Default score indicates no match found
   int best_score = -1;
@@ -263,22 +659,8 @@ int QwParameterFile::FindFile(
   int open_ended_latest_start = 0;
   int open_ended_range_score = 0;
 
-  // Loop over all files in the directory
-  // note: default iterator constructor yields past-the-end
-  fs::directory_iterator end_iterator;
-  for (fs::directory_iterator file_iterator(directory);
-       file_iterator != end_iterator;
-       file_iterator++) {
-
-    // Match the stem and extension
-    // note: filename() returns only the file name, not the path
-    std::string file_name = file_iterator->path().filename().string();
-    // stem
-    size_t pos_stem = file_name.find(file_stem);
-    if (pos_stem != 0) continue;
-    // extension (reverse find)
-    size_t pos_ext = file_name.rfind(file_ext);
-    if (pos_ext != file_name.length() - file_ext.length()) continue;
+  // Loop over all matching files in the directory
+  for (size_t i = 0; i < candidates.size(); i++) {
 
     // Scores (from low to high)
     const int score_no_run_label = 1;
@@ -295,60 +677,66 @@ int QwParameterFile::FindFile(
     // Single run label will always have maximum score
     const int score_single_run_label = INT_MAX;
 
-    // Determine run label length
-    size_t label_length = pos_ext - file_stem.length();
     // no run label
-    if (label_length == 0) {
+    if (! candidates[i].fHasRunLabel) {
       score = score_no_run_label;
     } else {
-      // run label starts after dot ('.') and that dot is included in the label length
-      if (file_name.at(pos_stem + file_stem.length()) == '.') {
-        std::string label = file_name.substr(pos_stem + file_stem.length() + 1, label_length - 1);
-        std::pair<int,int> range = ParseIntRange("-",label);
-        int run = fCurrentRunNumber;
-        if ((range.first <= run) && (run <= range.second)) {
-
-          // run is in single-value range
-          if (range.first == range.second) {
-            score = score_single_run_label;
-
-          // run is in double-value range
-          } else if (range.second < INT_MAX) {
-            int number_of_runs = abs(range.second - range.first);
-            score = score_closed_run_range_max - number_of_runs;
-            if (score < score_closed_run_range_min) {
-              score = score_closed_run_range_min;
-              QwError << "Too many runs in closed run range for " << file_stem << QwLog::endl;
-              QwWarning << "Range is from " << range.first << " to " << range.second << QwLog::endl;
+      const std::pair<int,int>& range = candidates[i].fRunRange;
+      int run = fCurrentRunNumber;
+      if ((range.first <= run) && (run <= range.second)) {
+
+        // run is in single-value range
+        if (range.first == range.second) {
+          score = score_single_run_label;
+
+        // run is in double-value range
+        } else if (range.second < INT_MAX) {
+          int number_of_runs = abs(range.second - range.first);
+          score = score_closed_run_range_max - number_of_runs;
+          if (score < score_closed_run_range_min) {
+            score = score_closed_run_range_min;
+            QwError << "Too many runs in closed run range for " << file_stem << QwLog::endl;
+            QwWarning << "Range is from " << range.first << " to " << range.second << QwLog::endl;
+          }
+
+        // run is in open-ended range
+        } else if (range.second == INT_MAX) {
+          // each matching open-ended range
+          if (range.first > open_ended_latest_start) {
+            open_ended_latest_start = range.first;
+            open_ended_range_score++;
+            score = score_open_ended_run_range_min + open_ended_range_score;
+            if (score > score_open_ended_run_range_max) {
+              score = score_open_ended_run_range_max;
+              QwError << "Too many open ended run ranges for " << file_stem << QwLog::endl;
             }
 
-          // run is in open-ended range
-          } else if (range.second == INT_MAX) {
-            // each matching open-ended range
-            if (range.first > open_ended_latest_start) {
-              open_ended_latest_start = range.first;
-              open_ended_range_score++;
-              score = score_open_ended_run_range_min + open_ended_range_score;
-              if (score > score_open_ended_run_range_max) {
-                score = score_open_ended_run_range_max;
-                QwError << "Too many open ended run ranges for " << file_stem << QwLog::endl;
-              }
-
-            } else score = score_open_ended_run_range_min;
-          }
-        } else
-          // run not in range
-          score = -1;
+          } else score = score_open_ended_run_range_min;
+        }
       } else
-	// run label does not start with a dot (i.e. partial match of stem)
-	score = -1;
+        // run not in range
+        score = -1;
     }
 
     // Look for the match with highest score
     if (score > best_score) {
-      best_path = *file_iterator;
+      best_path = directory / candidates[i].fFileName;
       best_score = score;
     }
+
+    // Runs for which the same candidates match (for the configuration snapshot)
+    if (candidates[i].fHasRunLabel) {
+      const std::pair<int,int>& range = candidates[i].fRunRange;
+      int run = fCurrentRunNumber;
+      if (run < range.first)
+        fSnapshotRunRange.second = std::min(fSnapshotRunRange.second, range.first - 1);
+      else if (run > range.second)
+        fSnapshotRunRange.first = std::max(fSnapshotRunRange.first, range.second + 1);
+      else {
+        fSnapshotRunRange.first = std::max(fSnapshotRunRange.first, range.first);
+        fSnapshotRunRange.second = std::min(fSnapshotRunRange.second, range.second);
+      }
+    }
   }
   return best_score;
 }
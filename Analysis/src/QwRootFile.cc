@@ -5,7 +5,10 @@
 
 #include "QwRootFile.h"
 #include "QwRunCondition.h"
+#include "QwSharedMemoryWriter.h"
 #include "TH1.h"
+#include "TBranch.h"
+#include "TLeaf.h"
 
 #include <unistd.h>
 #include <cstdio>
@@ -22,13 +25,130 @@ const Int_t QwRootFile::kMaxMapFileSize = 0x3fffffff; // 1 GiB
 const TString QwRootTree::kUnitsName = "ppm/D:ppb/D:um/D:mm/D:mV_uA/D:V_uA/D";
 Double_t QwRootTree::kUnitsValue[] = { 1e-6, 1e-9, 1e-3, 1 , 1e-3, 1};
 
+/**
+ * List the leaves of this object that are stored in its branch vector
+ * @param names   Leaf names, as "branch.leaf" for leaflist branches
+ * @param offsets Offsets of the leaves in the branch vector
+ * @param types   Leaf type codes
+ */
+void QwRootTree::GetColumns(std::vector<std::string>& names,
+                            std::vector<size_t>& offsets,
+                            std::vector<char>& types) const
+{
+  const char* begin = static_cast<const char*>(fVector.data());
+  const char* end = begin + fVector.data_size();
+
+  // Columns stored as floats are published from their double source
+  std::map<const char*, const char*> sources;
+  for (size_t i = 0; i < fFloatColumns.size(); i++)
+    sources[reinterpret_cast<const char*>(fFloatColumns[i].second)] =
+        reinterpret_cast<const char*>(fFloatColumns[i].first);
+
+  TIter next(fTree->GetListOfBranches());
+  while (TBranch* branch = static_cast<TBranch*>(next())) {
+    TObjArray* leaves = branch->GetListOfLeaves();
+    for (Int_t l = 0; l < leaves->GetEntriesFast(); l++) {
+      TLeaf* leaf = static_cast<TLeaf*>(leaves->At(l));
+      if (leaf->GetLen() != 1 || leaf->GetLeafCount() != 0) continue;
+      const char* address = branch->GetAddress() + leaf->GetOffset();
+      TString type = leaf->GetTypeName();
+      if (sources.count(address) > 0) {
+        address = sources[address];
+        type = "Double_t";
+      }
+      if (address < begin || address >= end) continue;
+
+      char code = 0;
+      if      (type == "Double_t")  code = 'D';
+      else if (type == "Float_t")   code = 'F';
+      else if (type == "Int_t")     code = 'I';
+      else if (type == "UInt_t")    code = 'i';
+      else if (type == "Long64_t")  code = 'L';
+      else if (type == "ULong64_t") code = 'l';
+      else if (type == "Short_t")   code = 'S';
+      else if (type == "UShort_t")  code = 's';
+      else continue;
+
+      TString name = branch->GetName();
+      if (leaves->GetEntriesFast() > 1) name += TString(".") + leaf->GetName();
+      names.push_back(name.Data());
+      offsets.push_back(address - begin);
+      types.push_back(code);
+    }
+  }
+}
+
+/**
+ * Construct one branch on this tree for every leaf of the leaflist branches
+ * on a scratch tree.  The new branches point at the same addresses as the
+ * leaves, except for the double leaves of asym_ and diff_ branches in
+ * kSplitFloatColumns mode, which are copied to float storage when the
+ * tree vector is filled.  Branches with array leaves are kept as they are.
+ * @param scratch Tree with the branches constructed by the object
+ */
+void QwRootTree::ConstructColumnBranches(TTree* scratch)
+{
+  TIter next(scratch->GetListOfBranches());
+  while (TBranch* branch = static_cast<TBranch*>(next())) {
+    TString branchname = branch->GetName();
+    TObjArray* leaves = branch->GetListOfLeaves();
+    Int_t nleaves = leaves->GetEntriesFast();
+
+    // Leaf types from the leaflist "name/T:name/T:..."
+    std::vector<TString> leaflist;
+    std::stringstream stream(branch->GetTitle());
+    std::string item;
+    while (std::getline(stream, item, ':')) leaflist.push_back(item.c_str());
+
+    Bool_t split = (nleaves > 1 && Int_t(leaflist.size()) == nleaves);
+    for (Int_t l = 0; split && l < nleaves; l++) {
+      TLeaf* leaf = static_cast<TLeaf*>(leaves->At(l));
+      split = (leaf->GetLen() == 1 && leaf->GetLeafCount() == 0
+               && leaflist[l].Index("/") != kNPOS);
+    }
+    Bool_t tofloat = (fColumnMode == kSplitFloatColumns
+                      && (branchname.BeginsWith("asym_") || branchname.BeginsWith("diff_")));
+
+    // Single leaves and array leaves keep their branch, except for float storage
+    if (! split) {
+      TLeaf* leaf = static_cast<TLeaf*>(leaves->At(0));
+      if (nleaves == 1 && tofloat && TString(leaf->GetTypeName()) == "Double_t"
+          && leaf->GetLen() == 1 && leaf->GetLeafCount() == 0) {
+        fFloatStorage.push_back(0.0);
+        fFloatColumns.push_back(std::make_pair(
+            reinterpret_cast<const Double_t*>(branch->GetAddress()), &fFloatStorage.back()));
+        fTree->Branch(branchname, &fFloatStorage.back(), TString(leaf->GetName()) + "/F");
+      } else {
+        fTree->Branch(branchname, branch->GetAddress(), branch->GetTitle());
+      }
+      continue;
+    }
+
+    for (Int_t l = 0; l < nleaves; l++) {
+      TLeaf* leaf = static_cast<TLeaf*>(leaves->At(l));
+      TString name = branchname + "." + leaf->GetName();
+      TString type = leaflist[l](leaflist[l].Last('/') + 1, leaflist[l].Length());
+      char* address = branch->GetAddress() + leaf->GetOffset();
+      if (tofloat && type == "D") {
+        fFloatStorage.push_back(0.0);
+        fFloatColumns.push_back(std::make_pair(
+            reinterpret_cast<const Double_t*>(address), &fFloatStorage.back()));
+        fTree->Branch(name, &fFloatStorage.back(), name + "/F");
+      } else {
+        fTree->Branch(name, address, name + "/" + type);
+      }
+    }
+  }
+}
+
 /**
  * Constructor with relative filename
  */
 QwRootFile::QwRootFile(const TString& run_label)
   : fRootFile(0), fMakePermanent(0),
     fMapFile(0), fEnableMapFile(kFALSE),
-    fUpdateInterval(-1)
+    fUpdateInterval(-1), fSharedMemory(0),
+    fSplitTreeFloats(kFALSE)
 #ifdef HAS_RNTUPLE_SUPPORT
     , fEnableRNTuples(kFALSE)
 #endif // HAS_RNTUPLE_SUPPORT
@@ -198,6 +318,69 @@ QwRootFile::~QwRootFile()
   }
 }
 
+/**
+ * Create the shared-memory writer requested with --enable-shmem.  There is
+ * one region per name, so the caller creates one writer for all the files
+ * of a run and passes it to each of them with SetSharedMemoryWriter.
+ * @param run_label Run label, stored in the region header
+ * @return New writer owned by the caller, or null when not requested
+ */
+QwSharedMemoryWriter* QwRootFile::CreateSharedMemoryWriter(const TString& run_label)
+{
+  if (! gQwOptions.GetValue<bool>("enable-shmem")) return 0;
+  if (gQwOptions.GetValue<bool>("enable-mapfile")) {
+    QwWarning << "Shared-memory output is not available with a memory-mapped file"
+              << QwLog::endl;
+    return 0;
+  }
+  QwSharedMemoryWriter* writer =
+    new QwSharedMemoryWriter(gQwOptions.GetValue<std::string>("shmem-name"),
+                             gQwOptions.GetValue<int>("shmem-ring-size"));
+  writer->SetRunNumber(run_label.Atoi());
+  writer->SetUpdateInterval(gQwOptions.GetValue<int>("shmem-update-interval"));
+  return writer;
+}
+
+/**
+ * Publish the histograms and trees of this file that are constructed from
+ * now on in the shared-memory region of a writer.  The writer must stay
+ * alive until this file is closed.
+ * @param writer Shared-memory writer, or null to stop publishing
+ */
+void QwRootFile::SetSharedMemoryWriter(QwSharedMemoryWriter* writer)
+{
+  fSharedMemory = writer;
+}
+
+void QwRootFile::AddSharedMemoryHistograms(TDirectory* dir, const std::string& name)
+{
+  fSharedMemory->AddHistograms(dir, name);
+}
+
+void QwRootFile::AddSharedMemoryRing(const QwRootTree* tree, const std::string& name)
+{
+  std::vector<std::string> names;
+  std::vector<size_t> offsets;
+  std::vector<char> types;
+  tree->GetColumns(names, offsets, types);
+  fRingByTree[tree] = fSharedMemory->AddRing(name,
+      tree->fVector.data(), tree->fVector.data_size(), names, offsets, types);
+}
+
+void QwRootFile::SharedMemoryHistogramsFilled()
+{
+  fSharedMemory->HistogramsFilled();
+}
+
+void QwRootFile::PublishTreeEntries(const std::string& name)
+{
+  std::vector<QwRootTree*>& trees = fTreeByName[name];
+  for (size_t i = 0; i < trees.size(); i++) {
+    std::map<const QwRootTree*, Int_t>::const_iterator ring = fRingByTree.find(trees[i]);
+    if (ring != fRingByTree.end()) fSharedMemory->PublishEntry(ring->second);
+  }
+}
+
 /**
  * Defines configuration options using QwOptions functionality.
  * @param options Options object
@@ -218,6 +401,18 @@ void QwRootFile::DefineOptions(QwOptions &options)
   options.AddOptions()
     ("enable-mapfile", po::value<bool>()->default_bool_value(false),
      "enable output to memory-mapped file\n(likely requires circular-buffer too)");
+  options.AddOptions()
+    ("enable-shmem", po::value<bool>()->default_bool_value(false),
+     "publish histograms and recent tree entries in shared memory");
+  options.AddOptions()
+    ("shmem-name", po::value<std::string>()->default_value("/QwLive"),
+     "name of the shared-memory region");
+  options.AddOptions()
+    ("shmem-ring-size", po::value<int>()->default_value(256),
+     "number of recent entries of each tree in shared memory");
+  options.AddOptions()
+    ("shmem-update-interval", po::value<int>()->default_value(100),
+     "histogram fills between shared-memory updates");
   options.AddOptions()
     ("write-temporary-rootfiles", po::value<bool>()->default_bool_value(true),
      "When writing ROOT files, use the PID to create a temporary filename");
@@ -250,6 +445,17 @@ void QwRootFile::DefineOptions(QwOptions &options)
     ("disable-slow-tree", po::value<bool>()->default_bool_value(false),
      "disable slow control tree");
 
+  // Define the column-per-leaf output options
+  options.AddOptions("ROOT output options")
+    ("split-tree", po::value<std::vector<std::string>>()->composing(),
+     "write one branch per leaf in trees matching regex");
+  options.AddOptions("ROOT output options")
+    ("split-trees", po::value<bool>()->default_bool_value(false),
+     "write one branch per leaf in the mul, pr and burst trees");
+  options.AddOptions("ROOT output options")
+    ("split-tree-floats", po::value<bool>()->default_bool_value(false),
+     "store the asym_ and diff_ leaves of split trees as floats");
+
 #ifdef HAS_RNTUPLE_SUPPORT
   // Define the RNTuple options
   options.AddOptions("ROOT output options")
@@ -359,6 +565,12 @@ void QwRootFile::ProcessOptions(QwOptions &options)
   if (options.GetValue<bool>("disable-trees"))  DisableTree(".*");
   if (options.GetValue<bool>("disable-histos")) DisableHisto(".*");
 
+  // Options 'split-tree' and 'split-trees' for column-per-leaf output
+  auto w = options.GetValueVector<std::string>("split-tree");
+  std::for_each(w.begin(), w.end(), [&](const std::string& s){ this->SplitTree(s); });
+  if (options.GetValue<bool>("split-trees")) SplitTree("^(mul|pr|burst)$");
+  fSplitTreeFloats = options.GetValue<bool>("split-tree-floats");
+
   // Read --circular-buffer up front so the mapfile-mode logic below can use
   // it (the original ProcessOptions read it further down, but we now need
   // it during the mapfile-tree decision).
@@ -76,6 +76,17 @@ void VQwScaler_Channel::ClearEventData()
   fErrorFlag = 0;
 }
 
+/**
+ * Clear the event data, the previous reading of a differential scaler and
+ * the event cut counter of the run.
+ */
+void VQwScaler_Channel::ClearRunState()
+{
+  ClearEventData();
+  fValue_Raw_Old = 0;
+  fNumEvtsWithEventCutsRejected = 0;
+}
+
 void VQwScaler_Channel::RandomizeEventData(int helicity, double time)
 {
   // Calculate drift (if time is not specified, it stays constant at zero)
@@ -161,6 +172,26 @@ void QwScaler_Channel<data_mask,data_shift>::EncodeEventData(std::vector<UInt_t>
 }
 
 
+/**
+ * Set the header and raw count of this channel from a scaler word that
+ * was already split by the caller (e.g. QwScaler decoding a whole bank),
+ * and calculate the value.
+ * @param header    Bits of the scaler word outside the data mask
+ * @param value_raw Raw count
+ */
+void VQwScaler_Channel::SetRawWord(UInt_t header, UInt_t value_raw)
+{
+  fHeader    = header;
+  fValue_Raw = value_raw;
+  fValue     = fCalibrationFactor * (Double_t(fValue_Raw) - Double_t(fValue_Raw_Old) - fPedestal);
+
+  // Store old raw value for differential scalers
+  if (IsDifferentialScaler())
+    fValue_Raw_Old = fValue_Raw;
+  else
+    fValue_Raw_Old = 0;
+}
+
 template<unsigned int data_mask, unsigned int data_shift>
 Int_t QwScaler_Channel<data_mask,data_shift>::ProcessEvBuffer(UInt_t* buffer, UInt_t num_words_left,
 							      UInt_t index)
@@ -171,17 +202,8 @@ Int_t QwScaler_Channel<data_mask,data_shift>::ProcessEvBuffer(UInt_t* buffer, UI
     //  Skip over this data.
       words_read = fNumberOfDataWords;
   } else if (num_words_left >= fNumberOfDataWords) {
-    fHeader    = (buffer[0] & ~data_mask);
-    fValue_Raw = ((buffer[0] & data_mask) >> data_shift);
-    fValue     = fCalibrationFactor * (Double_t(fValue_Raw) - Double_t(fValue_Raw_Old) - fPedestal);
+    SetRawWord(buffer[0] & ~data_mask, (buffer[0] & data_mask) >> data_shift);
     words_read = fNumberOfDataWords;
-
-    // Store old raw value for differential scalers
-    if (IsDifferentialScaler())
-      fValue_Raw_Old = fValue_Raw;
-    else
-      fValue_Raw_Old = 0;
-
   } else {
     //QwError << "QwScaler_Channel::ProcessEvBuffer: Not enough words!"<< QwLog::endl;
   }
@@ -508,6 +530,31 @@ VQwScaler_Channel& VQwScaler_Channel::operator=(const VQwScaler_Channel &value)
   return *this;
 }
 
+/// Packs the same event data as operator= copies
+void VQwScaler_Channel::PackEventData(std::vector<char>& record) const
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::PackEventData(record);
+    PackValue(record, fHeader);
+    PackValue(record, fValue_Raw);
+    PackValue(record, fValue);
+    PackValue(record, fValueError);
+    PackValue(record, fValueM2);
+  }
+}
+
+void VQwScaler_Channel::UnpackEventData(const char*& record)
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::UnpackEventData(record);
+    UnpackValue(record, fHeader);
+    UnpackValue(record, fValue_Raw);
+    UnpackValue(record, fValue);
+    UnpackValue(record, fValueError);
+    UnpackValue(record, fValueM2);
+  }
+}
+
 void VQwScaler_Channel::AssignScaledValue(const VQwScaler_Channel &value,
 				    Double_t scale)
 {
@@ -0,0 +1,267 @@
+/*!
+ * \file   QwSharedMemoryWriter.cc
+ * \brief  Publication of live histograms and tree entries in shared memory
+ */
+
+#include "QwSharedMemoryWriter.h"
+
+// System headers
+#include <cerrno>
+
+// ROOT headers
+#include "TH1.h"
+#include "TDirectory.h"
+#include "TList.h"
+#include "TKey.h"
+
+// Qweak headers
+#include "QwLog.h"
+
+using namespace QwSharedMemory;
+
+/// Round a size up to a multiple of 8 bytes
+static size_t Align8(size_t size) { return (size + 7) & ~size_t(7); }
+
+/// Number of bin edges stored for a histogram
+static size_t NumberOfEdges(const TH1* histo)
+{
+  size_t n = histo->GetXaxis()->GetNbins() + 1;
+  if (histo->GetDimension() == 2) n += histo->GetYaxis()->GetNbins() + 1;
+  return n;
+}
+
+/**
+ * Create a writer; the region is only created at the first publication
+ * @param name     Name of the region (as for shm_open, e.g. "/QwLive")
+ * @param ringsize Number of recent entries kept per tree object
+ */
+QwSharedMemoryWriter::QwSharedMemoryWriter(const std::string& name, UInt_t ringsize)
+: fName(name), fRingSize(ringsize > 0? ringsize: 1), fRunNumber(0),
+  fUpdateInterval(0), fFills(0), fBase(0), fSize(0), fFailed(kFALSE)
+{
+  if (fName.empty() || fName[0] != '/') fName = "/" + fName;
+}
+
+/**
+ * Unmap the region; it stays available to consumers until the next
+ * writer with the same name replaces it
+ */
+QwSharedMemoryWriter::~QwSharedMemoryWriter()
+{
+  if (fBase) munmap(fBase, fSize);
+}
+
+/**
+ * Register all histograms in a directory, recursively
+ * @param dir  Directory with histograms
+ * @param path Path of the directory, used as prefix of the histogram names
+ */
+void QwSharedMemoryWriter::AddHistograms(TDirectory* dir, const std::string& path)
+{
+  if (dir == 0) return;
+  if (fBase) {
+    QwWarning << "Shared memory region " << fName << " already created; "
+              << "histograms in " << path << " are not published" << QwLog::endl;
+    return;
+  }
+  TIter next(dir->GetList());
+  while (TObject* obj = next()) {
+    std::string name = path + "/" + obj->GetName();
+    if (TH1* histo = dynamic_cast<TH1*>(obj)) {
+      if (histo->GetDimension() <= 2 && fRegistered.insert(histo).second)
+        fHistograms.push_back(std::make_pair(name, histo));
+    } else if (TDirectory* subdir = dynamic_cast<TDirectory*>(obj)) {
+      AddHistograms(subdir, name);
+    }
+  }
+}
+
+/**
+ * Register a tree object
+ * @param name    Name of the ring
+ * @param data    Branch vector of the object
+ * @param size    Size of the branch vector
+ * @param names   Column names
+ * @param offsets Column offsets in the branch vector
+ * @param types   Column leaf type codes
+ * @return Index of the ring, or -1 when the region already exists
+ */
+Int_t QwSharedMemoryWriter::AddRing(const std::string& name, const void* data, size_t size,
+                                    const std::vector<std::string>& names,
+                                    const std::vector<size_t>& offsets,
+                                    const std::vector<char>& types)
+{
+  if (fBase) {
+    QwWarning << "Shared memory region " << fName << " already created; "
+              << "tree " << name << " is not published" << QwLog::endl;
+    return -1;
+  }
+  Source source;
+  source.fName = name;
+  source.fData = static_cast<const char*>(data);
+  source.fSize = size;
+  for (size_t c = 0; c < names.size(); c++) {
+    Column column;
+    std::memset(&column, 0, sizeof(column));
+    SetName(column.fName, names[c]);
+    column.fOffset = offsets[c];
+    column.fType = types[c];
+    source.fColumns.push_back(column);
+  }
+  fSources.push_back(source);
+  return fSources.size() - 1;
+}
+
+/**
+ * Lay out the region for the registered histograms and tree objects,
+ * create it and write all records
+ * @return True when the region is mapped
+ */
+Bool_t QwSharedMemoryWriter::Create()
+{
+  if (fBase) return kTRUE;
+  if (fFailed) return kFALSE;
+
+  // Layout
+  size_t histooffset = Align8(sizeof(Header));
+  size_t ringoffset = histooffset + fHistograms.size() * sizeof(Histogram);
+  size_t columnoffset = ringoffset + fSources.size() * sizeof(Ring);
+  size_t celloffset = columnoffset;
+  for (size_t r = 0; r < fSources.size(); r++)
+    celloffset += fSources[r].fColumns.size() * sizeof(Column);
+  size_t edgeoffset = celloffset;
+  for (size_t h = 0; h < fHistograms.size(); h++)
+    edgeoffset += fHistograms[h].second->GetNcells() * sizeof(double);
+  size_t slotoffset = edgeoffset;
+  for (size_t h = 0; h < fHistograms.size(); h++)
+    slotoffset += NumberOfEdges(fHistograms[h].second) * sizeof(double);
+  size_t size = slotoffset;
+  for (size_t r = 0; r < fSources.size(); r++)
+    size += fRingSize * SlotSize(Align8(fSources[r].fSize));
+
+  // Create and map the region
+  shm_unlink(fName.c_str());
+  int fd = shm_open(fName.c_str(), O_CREAT | O_RDWR | O_EXCL, 0644);
+  if (fd < 0 || ftruncate(fd, size) != 0) {
+    QwError << "Shared memory region " << fName << " could not be created: "
+            << std::strerror(errno) << QwLog::endl;
+    if (fd >= 0) close(fd);
+    fFailed = kTRUE;
+    return kFALSE;
+  }
+  void* base = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    QwError << "Shared memory region " << fName << " could not be mapped: "
+            << std::strerror(errno) << QwLog::endl;
+    shm_unlink(fName.c_str());
+    fFailed = kTRUE;
+    return kFALSE;
+  }
+  fBase = static_cast<char*>(base);
+  fSize = size;
+  std::memset(fBase, 0, fSize);
+
+  // Histogram records
+  Histogram* histos = reinterpret_cast<Histogram*>(fBase + histooffset);
+  for (size_t h = 0; h < fHistograms.size(); h++) {
+    TH1* histo = fHistograms[h].second;
+    SetName(histos[h].fName, fHistograms[h].first);
+    SetName(histos[h].fTitle, histo->GetTitle());
+    histos[h].fDimension = histo->GetDimension();
+    histos[h].fNbinsX = histo->GetXaxis()->GetNbins();
+    histos[h].fXmin = histo->GetXaxis()->GetXmin();
+    histos[h].fXmax = histo->GetXaxis()->GetXmax();
+    histos[h].fNbinsY = histo->GetYaxis()->GetNbins();
+    histos[h].fYmin = histo->GetYaxis()->GetXmin();
+    histos[h].fYmax = histo->GetYaxis()->GetXmax();
+    histos[h].fCellOffset = celloffset;
+    histos[h].fNumberOfCells = histo->GetNcells();
+    celloffset += histo->GetNcells() * sizeof(double);
+    histos[h].fEdgeOffset = edgeoffset;
+    double* edges = reinterpret_cast<double*>(fBase + edgeoffset);
+    const TAxis* axis = histo->GetXaxis();
+    for (Int_t bin = 1; bin <= axis->GetNbins() + 1; bin++)
+      *edges++ = axis->GetBinLowEdge(bin);
+    if (histos[h].fDimension == 2) {
+      axis = histo->GetYaxis();
+      for (Int_t bin = 1; bin <= axis->GetNbins() + 1; bin++)
+        *edges++ = axis->GetBinLowEdge(bin);
+    }
+    edgeoffset += NumberOfEdges(histo) * sizeof(double);
+  }
+
+  // Ring and column records
+  Ring* rings = reinterpret_cast<Ring*>(fBase + ringoffset);
+  for (size_t r = 0; r < fSources.size(); r++) {
+    const Source& source = fSources[r];
+    SetName(rings[r].fName, source.fName);
+    rings[r].fNumberOfColumns = source.fColumns.size();
+    rings[r].fCapacity = fRingSize;
+    rings[r].fEntrySize = Align8(source.fSize);
+    rings[r].fColumnOffset = columnoffset;
+    rings[r].fSlotOffset = slotoffset;
+    std::memcpy(fBase + columnoffset, source.fColumns.data(),
+                source.fColumns.size() * sizeof(Column));
+    columnoffset += source.fColumns.size() * sizeof(Column);
+    slotoffset += fRingSize * SlotSize(rings[r].fEntrySize);
+  }
+
+  // Header, with the magic number last so that consumers see a complete region
+  Header* header = reinterpret_cast<Header*>(fBase);
+  header->fVersion = kVersion;
+  header->fSize = fSize;
+  header->fNumberOfHistograms = fHistograms.size();
+  header->fNumberOfRings = fSources.size();
+  header->fHistogramOffset = histooffset;
+  header->fRingOffset = ringoffset;
+  header->fRunNumber = fRunNumber;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->fMagic = kMagic;
+
+  QwMessage << "Created shared memory region " << fName << " with "
+            << fHistograms.size() << " histograms and " << fSources.size()
+            << " trees (" << fSize / 1024 << " kiB)" << QwLog::endl;
+  return kTRUE;
+}
+
+/**
+ * Copy the bins of all registered histograms into the region
+ */
+void QwSharedMemoryWriter::PublishHistograms()
+{
+  if (! Create()) return;
+  Header* header = reinterpret_cast<Header*>(fBase);
+  Histogram* histos = reinterpret_cast<Histogram*>(fBase + header->fHistogramOffset);
+  for (size_t h = 0; h < fHistograms.size(); h++) {
+    TH1* histo = fHistograms[h].second;
+    double* cells = reinterpret_cast<double*>(fBase + histos[h].fCellOffset);
+    uint64_t sequence = histos[h].fSequence.load(std::memory_order_relaxed);
+    histos[h].fSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (uint64_t i = 0; i < histos[h].fNumberOfCells; i++)
+      cells[i] = histo->GetBinContent(i);
+    histos[h].fEntries = histo->GetEntries();
+    histos[h].fSequence.store(sequence + 2, std::memory_order_release);
+  }
+  header->fUpdates.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Append the current branch vector of a tree object to its ring
+ * @param ring Index of the ring returned by AddRing
+ */
+void QwSharedMemoryWriter::PublishEntry(Int_t ring)
+{
+  if (ring < 0 || size_t(ring) >= fSources.size() || ! Create()) return;
+  Header* header = reinterpret_cast<Header*>(fBase);
+  Ring& record = reinterpret_cast<Ring*>(fBase + header->fRingOffset)[ring];
+  uint64_t n = record.fHead.load(std::memory_order_relaxed);
+  char* slot = fBase + record.fSlotOffset + (n % record.fCapacity) * SlotSize(record.fEntrySize);
+  Slot* slotheader = reinterpret_cast<Slot*>(slot);
+  slotheader->fSequence.store(2 * n + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(slot + sizeof(Slot), fSources[ring].fData, fSources[ring].fSize);
+  slotheader->fSequence.store(2 * n + 2, std::memory_order_release);
+  record.fHead.store(n + 1, std::memory_order_release);
+}
@@ -6,13 +6,37 @@
 #include "QwSubsystemArray.h"
 
 // System headers
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <stdexcept>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 // Qweak headers
 #include "VQwHardwareChannel.h"
 #include "QwLog.h"
 #include "QwParameterFile.h"
 #include "QwRootFile.h"
+#include "QwWorkerPool.h"
+
+//*****************************************************************
+
+Bool_t QwSubsystemArray::fMemoryReport = kFALSE;
+
+/// Bytes currently allocated on the heap, or zero when this is not known
+static size_t GetHeapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
 
 //*****************************************************************
 
@@ -28,6 +52,96 @@ QwSubsystemArray::QwSubsystemArray(QwOptions& options, CanContainFn myCanContain
   LoadSubsystemsFromParameterFile(detectors);
 }
 
+/**
+ * Destructor, which releases the accounted heap footprint of the copies
+ */
+QwSubsystemArray::~QwSubsystemArray()
+{
+  ReleaseMemoryUsage();
+}
+
+/**
+ * Release all subsystems, for arrays which a copy of an object never
+ * uses (e.g. the pair arrays of a helicity pattern running sum)
+ */
+void QwSubsystemArray::ReleaseSubsystems()
+{
+  ReleaseMemoryUsage();
+  SubsysPtrs::clear();
+}
+
+/**
+ * Remove the copies in this array from the heap footprint accounting
+ */
+void QwSubsystemArray::ReleaseMemoryUsage()
+{
+  if (fCopyBytes.size() == size()) {
+    for (size_t i = 0; i < fCopyBytes.size(); i++) {
+      if (at(i) == nullptr) continue;
+      MemoryUsage& usage = GetMemoryUsage()[std::string(at(i)->GetName().Data())
+                                            + " (" + at(i)->GetClassName() + ")"];
+      usage.fLive--;
+      usage.fLiveBytes -= fCopyBytes[i];
+    }
+  }
+  fCopyBytes.clear();
+}
+
+/**
+ * Heap footprint of the subsystem copies, by subsystem name and class.
+ * The registry is never destroyed, so that arrays with static storage
+ * duration may still release their copies at exit.
+ * @return Registry of copies
+ */
+std::map<std::string, QwSubsystemArray::MemoryUsage>& QwSubsystemArray::GetMemoryUsage()
+{
+  static std::map<std::string, MemoryUsage>* usage = new std::map<std::string, MemoryUsage>;
+  return *usage;
+}
+
+/**
+ * Print the heap footprint of the subsystem copies made by the copy
+ * constructor: every ring slot, pattern phase, running sum and helicity
+ * pattern member holds one copy of each subsystem.
+ */
+void QwSubsystemArray::PrintMemoryReport()
+{
+  if (! fMemoryReport) return;
+  if (GetHeapInUse() == 0) {
+    QwWarning << "Heap usage is not available on this platform; "
+              << "no memory report" << QwLog::endl;
+    return;
+  }
+  size_t total = 0;
+  QwMessage << " ------------ memory report ------------------- " << QwLog::endl;
+  QwMessage << std::setw(40) << std::left << "subsystem (class)" << std::right
+            << std::setw(8)  << "copies"
+            << std::setw(8)  << "live"
+            << std::setw(14) << "bytes/copy"
+            << std::setw(12) << "live [MB]"
+            << std::setw(12) << "peak [MB]" << QwLog::endl;
+  for (const auto& entry: GetMemoryUsage()) {
+    const MemoryUsage& usage = entry.second;
+    QwMessage << std::setw(40) << std::left << entry.first << std::right
+              << std::setw(8)  << usage.fCopies
+              << std::setw(8)  << usage.fLive
+              << std::setw(14) << usage.fBytes
+              << std::setw(12) << std::fixed << std::setprecision(1) << usage.fLiveBytes / 1048576.0
+              << std::setw(12) << usage.fPeakBytes / 1048576.0 << QwLog::endl;
+    total += usage.fLiveBytes;
+  }
+  QwMessage << "Subsystem copies hold " << std::setprecision(1)
+            << total / 1048576.0 << " MB of the heap" << QwLog::endl;
+
+  // Resident set size of the process
+  std::ifstream statm("/proc/self/statm");
+  size_t pages = 0, resident = 0;
+  if (statm >> pages >> resident) {
+    QwMessage << "Resident set size is " << std::setprecision(1)
+              << resident * sysconf(_SC_PAGESIZE) / 1048576.0 << " MB" << QwLog::endl;
+  }
+}
+
 /**
  * Copy constructor by reference
  * @param source Source subsystem array
@@ -52,7 +166,21 @@ QwSubsystemArray::QwSubsystemArray(const QwSubsystemArray& source)
 
   // Make copies of all subsystems rather than copying just the pointers
   for (const_iterator subsys = source.begin(); subsys != source.end(); ++subsys) {
+    size_t before = fMemoryReport? GetHeapInUse(): 0;
     this->push_back(subsys->get()->Clone());
+    if (fMemoryReport) {
+      // Heap growth of the copy, including the subsystem object itself
+      size_t after = GetHeapInUse();
+      size_t bytes = (after > before)? after - before: 0;
+      fCopyBytes.push_back(bytes);
+      MemoryUsage& usage = GetMemoryUsage()[std::string(this->back()->GetName().Data())
+                                            + " (" + this->back()->GetClassName() + ")"];
+      usage.fCopies++;
+      usage.fLive++;
+      usage.fBytes = bytes;
+      usage.fLiveBytes += bytes;
+      usage.fPeakBytes = std::max(usage.fPeakBytes, usage.fLiveBytes);
+    }
     // Instruct the subsystem to publish variables
     if (this->back()->PublishInternalValues() == kFALSE) {
       QwError << "Not all variables for " << this->back()->GetName()
@@ -187,6 +315,9 @@ void QwSubsystemArray::LoadSubsystemsFromParameterFile(QwParameterFile& detector
               << " could be published!" << QwLog::endl;
     }
   }
+
+  // Bind the exchanged data, now that all subsystems have published
+  std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::BindExternalValues));
 }
 
 //*****************************************************************
@@ -250,6 +381,27 @@ void QwSubsystemArray::DefineOptions(QwOptions &options)
   options.AddOptions()("disable-by-name",
                        po::value<std::vector <std::string> >()->multitoken(),
                        "subsystem names to disable");
+
+  options.AddOptions()("verify-bank-decoders",
+                       po::value<bool>()->default_bool_value(false),
+                       "compare the bulk ADC18, MollerADC and scaler bank decoders with the per-channel decoders");
+  options.AddOptions()("fused-bpm-kernel",
+                       po::value<bool>()->default_bool_value(true),
+                       "compute the stripline BPM positions in one pass over the packed wire values");
+  options.AddOptions()("verify-bpm-kernel",
+                       po::value<bool>()->default_bool_value(false),
+                       "compare the fused stripline BPM kernel with the channel arithmetic, bit for bit");
+  options.AddOptions()("lazy-derived-devices",
+                       po::value<bool>()->default_bool_value(false),
+                       "skip the beamline combined BCMs, combined BPMs and energy calculators which no tree, histogram, cut or handler reads (other derived quantities are always computed)");
+
+  options.AddOptions()("parallel-subsystems",
+                       po::value<int>()->default_value(0),
+                       "number of threads for the event processing stages of the subsystems (0 for serial)");
+
+  options.AddOptions()("memory-report",
+                       po::value<bool>()->default_bool_value(false),
+                       "account for the heap footprint of subsystem copies and print it at the end of the run");
 }
 
 
@@ -265,6 +417,13 @@ void QwSubsystemArray::ProcessOptionsToplevel(QwOptions &options)
   // Subsystems to disable
   fSubsystemsDisabledByName = options.GetValueVector<std::string>("disable-by-name");
   fSubsystemsDisabledByType = options.GetValueVector<std::string>("disable-by-type");
+  // Threads for parallel event processing
+  fMemoryReport = options.GetValue<bool>("memory-report");
+  int nthreads = options.GetValue<int>("parallel-subsystems");
+  if (nthreads > 1) {
+    fWorkerPool = std::make_shared<QwWorkerPool>(nthreads);
+    QwMessage << "Processing subsystems on " << nthreads << " threads" << QwLog::endl;
+  }
 }
 
 
@@ -415,9 +574,50 @@ Int_t QwSubsystemArray::ProcessEvBuffer(
 void  QwSubsystemArray::ProcessEvent()
 {
   if (!empty() && HasDataLoaded()) {
-    std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ProcessEvent));
-    std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ExchangeProcessedData));
-    std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ProcessEvent_2));
+    if (fWorkerPool) {
+      ProcessEventStage(&VQwSubsystem::ProcessEvent);
+      // The exchange fills the publish map and the external pointers
+      std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ExchangeProcessedData));
+      ProcessEventStage(&VQwSubsystem::ProcessEvent_2);
+    } else {
+      std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ProcessEvent));
+      std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ExchangeProcessedData));
+      std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ProcessEvent_2));
+    }
+  }
+}
+
+/**
+ * Run one event processing stage on all subsystems, in the order of the
+ * array: each run of consecutive thread-safe subsystems is processed
+ * concurrently on the worker pool and completed before the next subsystem,
+ * and the other subsystems are processed on the calling thread.  A
+ * subsystem therefore still sees the results of all subsystems before it.
+ * @param stage Member function for the stage
+ */
+void  QwSubsystemArray::ProcessEventStage(void (VQwSubsystem::*stage)())
+{
+  if (fStageSubsystems.size() != size()) {
+    fStageSubsystems.clear();
+    fStageSegments.clear();
+    for (iterator subsys = begin(); subsys != end(); ++subsys) {
+      Bool_t parallel = (*subsys)->IsThreadSafe();
+      if (fStageSegments.empty() || fStageSegments.back().parallel != parallel)
+        fStageSegments.push_back(StageSegment{fStageSubsystems.size(), 0, parallel});
+      fStageSegments.back().count++;
+      fStageSubsystems.push_back(subsys->get());
+    }
+  }
+  for (size_t seg = 0; seg < fStageSegments.size(); seg++) {
+    const StageSegment& segment = fStageSegments[seg];
+    VQwSubsystem** subsystems = &fStageSubsystems[segment.first];
+    if (segment.parallel && segment.count > 1) {
+      fWorkerPool->Run(segment.count,
+                       [subsystems,stage](size_t i) { (subsystems[i]->*stage)(); });
+    } else {
+      for (size_t i = 0; i < segment.count; i++)
+        (subsystems[i]->*stage)();
+    }
   }
 }
 
@@ -429,6 +629,19 @@ void  QwSubsystemArray::AtEndOfEventLoop()
   }
 }
 
+/**
+ * Clear the state that the subsystems keep from event to event, so that
+ * the array can analyze a new run with the same configuration without
+ * being constructed again from the parameter files.
+ */
+void  QwSubsystemArray::ClearRunState()
+{
+  if (!empty()) {
+    std::for_each(begin(), end(), boost::mem_fn(&VQwSubsystem::ClearRunState));
+  }
+  SetDataLoaded(kFALSE);
+}
+
 //*****************************************************************
 void  QwSubsystemArray::RandomizeEventData(int helicity, double time)
 {
@@ -0,0 +1,79 @@
+/*!
+ * \file   QwTaskThread.cc
+ * \brief  Background thread running tasks in submission order
+ */
+
+#include "QwTaskThread.h"
+
+QwTaskThread::QwTaskThread()
+: fBusy(false), fStop(false)
+{
+  fThread = std::thread(&QwTaskThread::Work, this);
+}
+
+QwTaskThread::~QwTaskThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fQueued.notify_one();
+  fThread.join();
+}
+
+/**
+ * Queue a task for the background thread
+ * @param task Task to run
+ */
+void QwTaskThread::Submit(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fTasks.push_back(std::move(task));
+  }
+  fQueued.notify_one();
+}
+
+/**
+ * Wait until all queued tasks have run.  The first exception thrown by a
+ * task since the last call is rethrown here.
+ */
+void QwTaskThread::Wait()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fIdle.wait(lock, [this]{ return fTasks.empty() && ! fBusy; });
+  if (fException) {
+    std::exception_ptr exception = fException;
+    fException = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+bool QwTaskThread::IsIdle()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fTasks.empty() && ! fBusy;
+}
+
+void QwTaskThread::Work()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (true) {
+    // Queued tasks are finished before stopping
+    fQueued.wait(lock, [this]{ return fStop || ! fTasks.empty(); });
+    if (fTasks.empty()) return;
+    std::function<void()> task = std::move(fTasks.front());
+    fTasks.pop_front();
+    fBusy = true;
+    lock.unlock();
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(fMutex);
+      if (! fException) fException = std::current_exception();
+    }
+    lock.lock();
+    fBusy = false;
+    if (fTasks.empty()) fIdle.notify_all();
+  }
+}
@@ -13,6 +13,7 @@
 #include "QwLog.h"
 #include "QwUnits.h"
 #include "QwBlinder.h"
+#include "QwBlockChannelValues.h"
 #include "QwHistogramHelper.h"
 #include "QwRootFile.h"
 #ifdef __USE_DATABASE__
@@ -267,6 +268,26 @@ void QwVQWK_Channel::ClearEventData()
   return;
 }
 
+/**
+ * Clear the event data, the history of the hardware checks (previous
+ * sequence number and block sum) and the error counters of the run.
+ */
+void QwVQWK_Channel::ClearRunState()
+{
+  ClearEventData();
+  fNumEvtsWithEventCutsRejected = 0;
+  fErrorCount_sample     = 0;
+  fErrorCount_SW_HW      = 0;
+  fErrorCount_Sequence   = 0;
+  fErrorCount_SameHW     = 0;
+  fErrorCount_ZeroHW     = 0;
+  fErrorCount_HWSat      = 0;
+  fADC_Same_NumEvt       = 0;
+  fSequenceNo_Prev       = 0;
+  fSequenceNo_Counter    = 0;
+  fPrev_HardwareBlockSum = 0.0;
+}
+
 void QwVQWK_Channel::RandomizeEventData(int helicity, double time)
 {
   //std::cout << "In channel: " << GetElementName() << std::endl;
@@ -572,7 +593,7 @@ void QwVQWK_Channel::ProcessEvent()
     fErrorFlag |= kErrorFlag_sample;
   } else if (fNumberOfSamples == 0) {
     //  This is probably a more serious problem.
-    QwWarning << "QwVQWK_Channel::ProcessEvent:  Channel "
+    QwWarningLimited(this,10) << "QwVQWK_Channel::ProcessEvent:  Channel "
               << this->GetElementName().Data()
               << " has fNumberOfSamples==0 but has valid data in the hardware sum.  "
               << "Flag this as an error."
@@ -1150,6 +1171,45 @@ QwVQWK_Channel& QwVQWK_Channel::operator= (const QwVQWK_Channel &value)
   return *this;
 }
 
+/// Packs the same event data as operator= copies
+void QwVQWK_Channel::PackEventData(std::vector<char>& record) const
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::PackEventData(record);
+    PackValues(record, fBlock, fBlocksPerEvent);
+    PackValues(record, fBlockM2, fBlocksPerEvent);
+    PackValue(record, fHardwareBlockSum);
+    PackValue(record, fHardwareBlockSumM2);
+    PackValue(record, fHardwareBlockSumError);
+    PackValue(record, fNumberOfSamples);
+    PackValue(record, fSequenceNumber);
+    if (fDataToSave == kRaw){
+      PackValues(record, fBlock_raw, fBlocksPerEvent);
+      PackValue(record, fHardwareBlockSum_raw);
+      PackValue(record, fSoftwareBlockSum_raw);
+    }
+  }
+}
+
+void QwVQWK_Channel::UnpackEventData(const char*& record)
+{
+  if (!IsNameEmpty()) {
+    VQwHardwareChannel::UnpackEventData(record);
+    UnpackValues(record, fBlock, fBlocksPerEvent);
+    UnpackValues(record, fBlockM2, fBlocksPerEvent);
+    UnpackValue(record, fHardwareBlockSum);
+    UnpackValue(record, fHardwareBlockSumM2);
+    UnpackValue(record, fHardwareBlockSumError);
+    UnpackValue(record, fNumberOfSamples);
+    UnpackValue(record, fSequenceNumber);
+    if (fDataToSave == kRaw){
+      UnpackValues(record, fBlock_raw, fBlocksPerEvent);
+      UnpackValue(record, fHardwareBlockSum_raw);
+      UnpackValue(record, fSoftwareBlockSum_raw);
+    }
+  }
+}
+
 void QwVQWK_Channel::AssignScaledValue(const QwVQWK_Channel &value,
                                  Double_t scale)
 {
@@ -1443,7 +1503,7 @@ QwVQWK_Channel& QwVQWK_Channel::operator/= (const QwVQWK_Channel &denom)
 
   // Nanny
   if (fHardwareBlockSum != fHardwareBlockSum)
-    QwWarning << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
+    QwWarningLimited(this,10) << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
 
   return *this;
 }
@@ -1498,6 +1558,42 @@ void QwVQWK_Channel::AddChannelOffset(Double_t offset)
   return;
 }
 
+/**
+ * Copy the blocks, the hardware sum, their second moments and the scalar
+ * event fields into a packed record for the fused device kernels.
+ */
+void QwVQWK_Channel::GetBlockValues(QwBlockChannelValues& values) const
+{
+  for (Int_t i = 0; i < QwBlockChannelValues::kBlocks; i++) {
+    values.fValue[i]   = fBlock[i];
+    values.fValueM2[i] = fBlockM2[i];
+  }
+  values.fValue[QwBlockChannelValues::kSum]   = fHardwareBlockSum;
+  values.fValueM2[QwBlockChannelValues::kSum] = fHardwareBlockSumM2;
+  values.fSumError        = fHardwareBlockSumError;
+  values.fNumberOfSamples = fNumberOfSamples;
+  values.fSequenceNumber  = fSequenceNumber;
+  values.fGoodEventCount  = fGoodEventCount;
+  values.fErrorFlag       = fErrorFlag;
+}
+
+void QwVQWK_Channel::SetBlockValues(const QwBlockChannelValues& values)
+{
+  if (!IsNameEmpty()) {
+    for (Int_t i = 0; i < QwBlockChannelValues::kBlocks; i++) {
+      fBlock[i]   = values.fValue[i];
+      fBlockM2[i] = values.fValueM2[i];
+    }
+    fHardwareBlockSum      = values.fValue[QwBlockChannelValues::kSum];
+    fHardwareBlockSumM2    = values.fValueM2[QwBlockChannelValues::kSum];
+    fHardwareBlockSumError = values.fSumError;
+    fNumberOfSamples = values.fNumberOfSamples;
+    fSequenceNumber  = values.fSequenceNumber;
+    fGoodEventCount  = values.fGoodEventCount;
+    fErrorFlag       = values.fErrorFlag;
+  }
+}
+
 void QwVQWK_Channel::Scale(Double_t scale)
 {
   if (!IsNameEmpty()){
@@ -1714,7 +1810,7 @@ void QwVQWK_Channel::AccumulateRunningSum(const QwVQWK_Channel& value, Int_t cou
 
   // Nanny
   if (fHardwareBlockSum != fHardwareBlockSum)
-    QwWarning << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
+    QwWarningLimited(this,10) << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
 }
 
 
@@ -1794,8 +1890,7 @@ void QwVQWK_Channel::Blind(const QwBlinder *blinder)
 {
   if (!IsNameEmpty()) {
     if (blinder->IsBlinderOkay() && ((fErrorFlag)==0) ){
-      for (Int_t i = 0; i < fBlocksPerEvent; i++)
-        blinder->BlindValue(fBlock[i]);
+      blinder->BlindValues(fBlock, fBlocksPerEvent);
       blinder->BlindValue(fHardwareBlockSum);
     } else {
       blinder->ModifyThisErrorCode(fErrorFlag);
@@ -1816,8 +1911,7 @@ void QwVQWK_Channel::Blind(const QwBlinder *blinder, const QwVQWK_Channel& yield
 {
   if (!IsNameEmpty()) {
     if (blinder->IsBlinderOkay() && ((fErrorFlag) ==0) ){
-      for (Int_t i = 0; i < fBlocksPerEvent; i++)
-        blinder->BlindValue(fBlock[i], yield.fBlock[i]);
+      blinder->BlindValues(fBlock, yield.fBlock, fBlocksPerEvent);
       blinder->BlindValue(fHardwareBlockSum, yield.fHardwareBlockSum);
     } else {
       blinder->ModifyThisErrorCode(fErrorFlag);//update the HW error code
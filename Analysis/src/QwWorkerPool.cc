@@ -0,0 +1,97 @@
+/*!
+ * \file   QwWorkerPool.cc
+ * \brief  Fixed pool of worker threads for data-parallel loops
+ */
+
+#include "QwWorkerPool.h"
+
+/**
+ * Start the worker threads; the calling thread counts as one of them
+ * @param nthreads Number of threads working on a loop
+ */
+QwWorkerPool::QwWorkerPool(unsigned int nthreads)
+: fTask(0), fSize(0), fNext(0), fBusy(0), fGeneration(0), fStop(false)
+{
+  for (unsigned int i = 1; i < nthreads; i++)
+    fWorkers.push_back(std::thread(&QwWorkerPool::Work, this));
+}
+
+QwWorkerPool::~QwWorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fStart.notify_all();
+  for (size_t i = 0; i < fWorkers.size(); i++)
+    fWorkers[i].join();
+}
+
+/**
+ * Call a task for every index of a loop, on the workers and the calling
+ * thread, and return when all calls have finished.  The first exception
+ * thrown by a task is rethrown here.
+ * @param n    Number of indices
+ * @param task Task to call for each index
+ */
+void QwWorkerPool::Run(size_t n, const std::function<void(size_t)>& task)
+{
+  if (n == 0) return;
+  if (fWorkers.empty() || n == 1) {
+    for (size_t i = 0; i < n; i++) task(i);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fTask = &task;
+    fSize = n;
+    fNext = 0;
+    fBusy = fWorkers.size();
+    fException = nullptr;
+    fGeneration++;
+  }
+  fStart.notify_all();
+
+  Drain();
+
+  std::unique_lock<std::mutex> lock(fMutex);
+  fDone.wait(lock, [this]{ return fBusy == 0; });
+  fTask = 0;
+  if (fException) {
+    std::exception_ptr exception = fException;
+    fException = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void QwWorkerPool::Drain()
+{
+  size_t i;
+  while ((i = fNext++) < fSize) {
+    try {
+      (*fTask)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (! fException) fException = std::current_exception();
+    }
+  }
+}
+
+void QwWorkerPool::Work()
+{
+  unsigned long generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fStart.wait(lock, [&]{ return fStop || fGeneration != generation; });
+      if (fStop) return;
+      generation = fGeneration;
+    }
+    Drain();
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (--fBusy == 0) fDone.notify_one();
+    }
+  }
+}
@@ -19,7 +19,11 @@
 #include "TMatrix.h"
 #include "TString.h"
 
+#ifdef __QWFEEDBACK_MOCK_ACTUATORS
+#include "QwFeedbackMockActuators.h"
+#else
 #include "cadef.h"
+#endif
 
 
 class QwEPICSControl{
@@ -75,7 +79,7 @@ public:
     Int_t status;
     switch(mode){
     case 0:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_C_IA_A0, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_C_IA_A0, &value);
@@ -84,7 +88,7 @@ public:
       std::cout << "Hall C IA value A0: " << value << std::endl;
       break;
     case 1:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_C_IA_A1, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_C_IA_A1, &value);
@@ -93,7 +97,7 @@ public:
       std::cout << "Hall C IA value A1: " << value << std::endl;
       break;
     case 2:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_C_IA_A2, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_C_IA_A2, &value);
@@ -102,7 +106,7 @@ public:
       std::cout << "Hall C IA value A2: " << value << std::endl;
       break;
     case 3:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_C_IA_A3, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_C_IA_A3, &value);
@@ -118,7 +122,7 @@ public:
     Int_t status;
     switch(mode){
     case 0:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_A_IA_A0, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_A_IA_A0, &value);
@@ -127,7 +131,7 @@ public:
       std::cout << "Hall A IA value A0: " << value << std::endl;
       break;
     case 1:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_A_IA_A1, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_A_IA_A1, &value);
@@ -136,7 +140,7 @@ public:
       std::cout << "Hall A IA value A1: " << value << std::endl;
       break;
     case 2:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_A_IA_A2, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_A_IA_A2, &value);
@@ -145,7 +149,7 @@ public:
       std::cout << "Hall A IA value A2: " << value << std::endl;
       break;
     case 3:
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHall_A_IA_A3, &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHall_A_IA_A3, &value);
@@ -160,7 +164,7 @@ public:
   void Set_HelicityMagnet(size_t magnet_index, size_t helicity_index, Double_t &value){
     Int_t status;
     if (magnet_index<4 && helicity_index<2){
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
       status = ca_put(DBR_DOUBLE, fIDHelMag[magnet_index][helicity_index], &value);
       status = ca_pend_io(10);
       status = ca_get(DBR_DOUBLE, fIDHelMag[magnet_index][helicity_index], &value);
@@ -254,7 +258,7 @@ public:
   //I removed followup read after eahc ca_put command - rakithab (02-29-2012)
   void Set_Pockels_Cell_plus(Double_t &value){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE, fIDPockels_Cell_plus, &value);
     status = ca_pend_io(10);
     status = ca_put(DBR_DOUBLE, fIDPockels_Cell_plus, &value);
@@ -265,7 +269,7 @@ public:
   };
   void Set_Pockels_Cell_minus(Double_t &value){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE, fIDPockels_Cell_minus, &value);
     status = ca_pend_io(10);
     status = ca_put(DBR_DOUBLE, fIDPockels_Cell_minus, &value);
@@ -290,7 +294,7 @@ public:
 
   void Set_ChargeAsymmetry(Double_t &value, Double_t &value_error, Double_t &value_width){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE,fChargeAsymmetry , &value);
     status = ca_pend_io(10);
     //status = ca_get(DBR_DOUBLE,fChargeAsymmetry , &value);
@@ -323,7 +327,7 @@ public:
 
   void Set_HAChargeAsymmetry(Double_t &value, Double_t &value_error, Double_t &value_width){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE,fHAChargeAsymmetry , &value);
     status = ca_pend_io(10);
     //status = ca_get(DBR_DOUBLE,fHAChargeAsymmetry , &value);
@@ -357,7 +361,7 @@ public:
   void Set_TargetHCDiffereces(Double_t &xvalue, Double_t &xvalue_error, Double_t &xvalue_width,Double_t &xpvalue, Double_t &xpvalue_error, Double_t &xpvalue_width, Double_t &yvalue, Double_t &yvalue_error, Double_t &yvalue_width, Double_t &ypvalue, Double_t &ypvalue_error, Double_t &ypvalue_width){
 
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE,fTargetXDiff , &xvalue);
     status = ca_pend_io(10);
     status = ca_put(DBR_DOUBLE,fTargetXDiffError , &xvalue_error);
@@ -433,7 +437,7 @@ public:
   void Set_3C12HCDiffereces(Double_t &xvalue, Double_t &xvalue_error, Double_t &xvalue_width, Double_t &yvalue, Double_t &yvalue_error, Double_t &yvalue_width, Double_t &yqvalue, Double_t &yqvalue_error, Double_t &yqvalue_width){
 
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE,f3C12XDiff , &xvalue);
     status = ca_pend_io(10);
     status = ca_put(DBR_DOUBLE,f3C12XDiffError , &xvalue_error);
@@ -491,7 +495,7 @@ public:
 
   void Set_BCM78DDAsymmetry(Double_t &value, Double_t &value_error, Double_t &value_width){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE,fBCM8DDAsymmetry , &value);
     status = ca_pend_io(10);
     status = ca_put(DBR_DOUBLE,fBCM8DDAsymmetryError , &value_error);
@@ -517,7 +521,7 @@ public:
 
   void Set_BCM8Yield(Double_t &value){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE,fBCM8Yield, &value);
     status = ca_pend_io(10);
 #endif
@@ -531,7 +535,7 @@ public:
 
   void Set_USLumiSumAsymmetry(Double_t &value, Double_t &value_error, Double_t &value_width){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE,fUSLumiSumAsymmetry , &value);
     status = ca_pend_io(10);
     status = ca_put(DBR_DOUBLE,fUSLumiSumAsymmetryError , &value_error);
@@ -550,7 +554,7 @@ public:
 
   void Set_FeedbackStatus(Double_t value){
     Int_t status;
-#ifdef(__QWFEEDBACK_ALLOW_EPICS_CA_PUT)
+#ifdef __QWFEEDBACK_ALLOW_EPICS_CA_PUT
     status = ca_put(DBR_DOUBLE, fFeedbackStatus, &value);
     status = ca_pend_io(10);
     status = ca_get(DBR_DOUBLE, fFeedbackStatus, &value);
@@ -0,0 +1,118 @@
+/*!
+ * \file   QwFeedbackMockActuators.h
+ * \brief  In-memory stand-ins for the EPICS and GreenMonster actuators
+ */
+
+#ifndef __QWFEEDBACKMOCKACTUATORS__
+#define __QWFEEDBACKMOCKACTUATORS__
+
+// System headers
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+// ROOT headers
+#include "Rtypes.h"
+
+/**
+ * \class QwFeedbackMockActuators
+ * \ingroup QwFeedback
+ * \brief Recording process variable store replacing the feedback hardware
+ *
+ * When the feedback is built with __QWFEEDBACK_MOCK_ACTUATORS, the channel
+ * access calls of QwEPICSControl and the GreenMonster socket commands are
+ * served from this store instead of from the accelerator controls.  Every
+ * write is recorded with the time elapsed since the last pattern that was
+ * marked complete, so that a replay of a run through the feedback gives the
+ * latency from pattern completion to setpoint write, and the history of the
+ * setpoints and published asymmetries.  The store lives in the feedback
+ * process, so the latency does not include the channel access or socket
+ * transport of the setpoint.
+ */
+class QwFeedbackMockActuators {
+ public:
+  typedef std::chrono::steady_clock clock;
+
+  /// One recorded write of a process variable
+  struct Write {
+    Int_t    fChannel;    ///< Index of the process variable
+    Double_t fValue;      ///< Value written
+    Double_t fLatency;    ///< Seconds since the last completed pattern, or -1
+    Long64_t fPattern;    ///< Number of completed patterns at the write
+  };
+
+  /// \brief Index of a process variable, created with value zero if new
+  static Int_t Find(const std::string& name);
+  /// \brief Name of a process variable
+  static const std::string& GetName(Int_t channel);
+
+  /// \brief Current value of a process variable
+  static Double_t GetValue(Int_t channel);
+  static Double_t GetValue(const std::string& name) {
+    return GetValue(Find(name));
+  }
+  /// \brief Write a process variable as the feedback does, and record it
+  static void PutValue(Int_t channel, Double_t value);
+  /// \brief Preset a process variable without recording the write
+  static void SetValue(const std::string& name, Double_t value);
+
+  /// \brief Preset process variables from "name = value" lines of a file
+  static Int_t LoadValues(const std::string& filename);
+
+  /// \brief Mark the completion of a helicity pattern
+  static void MarkPatternComplete();
+  /// \brief Number of patterns marked complete
+  static Long64_t GetNumberOfPatterns();
+
+  /// \brief Recorded writes, in order
+  static const std::vector<Write>& GetWrites();
+  /// \brief Forget the recorded writes and the pattern count
+  static void ClearWrites();
+
+ private:
+  struct State {
+    std::vector<std::string> fNames;
+    std::vector<Double_t> fValues;
+    std::map<std::string,Int_t> fIndex;
+    std::vector<Write> fWrites;
+    clock::time_point fPatternTime;
+    Long64_t fPatterns;
+    State(): fPatterns(0) { };
+  };
+  static State& GetState();
+};
+
+
+#ifdef __QWFEEDBACK_MOCK_ACTUATORS
+/// \name Channel access interface of cadef.h served by the mock store
+/// @{
+typedef Int_t chid;
+#define DBF_STRING  0
+#define DBR_STRING  0
+#define DBR_DOUBLE  6
+#define ECA_NORMAL  1
+#define ECA_BADTYPE 114
+
+inline int ca_search(const char* name, chid* channel)
+{
+  *channel = QwFeedbackMockActuators::Find(name);
+  return ECA_NORMAL;
+}
+inline int ca_pend_io(double) { return ECA_NORMAL; }
+inline int ca_get(int type, chid channel, void* value)
+{
+  if (type != DBR_DOUBLE) return ECA_BADTYPE;
+  *static_cast<double*>(value) = QwFeedbackMockActuators::GetValue(channel);
+  return ECA_NORMAL;
+}
+inline int ca_put(int type, chid channel, const void* value)
+{
+  if (type != DBR_DOUBLE) return ECA_BADTYPE;
+  QwFeedbackMockActuators::PutValue(channel, *static_cast<const double*>(value));
+  return ECA_NORMAL;
+}
+/// @}
+#endif
+
+#endif
@@ -12,6 +12,7 @@
 #include "QwEPICSControl.h"
 #include "GreenMonster.h"
 #include "QwVQWK_Channel.h"
+#include "QwMollerADC_Channel.h"
 #include "QwScaler_Channel.h"
 
 #include "QwParameterFile.h"
@@ -28,7 +29,7 @@ class QwHelicityCorrelatedFeedback : public QwHelicityPattern {
    ******************************************************************/
 
  public:
-  QwHelicityCorrelatedFeedback(QwSubsystemArrayParity &event):QwHelicityPattern(event){
+  QwHelicityCorrelatedFeedback(QwSubsystemArrayParity &event):QwHelicityPattern(event),fRunningAsymmetry(event){
      //Currently pattern type based runningasymmetry accumulation works only with pattern size of 4
     fFBRunningAsymmetry.resize(kHelModes,event);
     fHelModeGoodPatternCounter.resize(kHelModes,0);
@@ -104,13 +105,16 @@ class QwHelicityCorrelatedFeedback : public QwHelicityPattern {
     out_file_IA = fopen("/local/scratch/qweak/Feedback_IA_log.txt", "a");
     //out_file_IA = fopen("/dev/shm/Feedback_IA_log.txt", "a");
 
+    if (out_file_IA!=NULL){//log directory not available otherwise
     fprintf(out_file_IA,"%22s \n",asctime (timeinfo));
     fprintf(out_file_IA,"Pat num. \t  A_q[mode]\t  IA Setpoint \t  IA Previous Setpoint \n");
     fclose(out_file_IA);
+    }
     //    out_file_PITA = fopen("Feedback_PITA_log.txt", "wt");
 
     out_file_PITA = fopen("/local/scratch/qweak/Feedback_PITA_log.txt", "a");
     out_file_HA_IA = fopen("/local/scratch/qweak/Feedback_HA_IA_log.txt", "a");
+    if (out_file_PITA!=NULL){
     fprintf(out_file_PITA,"%22s \n",asctime (timeinfo));
     fprintf(out_file_PITA,
 	    "%10s %22s +- %16s %16s %26s %26s %26s %26s\n",
@@ -118,13 +122,16 @@ class QwHelicityCorrelatedFeedback : public QwHelicityPattern {
 	    "New PITA Setpoint[+]", "Old PITA Setpoint[+]",
     	    "New PITA Setpoint[-]", "Old PITA Setpoint[-]");
     fclose(out_file_PITA);
+    }
 
+    if (out_file_HA_IA!=NULL){
     fprintf(out_file_HA_IA,"%22s \n",asctime (timeinfo));
     fprintf(out_file_HA_IA,
 	    "%10s %22s  %16s %16s %26s %23s \n",
 	    "Pat num.", "Charge Asym(ppm)", "Asym Error", "Correction",
 	    "New IA Setpoint", "Old IA Setpoint");
     fclose(out_file_HA_IA);
+    }
 
 
 
@@ -143,8 +150,8 @@ class QwHelicityCorrelatedFeedback : public QwHelicityPattern {
     void ClearRunningSum();
     void AccumulateRunningSum();
     void CalculateRunningAverage();
-    void ConstructBranchAndVector(TTree *tree, TString &prefix, std::vector<Double_t> &values);
-    void FillTreeVector(std::vector<Double_t> &values) const;
+    void ConstructBranchAndVector(TTree *tree, TString &prefix, QwRootTreeBranchVector &values);
+    void FillTreeVector(QwRootTreeBranchVector &values) const;
 
     /// \brief Define the configuration options
     static void DefineOptions(QwOptions &options);
@@ -282,6 +289,7 @@ class QwHelicityCorrelatedFeedback : public QwHelicityPattern {
     static const Int_t kHelPat2=110;
     static const Int_t kHelModes=4;//kHelModes
 
+    QwSubsystemArrayParity fRunningAsymmetry;//running asymmetry for the PITA feedback
     std::vector<QwSubsystemArrayParity> fFBRunningAsymmetry;
     Int_t fCurrentHelPat;
     Int_t fPreviousHelPat;
@@ -140,8 +140,6 @@ Int_t main(Int_t argc, Char_t* argv[])
     //  Clear the single-event running sum at the beginning of the runlet
     runningsum.ClearEventData();
     helicitypattern.ClearRunningSum();
-    //  Clear the running sum of the burst values at the beginning of the runlet
-    helicitypattern.ClearBurstSum();
 
 
 
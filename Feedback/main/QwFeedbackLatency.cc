@@ -0,0 +1,324 @@
+/*------------------------------------------------------------------------*//*!
+
+ \file QwFeedbackLatency.cc
+
+ \brief Feedback loop latency and convergence harness on mock actuators
+
+ The harness replays a run through the helicity-correlated feedback as
+ qwfeedback does, but with the feedback built against the mock EPICS and
+ GreenMonster actuators of QwFeedbackMockActuators, so that no setpoint
+ reaches the accelerator.  It reports
+
+   - latency:      for every setpoint, the time from the completion of the
+                   pattern that triggered the correction to the write of the
+                   setpoint (mean, median, 99th percentile and maximum)
+   - convergence:  for every published charge asymmetry, the number of
+                   corrections and the first correction from which all later
+                   asymmetries are compatible with zero within
+                   --fb-converge-sigma of their errors
+
+ The mock actuators are a store in the same process, not a channel access
+ server or GreenMonster socket, so the latency covers the analysis and the
+ feedback computation up to the setpoint call, but not the transport of the
+ setpoint to the controls.
+
+ In a replay the asymmetries do not respond to the mock setpoints, so the
+ convergence follows the loop only for runs which were taken with the
+ feedback running.  The setpoints and the half-wave plate state that the
+ feedback reads before its first correction can be preset with
+ --mock-epics-values.  The results can be written to a JSON file with
+ --fb-bench-output, in the layout of qwbenchmark.
+
+*//*-------------------------------------------------------------------------*/
+
+// System headers
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Qweak headers
+#include "QwLog.h"
+#include "QwOptionsParity.h"
+#include "QwEventBuffer.h"
+#include "QwHistogramHelper.h"
+#include "QwSubsystemArrayParity.h"
+#include "QwHelicityCorrelatedFeedback.h"
+#include "QwFeedbackMockActuators.h"
+#include "QwEventRing.h"
+
+// Qweak subsystems
+// (for correct dependency generation)
+#include "QwHelicity.h"
+#include "QwBeamLine.h"
+
+
+/// Latency summary of the writes of one setpoint
+struct QwFeedbackSetpointResult {
+  std::string name;
+  std::vector<Double_t> latency;
+  Double_t sum_abs_step;
+  Double_t final_value;
+  Int_t writes;
+  QwFeedbackSetpointResult(): sum_abs_step(0.0), final_value(0.0), writes(0) { }
+
+  Double_t GetQuantile(Double_t q) const {
+    if (latency.empty()) return -1.0;
+    std::vector<Double_t> sorted(latency);
+    std::sort(sorted.begin(), sorted.end());
+    size_t i = std::min(sorted.size() - 1, size_t(q * sorted.size()));
+    return sorted[i];
+  }
+  Double_t GetMean() const {
+    if (latency.empty()) return -1.0;
+    Double_t sum = 0.0;
+    for (size_t i = 0; i < latency.size(); i++) sum += latency[i];
+    return sum / latency.size();
+  }
+};
+
+/// Convergence summary of one published asymmetry
+struct QwFeedbackAsymmetryResult {
+  std::string name;
+  std::vector<Double_t> value, error;
+  Int_t converged_after;
+};
+
+
+//----------------------------------------------------------------------------
+/// Collect the setpoint latencies from the recorded writes
+static std::vector<QwFeedbackSetpointResult> GetSetpointResults()
+{
+  std::map<Int_t,size_t> index;
+  std::vector<QwFeedbackSetpointResult> results;
+  const std::vector<QwFeedbackMockActuators::Write>& writes = QwFeedbackMockActuators::GetWrites();
+  for (size_t i = 0; i < writes.size(); i++) {
+    const std::string& name = QwFeedbackMockActuators::GetName(writes[i].fChannel);
+    // Published values and the feedback status are not setpoints
+    if (name.compare(0, 3, "qw:") == 0) continue;
+    if (index.count(writes[i].fChannel) == 0) {
+      index[writes[i].fChannel] = results.size();
+      results.push_back(QwFeedbackSetpointResult());
+      results.back().name = name;
+    } else {
+      QwFeedbackSetpointResult& result = results[index[writes[i].fChannel]];
+      result.sum_abs_step += std::fabs(writes[i].fValue - result.final_value);
+    }
+    QwFeedbackSetpointResult& result = results[index[writes[i].fChannel]];
+    result.final_value = writes[i].fValue;
+    result.writes++;
+    // Writes before the first pattern are initialization, not corrections
+    if (writes[i].fLatency >= 0.0) result.latency.push_back(writes[i].fLatency);
+  }
+  return results;
+}
+
+/// Collect the published asymmetries and find where they converged
+static QwFeedbackAsymmetryResult GetAsymmetryResult(const std::string& name,
+                                                   Double_t nsigma)
+{
+  QwFeedbackAsymmetryResult result;
+  result.name = name;
+  const std::vector<QwFeedbackMockActuators::Write>& writes = QwFeedbackMockActuators::GetWrites();
+  Int_t value_channel = QwFeedbackMockActuators::Find(name);
+  Int_t error_channel = QwFeedbackMockActuators::Find(name + "Error");
+  // The value is published before its error
+  Double_t value = 0.0;
+  for (size_t i = 0; i < writes.size(); i++) {
+    if (writes[i].fChannel == value_channel) value = writes[i].fValue;
+    if (writes[i].fChannel == error_channel) {
+      result.value.push_back(value);
+      result.error.push_back(writes[i].fValue);
+    }
+  }
+  result.converged_after = -1;
+  for (size_t k = result.value.size(); k > 0; k--) {
+    if (std::fabs(result.value[k-1]) > nsigma * result.error[k-1]) break;
+    result.converged_after = k;
+  }
+  return result;
+}
+
+/// Write the results as JSON, one setpoint or asymmetry per line
+static void WriteResults(std::ostream& stream, Long64_t npatterns,
+                         const std::vector<QwFeedbackSetpointResult>& setpoints,
+                         const std::vector<QwFeedbackAsymmetryResult>& asymmetries)
+{
+  stream << "{" << std::endl;
+  stream << "  \"benchmark\": \"qwfeedbacklatency\"," << std::endl;
+  stream << "  \"actuators\": \"in-process\"," << std::endl;
+  stream << "  \"patterns\": " << npatterns << "," << std::endl;
+  stream << "  \"setpoints\": [" << std::endl;
+  for (size_t i = 0; i < setpoints.size(); i++) {
+    const QwFeedbackSetpointResult& result = setpoints[i];
+    stream << "    {\"name\": \"" << result.name << "\""
+           << ", \"writes\": " << result.writes
+           << ", \"corrections\": " << result.latency.size()
+           << std::setprecision(6)
+           << ", \"latency_mean\": " << result.GetMean()
+           << ", \"latency_p50\": " << result.GetQuantile(0.50)
+           << ", \"latency_p99\": " << result.GetQuantile(0.99)
+           << ", \"latency_max\": " << result.GetQuantile(1.00)
+           << std::setprecision(8)
+           << ", \"sum_abs_step\": " << result.sum_abs_step
+           << ", \"final_value\": " << result.final_value
+           << "}" << (i + 1 < setpoints.size() ? "," : "") << std::endl;
+  }
+  stream << "  ]," << std::endl;
+  stream << "  \"asymmetries\": [" << std::endl;
+  for (size_t i = 0; i < asymmetries.size(); i++) {
+    const QwFeedbackAsymmetryResult& result = asymmetries[i];
+    stream << "    {\"name\": \"" << result.name << "\""
+           << ", \"corrections\": " << result.value.size()
+           << ", \"converged_after\": " << result.converged_after
+           << std::setprecision(6)
+           << ", \"final_value\": " << (result.value.empty() ? 0.0 : result.value.back())
+           << ", \"final_error\": " << (result.error.empty() ? 0.0 : result.error.back())
+           << "}" << (i + 1 < asymmetries.size() ? "," : "") << std::endl;
+  }
+  stream << "  ]" << std::endl;
+  stream << "}" << std::endl;
+}
+
+
+//----------------------------------------------------------------------------
+Int_t main(Int_t argc, Char_t* argv[])
+{
+  ///  Fill the search paths for the parameter files
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QW_PRMINPUT"));
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QWANALYSIS") + "/Feedback/prminput");
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QWANALYSIS") + "/Parity/prminput");
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QWANALYSIS") + "/Analysis/prminput");
+
+  ///  Define the command line options
+  gQwOptions.SetCommandLine(argc, argv);
+  gQwOptions.AddConfigFile("qwfeedback_offline.conf");
+  DefineOptionsParity(gQwOptions);
+  QwHelicityCorrelatedFeedback::DefineOptions(gQwOptions);
+  gQwOptions.AddOptions("Feedback latency options")
+    ("mock-epics-values", po::value<std::string>()->default_value(""),
+     "preset the mock process variables from this parameter file");
+  gQwOptions.AddOptions("Feedback latency options")
+    ("fb-bench-output", po::value<std::string>()->default_value(""),
+     "write the latency and convergence results to this JSON file");
+  gQwOptions.AddOptions("Feedback latency options")
+    ("fb-converge-sigma", po::value<double>()->default_value(2.0),
+     "asymmetries within this many errors of zero count as converged");
+
+  gQwHists.ProcessOptions(gQwOptions);
+  gQwLog.ProcessOptions(&gQwOptions);
+
+  std::string values = gQwOptions.GetValue<std::string>("mock-epics-values");
+  std::string output = gQwOptions.GetValue<std::string>("fb-bench-output");
+  Double_t nsigma = gQwOptions.GetValue<double>("fb-converge-sigma");
+
+  if (! values.empty()) QwFeedbackMockActuators::LoadValues(values);
+
+  ///  Create the event buffer
+  QwEventBuffer eventbuffer;
+  eventbuffer.ProcessOptions(gQwOptions);
+
+  Int_t nruns = 0;
+  while (eventbuffer.OpenNextStream() == CODA_OK) {
+    nruns++;
+
+    ///  Set the current event number for parameter file lookup
+    QwParameterFile::SetCurrentRunNumber(eventbuffer.GetRunNumber());
+
+    ///  Load the detectors from file
+    QwSubsystemArrayParity detectors(gQwOptions);
+    detectors.ProcessOptions(gQwOptions);
+
+    ///  Create the helicity pattern with the feedback
+    QwHelicityCorrelatedFeedback helicitypattern(detectors);
+    helicitypattern.ProcessOptions(gQwOptions);
+    helicitypattern.LoadParameterFile("qweak_fb_prm.in");
+
+    ///  Create the event ring with the subsysten array
+    QwEventRing eventring(gQwOptions,detectors);
+
+    helicitypattern.ClearRunningSum();
+
+    // Loop over events in this CODA file
+    while (eventbuffer.GetNextEvent() == CODA_OK) {
+
+      if (eventbuffer.IsROCConfigurationEvent())
+        eventbuffer.FillSubsystemConfigurationData(detectors);
+
+      if (eventbuffer.GetEndEventCount() > 0) break;
+
+      if (! eventbuffer.IsPhysicsEvent()) continue;
+
+      eventbuffer.FillSubsystemData(detectors);
+      detectors.ProcessEvent();
+      if (! detectors.ApplySingleEventCuts()) continue;
+
+      eventring.push(detectors);
+      if (! eventring.IsReady()) continue;
+
+      helicitypattern.LoadEventData(eventring.pop());
+      if (helicitypattern.IsCompletePattern()) {
+        // The latency of the corrections is counted from here
+        QwFeedbackMockActuators::MarkPatternComplete();
+
+        helicitypattern.UpdateBlinder(detectors);
+        helicitypattern.CalculateAsymmetry();
+        if (helicitypattern.IsGoodAsymmetry()) {
+          helicitypattern.ApplyFeedbackCorrections();
+          helicitypattern.ClearEventData();
+        }
+      }
+    }
+
+    QwMessage << "Number of events processed at end of run: "
+              << eventbuffer.GetEventNumber() << QwLog::endl;
+    eventbuffer.CloseStream();
+  }
+
+  if (nruns == 0) {
+    QwError << "No run could be opened for the feedback replay." << QwLog::endl;
+    return 1;
+  }
+
+  ///  Report the results
+  std::vector<QwFeedbackSetpointResult> setpoints = GetSetpointResults();
+  std::vector<QwFeedbackAsymmetryResult> asymmetries;
+  asymmetries.push_back(GetAsymmetryResult("qw:ChargeAsymmetry", nsigma));
+  asymmetries.push_back(GetAsymmetryResult("qw:HAChargeAsymmetry", nsigma));
+
+  Long64_t npatterns = QwFeedbackMockActuators::GetNumberOfPatterns();
+  QwMessage << "Feedback replay of " << npatterns << " patterns" << QwLog::endl;
+  for (size_t i = 0; i < setpoints.size(); i++) {
+    QwMessage << std::setw(20) << std::left << setpoints[i].name << std::right
+              << std::setw(6) << setpoints[i].latency.size() << " corrections, latency"
+              << " mean " << setpoints[i].GetMean() * 1e3 << " ms,"
+              << " max " << setpoints[i].GetQuantile(1.00) * 1e3 << " ms,"
+              << " final setpoint " << setpoints[i].final_value << QwLog::endl;
+  }
+  for (size_t i = 0; i < asymmetries.size(); i++) {
+    if (asymmetries[i].value.empty()) continue;
+    QwMessage << std::setw(20) << std::left << asymmetries[i].name << std::right
+              << std::setw(6) << asymmetries[i].value.size() << " corrections, ";
+    if (asymmetries[i].converged_after > 0)
+      QwMessage << "converged after correction " << asymmetries[i].converged_after;
+    else
+      QwMessage << "not converged";
+    QwMessage << ", final " << asymmetries[i].value.back()
+              << " +/- " << asymmetries[i].error.back() << " ppm" << QwLog::endl;
+  }
+
+  if (! output.empty()) {
+    std::ofstream file(output.c_str());
+    if (! file.is_open()) {
+      QwError << "Could not write feedback results to " << output << QwLog::endl;
+      return 1;
+    }
+    WriteResults(file, npatterns, setpoints, asymmetries);
+  }
+
+  return 0;
+}
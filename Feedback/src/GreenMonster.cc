@@ -1,6 +1,8 @@
 
 #include "GreenMonster.h"
 
+#include <cstring>
+
 //ClassImp(GreenMonster)
 
 GreenMonster::GreenMonster():fVerbose(kTRUE)
@@ -0,0 +1,158 @@
+/*!
+ * \file   QwFeedbackMockActuators.cc
+ * \brief  Implementation of the mock EPICS and GreenMonster actuators
+ */
+
+#include "QwFeedbackMockActuators.h"
+
+// System headers
+#include <cstdlib>
+
+// ROOT headers
+#include "TString.h"
+
+// Qweak headers
+#include "QwLog.h"
+#include "QwParameterFile.h"
+
+QwFeedbackMockActuators::State& QwFeedbackMockActuators::GetState()
+{
+  static State state;
+  return state;
+}
+
+Int_t QwFeedbackMockActuators::Find(const std::string& name)
+{
+  State& state = GetState();
+  std::map<std::string,Int_t>::const_iterator found = state.fIndex.find(name);
+  if (found != state.fIndex.end()) return found->second;
+  Int_t channel = state.fNames.size();
+  state.fNames.push_back(name);
+  state.fValues.push_back(0.0);
+  state.fIndex[name] = channel;
+  return channel;
+}
+
+const std::string& QwFeedbackMockActuators::GetName(Int_t channel)
+{
+  return GetState().fNames.at(channel);
+}
+
+Double_t QwFeedbackMockActuators::GetValue(Int_t channel)
+{
+  return GetState().fValues.at(channel);
+}
+
+void QwFeedbackMockActuators::PutValue(Int_t channel, Double_t value)
+{
+  State& state = GetState();
+  state.fValues.at(channel) = value;
+
+  Write write;
+  write.fChannel = channel;
+  write.fValue   = value;
+  write.fPattern = state.fPatterns;
+  write.fLatency = -1.0;
+  if (state.fPatterns > 0) {
+    std::chrono::duration<double> elapsed = clock::now() - state.fPatternTime;
+    write.fLatency = elapsed.count();
+  }
+  state.fWrites.push_back(write);
+}
+
+void QwFeedbackMockActuators::SetValue(const std::string& name, Double_t value)
+{
+  GetState().fValues.at(Find(name)) = value;
+}
+
+/**
+ * Preset the process variables that the feedback reads before its first
+ * correction, such as the current setpoints and the half-wave plate state.
+ *
+ * @param filename Parameter file with "name = value" lines
+ * @return Number of process variables set
+ */
+Int_t QwFeedbackMockActuators::LoadValues(const std::string& filename)
+{
+  QwParameterFile file(filename);
+  Int_t count = 0;
+  std::string name, value;
+  while (file.ReadNextLine()) {
+    file.TrimComment('#');
+    file.TrimWhitespace();
+    if (file.LineIsEmpty()) continue;
+    if (file.HasVariablePair("=", name, value)) {
+      SetValue(name, atof(value.c_str()));
+      count++;
+    }
+  }
+  QwMessage << "Preset " << count << " mock process variables from "
+            << filename << QwLog::endl;
+  return count;
+}
+
+void QwFeedbackMockActuators::MarkPatternComplete()
+{
+  State& state = GetState();
+  state.fPatternTime = clock::now();
+  state.fPatterns++;
+}
+
+Long64_t QwFeedbackMockActuators::GetNumberOfPatterns()
+{
+  return GetState().fPatterns;
+}
+
+const std::vector<QwFeedbackMockActuators::Write>& QwFeedbackMockActuators::GetWrites()
+{
+  return GetState().fWrites;
+}
+
+void QwFeedbackMockActuators::ClearWrites()
+{
+  State& state = GetState();
+  state.fWrites.clear();
+  state.fPatterns = 0;
+}
+
+
+#ifdef __QWFEEDBACK_MOCK_ACTUATORS
+#include "GMSock.h"
+#include "SCAN_cf_commands.h"
+#include "cfSock_types.h"
+
+/**
+ * GreenMonster socket command served from the mock store, in place of the
+ * cfSockCli client.  The scan status and the two scan data words are kept
+ * as the process variables GM:SCN:status, GM:SCN:data1 and GM:SCN:data2.
+ */
+extern "C" int GreenSockCommand(int crate_number, struct greenRequest *gRequest)
+{
+  if (gRequest->command_type != COMMAND_SCAN) {
+    QwWarning << "Mock GreenMonster: unsupported command type "
+              << gRequest->command_type << " for crate " << crate_number
+              << QwLog::endl;
+    return SOCK_ERROR;
+  }
+  std::string data = Form("GM:SCN:data%ld", gRequest->par1);
+  switch (gRequest->command) {
+  case SCAN_SET_STATUS:
+    QwFeedbackMockActuators::PutValue(QwFeedbackMockActuators::Find("GM:SCN:status"),
+                                      gRequest->par1);
+    break;
+  case SCAN_GET_STATUS:
+    gRequest->par1 = static_cast<long>(QwFeedbackMockActuators::GetValue("GM:SCN:status"));
+    break;
+  case SCAN_SET_DATA:
+    QwFeedbackMockActuators::PutValue(QwFeedbackMockActuators::Find(data),
+                                      gRequest->par2);
+    break;
+  case SCAN_GET_DATA:
+    gRequest->par2 = static_cast<long>(QwFeedbackMockActuators::GetValue(data));
+    break;
+  default:
+    return SOCK_ERROR;
+  }
+  return SOCK_OK;
+}
+#endif
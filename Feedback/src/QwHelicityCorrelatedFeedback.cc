@@ -498,6 +498,7 @@ void QwHelicityCorrelatedFeedback::FeedPCNeg(){
 void QwHelicityCorrelatedFeedback::LogParameters(Int_t mode){
   out_file_IA = fopen("/local/scratch/qweak/Feedback_IA_log.txt", "a");
   //  fprintf(out_file," Feedback at %d current A_q[%d]:%5.8f+/-%5.8f IA Setpoint:%5.3f  IA Previous Setpoint:%5.3f\n",fQuartetNumber,mode,fChargeAsym[mode],fChargeAsymError[mode],fIASetpoint[mode],fPrevIASetpoint[mode]);
+  if (out_file_IA==NULL) return;//log directory not available
   fprintf(out_file_IA," %10.0d A_q[%1.0d] %20.4f +/-  %20.4f  %20.2f  %20.2f\n",fQuartetNumber,mode,fChargeAsym[mode],fChargeAsymError[mode],fIASetpoint[mode],fPrevIASetpoint[mode]);
   fclose(out_file_IA);
 };
@@ -510,6 +511,7 @@ void QwHelicityCorrelatedFeedback::LogParameters(){
   fEPICSCtrl.Set_USLumiSumAsymmetry(fAsymBCMUSLumiSum,fAsymBCMUSLumiSumError,fAsymBCMUSLumiSumWidth);//update the EPICS
   out_file_PITA = fopen("/local/scratch/qweak/Feedback_PITA_log.txt", "a");
   // out_file_PITA = fopen("/dev/shm/Feedback_PITA_log.txt", "a");
+  if (out_file_PITA==NULL) return;//log directory not available
   fprintf(out_file_PITA,"%10.0d %+22.2f %16.2f %16.2f %26.2f %26.2f %26.2f %26.2f \n",fQuartetNumber,fChargeAsymmetry,fChargeAsymmetryError,TMath::Abs(fPITASetpointPOS-fPrevPITASetpointPOS),fPITASetpointPOS,fPrevPITASetpointPOS,fPITASetpointNEG,fPrevPITASetpointNEG);
   fclose(out_file_PITA);
 
@@ -563,6 +565,7 @@ void QwHelicityCorrelatedFeedback::LogHAParameters(Int_t mode){
   fEPICSCtrl.Set_HAChargeAsymmetry(fHAChargeAsym[mode],fHAChargeAsymError[mode],fHAChargeAsymWidth[mode]);//updates the epics values
   out_file_HA_IA = fopen("/local/scratch/qweak/Feedback_HA_IA_log.txt", "a");
   //fQuartetNumber only available when we have good stable Hall C beam
+  if (out_file_HA_IA==NULL) return;//log directory not available
   fprintf(out_file_HA_IA," %10.0d  %20.2f  %15.2f %15.0f %20.0f  %20.0f \n",fQuartetNumber,fHAChargeAsym[mode],fHAChargeAsymError[mode],TMath::Abs(fHAIASetpoint[mode]-fPrevHAIASetpoint[mode]),fHAIASetpoint[mode],fPrevHAIASetpoint[mode]);
   fclose(out_file_HA_IA);
 
@@ -1018,7 +1021,6 @@ void  QwHelicityCorrelatedFeedback::CalculateAsymmetry()
     }
 
     // Accumulate the burst and running sums
-    if (fEnableBurstSum)   AccumulateBurstSum();
     if (fEnableRunningSum) {
       AccumulateRunningSum();
     }
@@ -1042,7 +1044,7 @@ void QwHelicityCorrelatedFeedback::AccumulateRunningSum(){
 
 
 
-  QwHelicityPattern::AccumulateRunningSum();
+  fRunningAsymmetry.AccumulateRunningSum(fAsymmetry);
 
   if(fAsymmetry.RequestExternalValue("sca_bcm", &fScalerCharge)){
     //fScalerChargeRunningSum.PrintValue();
@@ -1161,7 +1163,7 @@ void QwHelicityCorrelatedFeedback::AccumulateRunningSum(){
 
 
 void QwHelicityCorrelatedFeedback::CalculateRunningAverage(){
-  QwHelicityPattern::CalculateRunningAverage();
+  fRunningAsymmetry.CalculateRunningAverage();
 };
 
 void QwHelicityCorrelatedFeedback::CalculateRunningAverage(Int_t mode){
@@ -1339,7 +1341,7 @@ void QwHelicityCorrelatedFeedback::GetHAChargeStat(Int_t mode){
  */
 void  QwHelicityCorrelatedFeedback::ClearRunningSum()
 {
-  QwHelicityPattern::ClearRunningSum();
+  fRunningAsymmetry.ClearEventData();
   //Clean bcm8 yield and bcm78 DD running sums
   fAsymBCM78DDRunningSum.ClearEventData();
   fYieldBCM8RunningSum.ClearEventData();
@@ -1352,24 +1354,33 @@ void  QwHelicityCorrelatedFeedback::ClearRunningSum(Int_t mode)
   fFBRunningAsymmetry[mode].ClearEventData();
 };
 
-void  QwHelicityCorrelatedFeedback::ConstructBranchAndVector(TTree *tree, TString &prefix, std::vector<Double_t> &values){
+void  QwHelicityCorrelatedFeedback::ConstructBranchAndVector(TTree *tree, TString &prefix, QwRootTreeBranchVector &values){
   QwHelicityPattern::ConstructBranchAndVector(tree,prefix,values);
 };
 
-void  QwHelicityCorrelatedFeedback::FillTreeVector(std::vector<Double_t> &values) const{
+void  QwHelicityCorrelatedFeedback::FillTreeVector(QwRootTreeBranchVector &values) const{
   QwHelicityPattern::FillTreeVector(values);
 };
 
 
 TString  QwHelicityCorrelatedFeedback::GetHalfWavePlateState()
 {
+#ifdef __QWFEEDBACK_MOCK_ACTUATORS
+  //the mock store keeps the plate state as a number, non-zero is IN
+  TString plate_status = (QwFeedbackMockActuators::GetValue("IGL1I00DI24_24M")!=0)? "IN": "OUT";
+#else
   TString plate_status = gSystem->GetFromPipe("caget -t -w 0.1 IGL1I00DI24_24M");
+#endif
   return plate_status;
 };
 
 UInt_t QwHelicityCorrelatedFeedback::GetHalfWavePlate2State(){
+#ifdef __QWFEEDBACK_MOCK_ACTUATORS
+  UInt_t ihwp2 = static_cast<UInt_t>(QwFeedbackMockActuators::GetValue("IGL1I00DIOFLRD"));
+#else
   TString ihwp2_value = gSystem->GetFromPipe("caget -tf0 -w 0.1  IGL1I00DIOFLRD");
   UInt_t ihwp2 =ihwp2_value.Atoi();
+#endif
 
   if (ihwp2>10000)
     return 1;//13056=IN
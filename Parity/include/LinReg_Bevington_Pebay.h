@@ -68,6 +68,9 @@ class LinRegBevPeb {
   LinRegBevPeb();
   LinRegBevPeb(const LinRegBevPeb& source);
   virtual ~LinRegBevPeb() { };
+  /// Assignment keeps the storage of the matrices, so that tree branches
+  /// pointing into them stay valid
+  LinRegBevPeb& operator=(const LinRegBevPeb& source);
 
   void solve();
   bool failed() { return fGoodEventNumber < nP + 1; }
@@ -0,0 +1,129 @@
+/*!
+ * \file   QwAggregator.h
+ * \brief  Data handler accumulating run and minirun aggregates during replay
+ */
+
+#pragma once
+
+// System headers
+#include <string>
+#include <vector>
+
+// Parent Class
+#include "VQwDataHandler.h"
+
+/**
+ * \class QwAggregator
+ * \ingroup QwAnalysis
+ * \brief Data handler that writes the camguin aggregator output in one pass
+ *
+ * The camguin aggregator computes the mean, RMS and correlation slope of
+ * every monitored quantity with its own pass over the mul tree.  This
+ * handler accumulates the same statistics of the hardware sums of the
+ * configured variables while the patterns are processed, and at the end of
+ * every minirun (burst) and of the run writes them into the "agg" trees of
+ * the files minirun_aggregator_<run>_<minirun>.root and
+ * run_aggregator_<run>.root, with the branch names of camguin.
+ *
+ * Only patterns with a zero event cut error flag enter the statistics, as
+ * the ErrorFlag==0 cut of the aggregator.  The means and second moments are
+ * accumulated with Welford's update, and the miniruns are merged into the
+ * run totals with the pairwise update of Chan et al., so that the results
+ * do not suffer from cancellation on large offsets.  The errors follow
+ * the histogram conventions of the aggregator: the error on the mean is
+ * rms/sqrt(n) and the error on the rms is rms/sqrt(2n).
+ *
+ * The map file lists one variable per line (e.g. asym_bcm_target), and
+ * correlation slopes of a dependent on an independent variable as
+ * "cor <dv> <iv>", which are written as cor_<dv>_<iv>_slope.
+ *
+ * The handler writes the miniruns itself when the burst counter changes,
+ * so it is meant for the pattern handler array only ("scope = mul"); in
+ * the burst handler array as well it would write every file twice.
+ */
+class QwAggregator:public VQwDataHandler, public MQwDataHandlerCloneable<QwAggregator>
+{
+ public:
+    /// \brief Constructor with name
+    QwAggregator(const TString& name);
+
+    /// \brief Copy constructor
+    QwAggregator(const QwAggregator &source);
+    /// Virtual destructor
+    ~QwAggregator() override { };
+
+    void ParseConfigFile(QwParameterFile& file) override;
+
+    /// \brief Load the variables and correlations
+    Int_t LoadChannelMap(const std::string& mapfile) override;
+
+    /// \brief Connect to the yield, asymmetry and difference channels
+    Int_t ConnectChannels(
+      QwSubsystemArrayParity& yield,
+      QwSubsystemArrayParity& asym,
+      QwSubsystemArrayParity& diff) override;
+
+    /// \brief Accumulate the current pattern
+    void ProcessData() override;
+
+    /// \brief Write the minirun which ends when the burst counter changes
+    void UpdateBurstCounter(Short_t burstcounter) override;
+
+    /// \brief Write the current minirun and the run totals so far
+    void FinishDataHandler() override;
+
+  protected:
+
+    /// Default constructor (Protected for child class access)
+    QwAggregator() { };
+
+    /// Running moments of one variable
+    struct Moments {
+      Double_t fN;
+      Double_t fMean;
+      Double_t fM2;
+      Moments(): fN(0.0), fMean(0.0), fM2(0.0) { };
+      void Add(Double_t x);
+      void Merge(const Moments& value);
+    };
+
+    /// Running co-moments of a pair of variables
+    struct CoMoments {
+      Moments fX, fY;
+      Double_t fCXY;
+      CoMoments(): fCXY(0.0) { };
+      void Add(Double_t x, Double_t y);
+      void Merge(const CoMoments& value);
+    };
+
+    /// \brief Write the aggregates into the agg tree of a file
+    void WriteAggregates(const std::string& filename, Double_t minirun,
+                         const std::vector<Moments>& moments,
+                         const std::vector<CoMoments>& comoments) const;
+
+    /// \brief Write the current minirun and merge it into the run
+    void FinishMinirun();
+
+  protected:
+
+    std::string fOutputPath;    ///< Directory of the output files
+    Bool_t fWriteMiniruns;      ///< Write the minirun files
+    Bool_t fMinirunStarted;     ///< A pattern was seen in the current minirun
+
+    /// Variables
+    std::vector<std::string> fVariableFull;
+    std::vector<EQwHandleType> fVariableType;
+    std::vector<std::string> fVariableName;
+    std::vector<const VQwHardwareChannel*> fVariable;
+
+    /// Correlations, as indices into the variables
+    std::vector< std::pair<size_t,size_t> > fCorrelation;
+
+    /// Accumulators of the current minirun and of the run
+    std::vector<Moments> fMinirunMoments, fRunMoments;
+    std::vector<CoMoments> fMinirunCoMoments, fRunCoMoments;
+
+}; // class QwAggregator
+
+// Register this handler with the factory
+REGISTER_DATA_HANDLER_FACTORY(QwAggregator);
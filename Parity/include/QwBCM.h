@@ -98,6 +98,12 @@ template<typename T> class QwBCM : public VQwBCM {
   Bool_t ApplyHWChecks();//Check for hardware errors in the devices
   Bool_t ApplySingleEventCuts() override;//Check for good events by setting limits on the devices readings
   void IncrementErrorCounters() override;
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override {
+    fBeamCurrent.CollectErrorFlags(flags);
+  };
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override {
+    fBeamCurrent.CollectChannels(channels);
+  };
   void PrintErrorCounters() const override;// report number of events failed due to HW and event cut failure
   UInt_t GetEventcutErrorFlag() override{//return the error flag
     return fBeamCurrent.GetEventcutErrorFlag();
@@ -121,6 +121,8 @@ class QwBPMStripline : public VQwBPM {
   //void    SetSingleEventCuts(TString ch_name, UInt_t errorflag,Double_t min, Double_t max, Double_t stability, Double_t burplevel){return;};
   void    SetEventCutMode(Int_t bcuts) override;
   void    IncrementErrorCounters() override;
+  void    CollectErrorFlags(std::vector<const UInt_t*>& flags) const override;
+  void    CollectChannels(std::vector<VQwHardwareChannel*>& channels) override;
   void    PrintErrorCounters() const override;   // report number of events failed due to HW and event cut failure
   UInt_t  GetEventcutErrorFlag() override;
   UInt_t  UpdateErrorFlag() override;
@@ -203,6 +205,15 @@ class QwBPMStripline : public VQwBPM {
   static const Double_t kRotationCorrection;
   static const TString subelement[4];
 
+  /// \brief Compute the derived channels from the processed wires with channel arithmetic
+  void    ProcessDerivedChannels();
+  /// \brief Compute the derived channels in one pass over packed wire values
+  Bool_t  ProcessFusedKernel();
+  /// \brief Compute the derived channels both ways and compare them
+  void    VerifyFusedKernel();
+  /// \brief Whether all channels are named, so that no channel operation is skipped
+  Bool_t  IsFullyNamed() const;
+
 
 
  protected:
@@ -6,6 +6,7 @@
 #pragma once
 
 // System headers
+#include <memory>
 #include <vector>
 
 // ROOT headers
@@ -27,6 +28,8 @@
 #include "QwLinearDiodeArray.h"
 #include "VQwClock.h"
 #include "QwBeamDetectorID.h"
+#include "QwADC18_Channel.h"
+#include "QwMollerADC_Channel.h"
 
 
 /**
@@ -49,7 +52,9 @@ class QwBeamLine : public VQwSubsystemParity, public MQwSubsystemCloneable<QwBea
  public:
   /// Constructor with name
   QwBeamLine(const TString& name)
-  : VQwSubsystem(name),VQwSubsystemParity(name)
+  : VQwSubsystem(name),VQwSubsystemParity(name),
+    fLazyDerivedDevices(kFALSE),
+    fDerivedUsage(std::make_shared<DerivedDeviceUsage>())
   { };
   /// Copy constructor
   QwBeamLine(const QwBeamLine& source)
@@ -59,7 +64,9 @@ class QwBeamLine : public VQwSubsystemParity, public MQwSubsystemCloneable<QwBea
     fCavity(source.fCavity),
     fHaloMonitor(source.fHaloMonitor),
     fECalculator(source.fECalculator),
-    fBeamDetectorID(source.fBeamDetectorID)
+    fBeamDetectorID(source.fBeamDetectorID),
+    fLazyDerivedDevices(source.fLazyDerivedDevices),
+    fDerivedUsage(source.fDerivedUsage)
   { this->CopyTemplatedDataElements(&source); }
   /// Virtual destructor
   ~QwBeamLine() override { };
@@ -80,6 +87,8 @@ class QwBeamLine : public VQwSubsystemParity, public MQwSubsystemCloneable<QwBea
 
   Bool_t ApplySingleEventCuts() override;//derived from VQwSubsystemParity
   void   IncrementErrorCounters() override;
+  void   CollectErrorFlags(std::vector<const UInt_t*>& flags) const override;
+  void   CollectChannels(std::vector<VQwHardwareChannel*>& channels) override;
 
   Bool_t CheckForBurpFail(const VQwSubsystem *subsys) override;
 
@@ -97,10 +106,15 @@ class QwBeamLine : public VQwSubsystemParity, public MQwSubsystemCloneable<QwBea
 
   void   ClearEventData() override;
   void   ProcessEvent() override;
+  /// The BPM, combined device and energy calculator code uses static scratch channels
+  Bool_t IsThreadSafe() const override { return kFALSE; };
 
   Bool_t PublishInternalValues() const override;
   Bool_t PublishByRequest(TString device_name) override;
 
+  /// \brief Stop computing the derived devices which nothing reads
+  void   DisableUnusedDerivedQuantities() override;
+
 
  public:
   size_t GetNumberOfElements();
@@ -203,6 +217,33 @@ protected:
   std::vector <QwEnergyCalculator> fECalculator;
   std::vector <QwBeamDetectorID> fBeamDetectorID;
 
+  /// Subbanks with ADC18 modules, and the decoder for the current ADC18 bank
+  std::vector <Bool_t> fADC18Subbank;
+  QwADC18_BankDecoder fADC18Bank;
+  /// First MollerADC record in each subbank (-1 if none), and the decoder for the current bank
+  std::vector <Int_t> fMollerADCFirstWord;
+  QwMollerADC_BankDecoder fMollerADCBank;
+
+  /**
+   * Combined BCMs, combined BPMs and energy calculators which are read by a
+   * tree, histogram, event cut or published value, and the ones which are
+   * not computed in ProcessEvent.  The record is shared by all copies of the
+   * subsystem, since the outputs and data handlers are built on the copies
+   * while ProcessEvent runs on the original.
+   */
+  struct DerivedDeviceUsage {
+    std::vector<Bool_t> fUsedBCMCombo, fUsedBPMCombo, fUsedECalculator;
+    std::vector<Bool_t> fSkipBCMCombo, fSkipBPMCombo, fSkipECalculator;
+  };
+  /// Skip the derived devices without readers
+  Bool_t fLazyDerivedDevices;
+  std::shared_ptr<DerivedDeviceUsage> fDerivedUsage;
+
+  /// \brief Record that a derived device is read, and compute it again if skipped
+  void MarkDerivedDeviceUsed(EQwBeamInstrumentType type_id, Int_t index) const;
+  /// \brief Record that all derived devices are read
+  void MarkAllDerivedDevicesUsed() const;
+
 
 
 /////
@@ -147,6 +147,7 @@ class QwBeamMod: public VQwSubsystemParity, public MQwSubsystemCloneable<QwBeamM
 
   Bool_t ApplySingleEventCuts() override;//derived from VQwSubsystemParity
   void IncrementErrorCounters() override;
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override;
   void PrintErrorCounters() const override;// report number of events failed due to HW and event cut failures
   UInt_t GetEventcutErrorFlag() override;//return the error flag
 
@@ -160,6 +161,7 @@ class QwBeamMod: public VQwSubsystemParity, public MQwSubsystemCloneable<QwBeamM
 //  void  PrintDetectorID();
 
   void  ClearEventData() override;
+  void  ClearRunState() override;
 
   void  ProcessEvent() override;
   void  ProcessEvent_2() override;
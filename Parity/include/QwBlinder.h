@@ -170,6 +170,43 @@ class QwBlinder {
       }
     };
 
+    /// Asymmetry blinding of a contiguous span of values; the strategy
+    /// is chosen once for the whole span
+    void  BlindValues(Double_t* values, size_t n) const {
+      const Double_t offset = fBlindingOffset;
+      const Double_t factor = fBlindingFactor;
+      switch (fBlindingStrategy) {
+        case kAdditive:
+          for (size_t i = 0; i < n; i++) values[i] += offset;
+          break;
+        case kMultiplicative:
+          for (size_t i = 0; i < n; i++) values[i] *= factor;
+          break;
+        case kAdditiveMultiplicative:
+          for (size_t i = 0; i < n; i++) values[i] = (values[i] + offset) * factor;
+          break;
+        default: break;
+      }
+    };
+    /// Difference blinding of a contiguous span of values against the
+    /// span of their yields
+    void  BlindValues(Double_t* values, const Double_t* yields, size_t n) const {
+      const Double_t offset = fBlindingOffset;
+      const Double_t factor = fBlindingFactor;
+      switch (fBlindingStrategy) {
+        case kAdditive:
+          for (size_t i = 0; i < n; i++) values[i] += yields[i] * offset;
+          break;
+        case kMultiplicative:
+          for (size_t i = 0; i < n; i++) values[i] *= factor;
+          break;
+        case kAdditiveMultiplicative:
+          for (size_t i = 0; i < n; i++) values[i] = (values[i] + offset * yields[i]) * factor;
+          break;
+        default: break;
+      }
+    };
+
     /// Blind the asymmetry of an array of subsystems
     void  Blind(QwSubsystemArrayParity& diff) {
       if (CheckBlindability(fPatternCounters)!=kNotBlindable)
@@ -72,6 +72,8 @@ class QwClock : public VQwClock {
   Bool_t ApplyHWChecks();//Check for hardware errors in the devices
   Bool_t ApplySingleEventCuts() override;//Check for good events by setting limits on the devices readings
   void IncrementErrorCounters() override{fClock.IncrementErrorCounters();}
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override {fClock.CollectErrorFlags(flags);}
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override {fClock.CollectChannels(channels);}
 
   Bool_t CheckForBurpFail(const QwClock *ev_error){
     return fClock.CheckForBurpFail(&(ev_error->fClock));
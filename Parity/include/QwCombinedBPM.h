@@ -118,6 +118,8 @@ class QwCombinedBPM : public VQwBPM {
   //void    SetSingleEventCuts(TString ch_name, UInt_t errorflag,Double_t min, Double_t max, Double_t stability);
   void    SetEventCutMode(Int_t bcuts) override;
   void IncrementErrorCounters() override;
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override;
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override;
   void PrintErrorCounters() const override;// report number of events failed due to HW and event cut failure
   UInt_t  GetEventcutErrorFlag() override;
   UInt_t  UpdateErrorFlag() override;
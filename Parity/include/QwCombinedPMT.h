@@ -97,6 +97,12 @@ class QwCombinedPMT : public VQwDataElement {
   void IncrementErrorCounters(){
     fSumADC.IncrementErrorCounters();
   }
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override {
+    fSumADC.CollectErrorFlags(flags);
+  }
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override {
+    fSumADC.CollectChannels(channels);
+  }
 
   Bool_t CheckForBurpFail(const VQwDataElement *ev_error);
 
@@ -113,7 +119,7 @@ class QwCombinedPMT : public VQwDataElement {
   void Difference(const QwCombinedPMT &value1, const QwCombinedPMT &value2);
   void Ratio(QwCombinedPMT &numer, QwCombinedPMT &denom);
   void Scale(Double_t factor);
-  void Normalize(VQwDataElement* denom);
+  void Normalize(const VQwDataElement* denom);
   void AccumulateRunningSum(const QwCombinedPMT& value, Int_t count=0, Int_t ErrorMask=0xFFFFFFF);
   void DeaccumulateRunningSum(QwCombinedPMT& value, Int_t ErrorMask=0xFFFFFFF);
   void CalculateRunningAverage();
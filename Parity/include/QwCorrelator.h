@@ -15,6 +15,7 @@
 
 // System headers
 #include <fstream>
+#include <memory>
 
 // Forward declarations
 class TH1D;
@@ -59,6 +60,15 @@ class QwCorrelator : public VQwDataHandler, public MQwDataHandlerCloneable<QwCor
     CalcCorrelations();
   }
   void CalcCorrelations();
+  /// \brief Print the entry counts and the error flag failures
+  void PrintEntrySummary() const;
+
+  /// \brief Snapshot the regression for solving it in the background
+  Bool_t SnapshotDataHandler() override;
+  /// \brief Solve the snapshot and write the alpha and alias files
+  void FinishSnapshot() override;
+  /// \brief Fill the solved snapshot into the correlator tree
+  void FillSnapshot() override;
 
   /// \brief Construct the tree branches
   void ConstructTreeBranches(
@@ -96,7 +106,8 @@ class QwCorrelator : public VQwDataHandler, public MQwDataHandlerCloneable<QwCor
   std::string fAlphaOutputPath;
   TFile* fAlphaOutputFile;
   void OpenAlphaFile(const std::string& prefix);
-  void WriteAlphaFile();
+  void WriteAlphaFile() { WriteAlphaFile(linReg); };
+  void WriteAlphaFile(LinRegBevPeb& reg);
   void CloseAlphaFile();
 
   TTree* fTree;
@@ -106,7 +117,8 @@ class QwCorrelator : public VQwDataHandler, public MQwDataHandlerCloneable<QwCor
   std::string fAliasOutputPath;
   std::ofstream fAliasOutputFile;
   void OpenAliasFile(const std::string& prefix);
-  void WriteAliasFile();
+  void WriteAliasFile() { WriteAliasFile(linReg); };
+  void WriteAliasFile(const LinRegBevPeb& reg);
   void CloseAliasFile();
 
   int fTotalCount;
@@ -132,6 +144,12 @@ class QwCorrelator : public VQwDataHandler, public MQwDataHandlerCloneable<QwCor
 
   LinRegBevPeb linReg;
 
+  /// Snapshot of the regression and the entry counts of a burst, which is
+  /// solved in the background while linReg accumulates the next burst
+  std::unique_ptr<LinRegBevPeb> fSnapshot;
+  int fSnapshotTotalCount;
+  int fSnapshotGoodCount;
+
   Int_t fCycleCounter;
 
   // Default constructor
@@ -9,6 +9,7 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include "Rtypes.h"
 #include "TString.h"
 #include "TDirectory.h"
@@ -29,6 +30,7 @@
 // Forward declarations
 class QwParityDB;
 class QwPromptSummary;
+class QwTaskThread;
 
 /**
  * \class QwDataHandlerArray
@@ -61,8 +63,9 @@ class QwDataHandlerArray:
     QwDataHandlerArray(); // not implement, will thrown linker error on use
 
   public:
-    /// Constructor from helicity pattern with options
-    QwDataHandlerArray(QwOptions& options, QwHelicityPattern& helicitypattern, const TString &run);
+    /// Constructor from helicity pattern with options, for the pattern or
+    /// the burst handler array
+    QwDataHandlerArray(QwOptions& options, QwHelicityPattern& helicitypattern, const TString &run, Bool_t burst = kFALSE);
     /// Constructor from subsystem array with options
     QwDataHandlerArray(QwOptions& options, QwSubsystemArrayParity& detectors, const TString &run);
     /// Copy constructor by reference
@@ -188,6 +191,13 @@ class QwDataHandlerArray:
 
     void FinishDataHandler();
 
+    /// \brief Finish the data handlers at the end of a burst, in the
+    ///        background where supported (option 'pipeline-bursts')
+    void FinishDataHandlerInBackground();
+    /// \brief Wait for the background finisher and fill the results of the
+    ///        previous burst
+    void FillFinishedDataHandlers();
+
   protected:
 
     void SetPointer(QwHelicityPattern& helicitypattern) {
@@ -204,14 +214,19 @@ class QwDataHandlerArray:
     /// Filename of the global detector map
     std::string fDataHandlersMapFile;
 
+    /// Scope "pattern" selects both the pattern and the burst handler
+    /// arrays; "mul" and "burst" select only one of them
     Bool_t ScopeMismatch(TString name){
       name.ToLower();
+      if (name=="pattern")
+        return (fArrayScope != kPatternScope && fArrayScope != kBurstScope);
       EDataHandlerArrayScope tmpscope = kUnknownScope;
       if (name=="event") tmpscope = kEventScope;
-      if (name=="pattern") tmpscope = kPatternScope;
+      if (name=="mul") tmpscope = kPatternScope;
+      if (name=="burst") tmpscope = kBurstScope;
       return (fArrayScope != tmpscope);
     }
-    enum EDataHandlerArrayScope {kUnknownScope=-1, kEventScope, kPatternScope};
+    enum EDataHandlerArrayScope {kUnknownScope=-1, kEventScope, kPatternScope, kBurstScope};
     EDataHandlerArrayScope fArrayScope;
 
     std::vector<std::string> fDataHandlersDisabledByName; ///< List of disabled types
@@ -219,6 +234,13 @@ class QwDataHandlerArray:
 
     Bool_t fPrintRunningSum;
 
+    /// Finish bursts on a background thread
+    Bool_t fPipelineBursts;
+    /// Background finisher, started at the first burst (not shared with copies)
+    std::unique_ptr<QwTaskThread> fFinisher;
+    /// Handlers with a snapshot handed to the finisher
+    std::vector<VQwDataHandler*> fFinishing;
+
     /// Test whether this handler array can contain a particular handler
     static Bool_t CanContain(VQwDataHandler* handler) {
       return (dynamic_cast<VQwDataHandler*>(handler) != 0);
@@ -74,8 +74,8 @@ class QwEnergyCalculator : public VQwDataElement{
     void    SetRandomEventParameters(Double_t mean, Double_t sigma);
     void    RandomizeEventData(int helicity = 0, double time = 0.0);
     void    GetProjectedPosition(VQwBPM *device);
-    size_t  GetNumberOfElements() {return fDevice.size();};
-    TString GetSubElementName(Int_t index) {return fDevice.at(index)->GetElementName();};
+    size_t  GetNumberOfElements() const {return fDevice.size();};
+    TString GetSubElementName(Int_t index) const {return fDevice.at(index)->GetElementName();};
     void    LoadMockDataParameters(QwParameterFile &paramfile) override;
 //------------------------------------------------------------------------------------
 
@@ -99,6 +99,12 @@ class QwEnergyCalculator : public VQwDataElement{
     Bool_t CheckForBurpFail(const VQwDataElement *ev_error);
 
     void    IncrementErrorCounters();
+    void    CollectErrorFlags(std::vector<const UInt_t*>& flags) const override {
+      fEnergyChange.CollectErrorFlags(flags);
+    };
+    void    CollectChannels(std::vector<VQwHardwareChannel*>& channels) override {
+      fEnergyChange.CollectChannels(channels);
+    };
     void    PrintErrorCounters() const override;// report number of events failed due to HW and event cut failure
     UInt_t   GetEventcutErrorFlag() override{//return the error flag
       return fEnergyChange.GetEventcutErrorFlag();
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 
 #include <fstream>
 #include "QwSubsystemArrayParity.h"
@@ -24,6 +25,13 @@
  *
  * Maintains a sliding window of events to compute running averages,
  * handle beam trips with holdoff, and apply burp cuts over extents.
+ *
+ * With the option ring.compress the events are not kept as full copies of
+ * the subsystem array: the channel data of the subsystems that enumerate
+ * their channels is kept as fixed-size packed records in one buffer, and
+ * only the other subsystems are kept as copies.  An event is rebuilt into a
+ * scratch array when it is checked or read from the ring, so the cuts are
+ * the same as without compression.
  */
 class QwEventRing {
 
@@ -73,6 +81,14 @@ class QwEventRing {
     }
   }
  private:
+  /// \brief Copy an event into a slot of the ring
+  void Store(Int_t slot, const QwSubsystemArrayParity &event);
+  /// \brief Return the event in a slot of the ring
+  QwSubsystemArrayParity& Load(Int_t slot);
+  /// \brief Write back the event in a slot after it was modified
+  void Save(Int_t slot);
+  /// \brief Event cut error flag of the event in a slot
+  UInt_t GetEventcutErrorFlag(Int_t slot);
 
   Int_t fRING_SIZE;//this is the length of the ring
 
@@ -89,6 +105,16 @@ class QwEventRing {
   Bool_t bRING_READY; //set to true after ring is filled with good events and time to process them. Set to kFALSE after processing
   //all the events in the ring
   std::vector<QwSubsystemArrayParity> fEvent_Ring;
+
+  //Compressed ring: packed records, copies of the subsystems that are not
+  //packable, and the scratch event into which a slot is rebuilt
+  Bool_t fCompress;
+  size_t fPackedSize;
+  std::vector<char> fPackedRing;
+  std::vector<char> fPackBuffer;
+  std::vector< std::vector< std::shared_ptr<VQwSubsystem> > > fUnpackedRing;
+  std::unique_ptr<QwSubsystemArrayParity> fSlotEvent;
+  Int_t fLoadedSlot;
   //to track all the rolling averages for stability checks
   QwSubsystemArrayParity fRollingAvg;
 
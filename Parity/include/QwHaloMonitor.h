@@ -93,6 +93,8 @@ class  QwHaloMonitor : public VQwDataElement{
 
   Bool_t ApplySingleEventCuts();//check values read from modules are at desired level
   void IncrementErrorCounters(){fHalo_Counter.IncrementErrorCounters();};
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override {fHalo_Counter.CollectErrorFlags(flags);};
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override {fHalo_Counter.CollectChannels(channels);};
   UInt_t GetEventcutErrorFlag() override{return fHalo_Counter.GetEventcutErrorFlag();};
 
   Bool_t CheckForBurpFail(const VQwDataElement *ev_error);
@@ -79,6 +79,8 @@ class QwHelicityBase: public VQwSubsystemParity{
   };
 
   void IncrementErrorCounters() override;
+  /// No error counters and no error flags to update, nothing to collect
+  void CollectErrorFlags(std::vector<const UInt_t*>& /*flags*/) const override { };
   void PrintErrorCounters() const override;// report number of events failed due to HW and event cut failure, derived from VQwSubsystemParity
   UInt_t  GetEventcutErrorFlag() override;//return the error flag
   //update the error flag in the subsystem level from the top level routines related to stability checks. This will uniquely update the errorflag at each channel based on the error flag in the corresponding channel in the ev_error subsystem
@@ -93,6 +95,8 @@ class QwHelicityBase: public VQwSubsystemParity{
   Int_t  ProcessEvBuffer(UInt_t ev_type, const ROCID_t roc_id, const BankID_t bank_id, UInt_t* buffer, UInt_t num_words) override;
 
   virtual void  ClearEventData() override;
+  /// \brief Restart the helicity prediction and the error counters for a new run
+  void  ClearRunState() override;
 
   UInt_t GetRandomSeedActual() { return iseed_Actual; };
   UInt_t GetRandomSeedDelayed() { return iseed_Delayed; };
@@ -117,6 +121,11 @@ class QwHelicityBase: public VQwSubsystemParity{
   void SetFirstBits(UInt_t nbits, UInt_t firstbits);
   void SetEventPatternPhase(Int_t event, Int_t pattern, Int_t phase);
 
+  /// \brief Advance a predictor seed by a number of patterns in O(log n) steps
+  UInt_t JumpAhead(UInt_t seed, ULong64_t npatterns);
+  /// \brief Seed the predictor from the delayed seed known at some pattern number
+  void SetPredictorSeed(UInt_t seed, Long64_t pattern);
+
   VQwSubsystem&  operator=  (VQwSubsystem *value) override;
   VQwSubsystem&  operator+=  (VQwSubsystem *value) override;
 
@@ -257,6 +266,19 @@ class QwHelicityBase: public VQwSubsystemParity{
 
   void   ResetPredictor();
 
+  /// Seed the predictor at the current pattern by jumping from the known seed
+  void   JumpPredictor();
+  /// Compare jump-ahead with stepping the shift register one pattern at a time
+  Bool_t CheckJumpAhead(UInt_t seed);
+  /// Read the known predictor seed from the options
+  void   ProcessPredictorSeedOptions(QwOptions &options);
+  static void DefinePredictorSeedOptions(QwOptions &options);
+
+  Bool_t   fUsePredictorSeed{kFALSE}; ///< Jump from a known seed instead of collecting bits
+  UInt_t   fPredictorSeed{0};         ///< Delayed seed at fPredictorSeedPattern
+  Long64_t fPredictorSeedPattern{0};  ///< Pattern number of the known seed
+  Bool_t   fPrintPredictorSeed{kFALSE}; ///< Print the seed at the end of a run
+
   Bool_t Compare(VQwSubsystem *source);
 
   Int_t  fRandBits;//sets the random seed size 24bit/30bits
@@ -103,8 +103,8 @@ class QwHelicityPattern {
   void  CalculateAsymmetry();
   void GetTargetChargeStat(Double_t & asym, Double_t & error, Double_t & width);//retrieves the target charge asymmetry,asymmetry error ,asymmetry width
 
-  /// Enable/disable alternate asymmetry calculation
-  void  EnableAlternateAsymmetry(const Bool_t flag = kTRUE) { fEnableAlternateAsym = flag; };
+  /// Enable/disable alternate asymmetry calculation (not once the arrays are released)
+  void  EnableAlternateAsymmetry(const Bool_t flag = kTRUE) { fEnableAlternateAsym = flag && ! fAsymmetry1.empty(); };
   /// Disable alternate asymmetry calculation
   void  DisableAlternateAsymmetry() { fEnableAlternateAsym = kFALSE; };
   /// Status of alternate asymmetry calculation flag
@@ -131,10 +131,17 @@ class QwHelicityPattern {
   /// Status of storing pattern differences flag
   Bool_t IsDifferenceEnabled() { return fEnableDifference; };
 
-  /// Enable/disable storing pair differences
-  void  EnablePairs(const Bool_t flag = kTRUE) { fEnablePairs = flag; };
-  /// Disable storing pair differences
-  void  DisablePairs() { fEnablePairs = kFALSE; };
+  /// Enable/disable storing pair differences (not once the arrays are released)
+  void  EnablePairs(const Bool_t flag = kTRUE) { fEnablePairs = flag && ! fPairYield.empty(); };
+  /// Disable storing pair differences, and release the pair arrays
+  void  DisablePairs() {
+    fEnablePairs = kFALSE;
+    fPairYield.ReleaseSubsystems();
+    fPairDifference.ReleaseSubsystems();
+    fPairAsymmetry.ReleaseSubsystems();
+    fPatternPairSum.ReleaseSubsystems();
+    fPatternPairDifference.ReleaseSubsystems();
+  };
   /// Status of storing pair differences flag
   Bool_t IsPairsEnabled() { return fEnablePairs; };
 
@@ -254,6 +261,16 @@ class QwHelicityPattern {
   QwSubsystemArrayParity fPairDifference;
   QwSubsystemArrayParity fPairAsymmetry;
 
+  // Sums of the unscaled pair sums and helicity differences of the current
+  // pattern, from which the pattern yield and difference are derived
+  Bool_t fUsePairSums;
+  QwSubsystemArrayParity fPatternPairSum;
+  QwSubsystemArrayParity fPatternPairDifference;
+  size_t fPairsInPatternSums;
+  Bool_t fPatternPairSumsValid;
+  /// \brief Add an unscaled pair sum or difference to the sums of the pattern
+  void AddToPatternPairSum(QwSubsystemArrayParity& sum, const QwSubsystemArrayParity& value);
+
   // Burst sum/difference of the yield and asymmetry
   Int_t fBurstLength;
   Int_t fMaxBurstIndex;
@@ -109,6 +109,12 @@ void RandomizeMollerEvent(int helicity, const QwBeamCharge& charge, const QwBeam
   void IncrementErrorCounters(){
     fTriumf_ADC.IncrementErrorCounters();
   }
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override {
+    fTriumf_ADC.CollectErrorFlags(flags);
+  }
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override {
+    fTriumf_ADC.CollectChannels(channels);
+  }
   void PrintErrorCounters() const override;// report number of events failed due to HW and event cut failure
   Int_t SetSingleEventCuts(Double_t, Double_t);//set two limits
   /*! \brief Inherited from VQwDataElement to set the upper and lower limits (fULimit and fLLimit), stability % and the error flag on this channel */
@@ -152,7 +158,7 @@ void RandomizeMollerEvent(int helicity, const QwBeamCharge& charge, const QwBeam
   void Difference(const QwIntegrationPMT &value1, const QwIntegrationPMT &value2);
   void Ratio(QwIntegrationPMT &numer, QwIntegrationPMT &denom);
   void Scale(Double_t factor);
-  void Normalize(VQwDataElement* denom);
+  void Normalize(const VQwDataElement* denom);
   void AccumulateRunningSum(const QwIntegrationPMT& value, Int_t count=0, Int_t ErrorMask=0xFFFFFFF);
   void DeaccumulateRunningSum(QwIntegrationPMT& value, Int_t ErrorMask=0xFFFFFFF);
   void CalculateRunningAverage();
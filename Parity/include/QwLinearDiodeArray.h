@@ -96,6 +96,8 @@ class QwLinearDiodeArray : public VQwBPM {
   void    SetSingleEventCuts(TString ch_name, UInt_t errorflag,Double_t minX, Double_t maxX, Double_t stability, Double_t burplevel);
   void    SetEventCutMode(Int_t bcuts) override;
   void IncrementErrorCounters() override;
+  void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override;
+  void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override;
   void PrintErrorCounters() const override;// report number of events failed due to HW and event cut failure
   UInt_t GetEventcutErrorFlag() override;
   UInt_t UpdateErrorFlag() override;
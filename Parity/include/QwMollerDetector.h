@@ -101,6 +101,7 @@ class QwMollerDetector:
     Int_t ProcessEvBuffer(const ROCID_t roc_id, const BankID_t bank_id, UInt_t *buffer, UInt_t num_words) override;
     Int_t ProcessEvBuffer(UInt_t ev_type, const ROCID_t roc_id, const BankID_t bank_id, UInt_t* buffer, UInt_t num_words) override;
     void  ClearEventData() override;
+    void  ClearRunState() override;
     void  ProcessEvent() override;
 
     using VQwSubsystem::ConstructHistograms;
@@ -120,6 +121,7 @@ class QwMollerDetector:
     Int_t LoadEventCuts(TString filename) override;
     Bool_t  ApplySingleEventCuts() override;
     void IncrementErrorCounters() override {};
+    void CollectErrorFlags(std::vector<const UInt_t*>& /*flags*/) const override {};
     void PrintErrorCounters() const override;
     UInt_t GetEventcutErrorFlag() override;
 
@@ -39,7 +39,8 @@ class QwScaler: public VQwSubsystemParity, public MQwSubsystemCloneable<QwScaler
     QwScaler(const TString& name);
     /// Copy constructor
     QwScaler(const QwScaler& source)
-    : VQwSubsystem(source),VQwSubsystemParity(source)
+    : VQwSubsystem(source),VQwSubsystemParity(source),
+      fVerifyBankDecoder(kFALSE),fNumberOfComparisons(0),fNumberOfMismatches(0)
     {
       fScaler.resize(source.fScaler.size());
       for (size_t i = 0; i < fScaler.size(); i++) {
@@ -64,6 +65,7 @@ class QwScaler: public VQwSubsystemParity, public MQwSubsystemCloneable<QwScaler
     Int_t LoadInputParameters(TString pedestalfile) override;
 
     void  ClearEventData() override;
+    void  ClearRunState() override;
 
     Int_t ProcessConfigurationBuffer(const ROCID_t roc_id, const BankID_t bank_id, UInt_t* buffer, UInt_t num_words) override;
     Int_t ProcessEvBuffer(const ROCID_t roc_id, const BankID_t bank_id, UInt_t *buffer, UInt_t num_words) override;
@@ -108,6 +110,8 @@ class QwScaler: public VQwSubsystemParity, public MQwSubsystemCloneable<QwScaler
     };
 
     void IncrementErrorCounters() override;
+    /// No error counters and no error flags to update, nothing to collect
+    void CollectErrorFlags(std::vector<const UInt_t*>& /*flags*/) const override { };
 
     void PrintErrorCounters() const override;
     UInt_t GetEventcutErrorFlag() override;
@@ -148,6 +152,24 @@ class QwScaler: public VQwSubsystemParity, public MQwSubsystemCloneable<QwScaler
     std::vector< VQwScaler_Channel* > fScaler; // Raw channels
     std::vector< UInt_t > fBufferOffset; // Offset in scaler buffer
     std::vector< std::pair< VQwScaler_Channel*, double > > fNorm;
+
+    // Scaler words in each subbank, in buffer order, for decoding whole banks
+    struct BankWord {
+      UInt_t offset; // Offset in scaler buffer
+      UInt_t mask;   // Data mask of the scaler channel
+      UInt_t shift;  // Data shift of the scaler channel
+      Int_t  index;  // Index of the scaler channel
+    };
+    typedef std::map< Int_t, std::vector< BankWord > > Subbank_to_Words_Map_t;
+    Subbank_to_Words_Map_t fSubbank_Words;
+    // Decoded header and raw value of each word in the current bank
+    std::vector< UInt_t > fBankHeader;
+    std::vector< UInt_t > fBankValue;
+
+    // Self-test of the bank decoder against the per-channel decoder
+    Bool_t fVerifyBankDecoder;
+    UInt_t fNumberOfComparisons;
+    UInt_t fNumberOfMismatches;
 };
 
 // Register this subsystem with the factory
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <memory>
+#include <typeinfo>
 #include <vector>
 #include <TTree.h>
 
@@ -136,13 +138,33 @@ class QwSubsystemArrayParity: public QwSubsystemArray {
 
     void UpdateErrorFlag(UInt_t errflag){fErrorFlag |= errflag;};
 
+    /// \brief Return the OR of the error flags of all channels in a
+    ///        subsystem, or kErrorSummaryUnknown if they are not known
+    UInt_t GetErrorSummary(size_t i) const;
+    /// Summary of a subsystem that does not collect its error flags
+    static const UInt_t kErrorSummaryUnknown = 0xFFFFFFFF;
+
     /// \brief Print value of all channels
     void PrintValue() const;
 
     void WritePromptSummary(QwPromptSummary *ps, TString type);
 
+    /// \brief Stop computing the derived quantities which nothing reads
+    void DisableUnusedDerivedQuantities();
+
     virtual Bool_t CheckForEndOfBurst() const;
 
+    /// \brief Whether the event data of a subsystem is kept in packed records
+    Bool_t IsPackable(size_t i) const;
+    /// \brief Append the event data of the packable subsystems to a packed record
+    void PackEventData(std::vector<char>& record) const;
+    /// \brief Restore the event data of the packable subsystems from a packed record
+    void UnpackEventData(const char* record);
+    /// \brief Event cut error flag of a packed record
+    static UInt_t GetPackedEventcutErrorFlag(const char* record);
+    /// \brief Add error flags to the event cut error flag of a packed record
+    static void UpdatePackedErrorFlag(char* record, UInt_t errflag);
+
   public:
   void LoadMockDataParameters(std::string mapfile);
   protected:
@@ -155,4 +177,48 @@ class QwSubsystemArrayParity: public QwSubsystemArray {
     UInt_t fErrorFlag;
     Int_t  fErrorFlagTreeIndex;
 
+  private:
+
+    /// \brief Parity subsystem i, cast once instead of on every call
+    VQwSubsystemParity* GetParitySubsystem(size_t i) const {
+      if (fParitySubsystem.size() != size()) BuildParitySubsystemTable();
+      return fParitySubsystem[i];
+    };
+    /// \brief Build the table of the subsystems as parity subsystems
+    void BuildParitySubsystemTable() const;
+
+    /// Types of the subsystems of an array, shared by the arrays which
+    /// were copy-constructed from it
+    struct SubsystemLayout {
+      std::vector<const std::type_info*> fTypes;
+    };
+    /// \brief Return the layout of this array, rebuilt if subsystems were added
+    std::shared_ptr<const SubsystemLayout> GetLayout() const;
+    /// \brief Whether both arrays are known to hold the same subsystem types
+    Bool_t HasSameLayout(const QwSubsystemArrayParity& value) const;
+
+    /// Subsystems cast to parity subsystems
+    mutable std::vector<VQwSubsystemParity*> fParitySubsystem;
+    /// Layout verified when this array was copied, or built on first use
+    mutable std::shared_ptr<const SubsystemLayout> fLayout;
+
+    /// \brief Build the table of channel error flags of all subsystems
+    void BuildErrorFlagTable() const;
+
+    /// Addresses of the error flags of all channels, per subsystem; built
+    /// on first use and never copied, since it points into this array
+    mutable std::vector< std::vector<const UInt_t*> > fErrorFlagTable;
+    /// Whether a subsystem enumerated all its channels
+    mutable std::vector<Bool_t> fErrorFlagTableComplete;
+
+    /// \brief Build the table of the channels of the packable subsystems
+    void BuildPackedChannelTable() const;
+
+    /// Channels holding the event data of each subsystem, empty for the
+    /// subsystems which are not packable; built on first use and never
+    /// copied, since it points into this array
+    mutable std::vector< std::vector<VQwHardwareChannel*> > fPackedChannelTable;
+    /// Whether a subsystem is packable
+    mutable std::vector<Bool_t> fPackedChannelTableComplete;
+
 }; // class QwSubsystemArrayParity
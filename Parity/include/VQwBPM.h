@@ -12,6 +12,9 @@
 
 #pragma once
 
+// System headers
+#include <atomic>
+
 // ROOT headers
 #include <TTree.h>
 #include <TMath.h>
@@ -295,6 +298,11 @@ public:
   static VQwBPM* CreateCombo(TString subsystemname, TString type, TString name);
   static VQwBPM* CreateCombo(const VQwBPM& source);
 
+  /// \brief Select the fused position kernel of the stripline BPMs and its self-test
+  static void SetFusedKernel(Bool_t use, Bool_t verify);
+  /// \brief Report the result of the fused kernel self-test
+  static void PrintFusedKernelReport();
+
   private:
 
   void InitializeChannel_base() {
@@ -349,6 +357,12 @@ public:
 
   const static Bool_t bDEBUG=kFALSE;//debugging display purposes
 
+  // Fused stripline position kernel and its self-test against the channel arithmetic
+  static Bool_t fUseFusedKernel;
+  static Bool_t fVerifyFusedKernel;
+  static std::atomic<UInt_t> fFusedKernelComparisons;
+  static std::atomic<UInt_t> fFusedKernelMismatches;
+
 };
 
 typedef std::shared_ptr<VQwBPM> VQwBPM_ptr;
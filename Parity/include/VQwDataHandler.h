@@ -87,6 +87,17 @@ class VQwDataHandler:  virtual public VQwDataHandlerCloneable, public MQwPublish
       CalculateRunningAverage();
     };
 
+    /// \brief Take a snapshot of the accumulated state, to be finished by
+    ///        FinishSnapshot() on a background thread.  Handlers which do not
+    ///        support this return false and are finished synchronously.
+    virtual Bool_t SnapshotDataHandler() { return kFALSE; };
+    /// \brief Finish the snapshot; called on the background thread and must
+    ///        not touch the trees of the shared output files
+    virtual void FinishSnapshot() { };
+    /// \brief Fill the results of the finished snapshot into the trees;
+    ///        called on the thread of the event loop
+    virtual void FillSnapshot() { };
+
     ~VQwDataHandler() override;
 
     TString GetName(){return fName;}
@@ -27,6 +27,7 @@
 #include "VQwSubsystemParity.h"
 #include "QwIntegrationPMT.h"
 #include "QwCombinedPMT.h"
+#include "QwMollerADC_Channel.h"
 
 
 class QwDetectorArrayID {
@@ -134,6 +135,8 @@ class VQwDetectorArray: virtual public VQwSubsystemParity {
     Bool_t  CheckForBurpFail(const VQwSubsystem *subsys) override;
 
     void IncrementErrorCounters() override;
+    void CollectErrorFlags(std::vector<const UInt_t*>& flags) const override;
+    void CollectChannels(std::vector<VQwHardwareChannel*>& channels) override;
     void PrintErrorCounters() const override;// report number of events failed due to HW and event cut failure
     UInt_t GetEventcutErrorFlag() override;//return the error flag
 
@@ -148,6 +151,7 @@ class VQwDetectorArray: virtual public VQwSubsystemParity {
     Bool_t IsGoodEvent();
 
     void  ProcessEvent() override;
+    void  BindExternalValues() override;
     void  ExchangeProcessedData() override;
     void  ProcessEvent_2() override;
 
@@ -198,7 +202,7 @@ class VQwDetectorArray: virtual public VQwSubsystemParity {
 
     void Ratio(VQwSubsystem* numer, VQwSubsystem* denom) override;
     void Scale(Double_t factor) override;
-    void Normalize(VQwDataElement* denom);
+    void Normalize(const VQwDataElement* denom);
 
     void AccumulateRunningSum(VQwSubsystem* value, Int_t count=0, Int_t ErrorMask=0xFFFFFFF) override;
     //remove one entry from the running sums for devices
@@ -247,6 +251,10 @@ class VQwDetectorArray: virtual public VQwSubsystemParity {
     std::vector <QwCombinedPMT> fCombinedPMT;
     std::vector <QwDetectorArrayID> fMainDetID;
 
+    /// First MollerADC record in each subbank (-1 if none), and the decoder for the current bank
+    std::vector <Int_t> fMollerADCFirstWord;
+    QwMollerADC_BankDecoder fMollerADCBank;
+
 
 
 
@@ -263,6 +271,13 @@ class VQwDetectorArray: virtual public VQwSubsystemParity {
  protected:
 
     QwBeamCharge   fTargetCharge;
+    const VQwHardwareChannel* fTargetChargeSource{nullptr}; ///< Bound q_targ channel of the beamline
+    Bool_t fCopyTargetCharge{kFALSE}; ///< Normalize by the copy in fTargetCharge (q_targ of another type)
+    /// \brief Beam charge by which the detectors are normalized
+    const QwBeamCharge* GetNormalizationCharge() const {
+      return fCopyTargetCharge? &fTargetCharge:
+        dynamic_cast<const QwBeamCharge*>(fTargetChargeSource);
+    };
     QwBeamPosition fTargetX;
     QwBeamPosition fTargetY;
     QwBeamAngle    fTargetXprime;
@@ -12,6 +12,7 @@
 
 // Qweak headers
 #include "VQwSubsystem.h"
+#include "VQwHardwareChannel.h"
 #include "QwParameterFile.h"
 
 // Forward declarations
@@ -135,6 +136,46 @@ class VQwSubsystemParity: virtual public VQwSubsystem {
     /// \brief update the error flag in the subsystem level from the top level routines related to stability checks. This will uniquely update the errorflag at each channel based on the error flag in the corresponding channel in the ev_error subsystem
     virtual void UpdateErrorFlag(const VQwSubsystem *ev_error) = 0;
 
+    /// \brief Append the addresses of the error flags of all channels that
+    ///        IncrementErrorCounters and UpdateErrorFlag(ev_error) read.
+    ///        The default appends a null pointer, so that the subsystem is
+    ///        never skipped as clean (see QwSubsystemArrayParity::GetErrorSummary).
+    virtual void CollectErrorFlags(std::vector<const UInt_t*>& flags) const {
+      flags.push_back(nullptr);
+    };
+
+    /// \brief Append the channels that hold all the event data that
+    ///        operator= copies, in a fixed order, so that the event ring can
+    ///        keep events of this subsystem as packed records.  The default
+    ///        appends a null pointer; the ring then keeps copies instead.
+    virtual void CollectChannels(std::vector<VQwHardwareChannel*>& channels) {
+      channels.push_back(nullptr);
+    };
+    /// \brief Clear the run state of the collected channels (e.g. the history
+    ///        of their hardware checks) and the event data.  Subsystems that
+    ///        do not collect their channels override this instead.
+    void ClearRunState() override {
+      std::vector<VQwHardwareChannel*> channels;
+      CollectChannels(channels);
+      for (size_t i = 0; i < channels.size(); i++)
+        if (channels[i]) channels[i]->ClearRunState();
+      ClearEventData();
+    };
+    /// \brief Append the event data in the collected channels to a packed record
+    void PackEventData(const std::vector<VQwHardwareChannel*>& channels,
+                       std::vector<char>& record) const {
+      record.push_back(HasDataLoaded());
+      for (size_t i = 0; i < channels.size(); i++)
+        channels[i]->PackEventData(record);
+    };
+    /// \brief Restore the event data in the collected channels from a packed record
+    void UnpackEventData(const std::vector<VQwHardwareChannel*>& channels,
+                         const char*& record) {
+      SetDataLoaded(*record++ != 0);
+      for (size_t i = 0; i < channels.size(); i++)
+        channels[i]->UnpackEventData(record);
+    };
+
 
     /// \brief Blind the asymmetry of this subsystem
     virtual void Blind(const QwBlinder * /*blinder*/) { return; };
@@ -146,6 +187,10 @@ class VQwSubsystemParity: virtual public VQwSubsystem {
 
     virtual void WritePromptSummary(QwPromptSummary * /*ps*/, TString /*type*/) {};
 
+    /// \brief Stop computing derived quantities which no output, cut or
+    /// request reads; called once all outputs and handlers are connected
+    virtual void DisableUnusedDerivedQuantities() { };
+
 
     virtual Bool_t CheckForEndOfBurst() const {return kFALSE;};
 
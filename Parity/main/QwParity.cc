@@ -11,6 +11,7 @@
 #include <fstream>
 #include <vector>
 #include <new>
+#include <memory>
 
 // ROOT headers
 #include "Rtypes.h"
@@ -25,6 +26,7 @@
 // Qweak headers
 #include "QwLog.h"
 #include "QwRootFile.h"
+#include "QwSharedMemoryWriter.h"
 #include "QwOptionsParity.h"
 #include "QwEventBuffer.h"
 #ifdef __USE_DATABASE__
@@ -71,6 +73,8 @@ Int_t main(Int_t argc, Char_t* argv[])
   gQwOptions.AddOptions()("print-errorcounters", po::value<bool>()->default_bool_value(true), "Print summary of error counters");
   gQwOptions.AddOptions()("write-promptsummary", po::value<bool>()->default_bool_value(false), "Write PromptSummary");
   gQwOptions.AddOptions()("callgrind-instr-start-event-loop", po::value<bool>()->default_bool_value(false), "Start callgrind instrumentation with main event loop (with --instr-atstart=no)");
+  gQwOptions.AddOptions()("config-snapshot", po::value<std::string>()->default_value(""), "Configuration snapshot file with the parameter files for a run range (written when missing or out of date); saves finding and reading the files, but all objects are still constructed from them for each run");
+  gQwOptions.AddOptions()("reuse-analyzer-state", po::value<bool>()->default_bool_value(false), "Keep the detectors and EPICS map of the previous run when no parameter file changed (the helicity pattern, event ring, data handlers, ROOT files and histograms are still constructed for each run)");
   gQwOptions.AddOptions()("callgrind-instr-stop-event-loop", po::value<bool>()->default_bool_value(false), "Stop callgrind instrumentation with main event loop (with --instr-atstart=no)");
 
   ///  Without anything, print usage
@@ -98,6 +102,9 @@ Int_t main(Int_t argc, Char_t* argv[])
   gQwLog.ProcessOptions(&gQwOptions);
 
 
+  ///  Configuration snapshot for fast startup
+  std::string config_snapshot = gQwOptions.GetValue<std::string>("config-snapshot");
+
   ///  Create the event buffer
   QwEventBuffer eventbuffer;
   eventbuffer.ProcessOptions(gQwOptions);
@@ -109,6 +116,11 @@ Int_t main(Int_t argc, Char_t* argv[])
 
   //  QwPromptSummary promptsummary;
 
+  ///  Objects constructed from the parameter files, kept between runs
+  ///  with reuse-analyzer-state when no parameter file changed
+  std::unique_ptr<QwEPICSEvent> epicsevent_kept;
+  std::unique_ptr<QwSubsystemArrayParity> detectors_kept;
+
   ///  Start loop over all runs
   Int_t run_number = 0;
   while (eventbuffer.OpenNextStream() == CODA_OK) {
@@ -120,23 +132,45 @@ Int_t main(Int_t argc, Char_t* argv[])
 
     ///  Set the current event number for parameter file lookup
     QwParameterFile::SetCurrentRunNumber(run_number);
+    QwParameterFile::StartConfigurationRecord();
+    if (config_snapshot.size() > 0)
+      QwParameterFile::LoadSnapshot(config_snapshot);
     //  Parse the options again, in case there are run-ranged config files
     gQwOptions.Parse(kTRUE);
     eventbuffer.ProcessOptions(gQwOptions);
 
+    ///  Check whether the parameter files of the previous run, including
+    ///  the config files, are still the ones for this run
+    Bool_t reuse_analyzer = detectors_kept && epicsevent_kept
+      && gQwOptions.GetValue<bool>("reuse-analyzer-state")
+      && QwParameterFile::IsConfigurationUnchanged();
+    if (reuse_analyzer)
+      QwParameterFile::KeepPreviousConfiguration();
+
     //    if (gQwOptions.GetValue<bool>("write-promptsummary")) {
     QwPromptSummary promptsummary(run_number, eventbuffer.GetSegmentNumber());
     //    }
-    ///  Create an EPICS event
-    QwEPICSEvent epicsevent;
-    epicsevent.ProcessOptions(gQwOptions);
-    epicsevent.LoadChannelMap("EpicsTable.map");
-
-
-    ///  Load the detectors from file
-    QwSubsystemArrayParity detectors(gQwOptions);
-    detectors.ProcessOptions(gQwOptions);
-    detectors.ListPublishedValues();
+    if (reuse_analyzer) {
+      ///  Keep the EPICS event and the detectors, but not their data
+      QwMessage << "Parameter files unchanged for run " << run_number
+                << "; reusing the detectors of the previous run" << QwLog::endl;
+      epicsevent_kept->ResetCounters();
+      detectors_kept->ClearRunState();
+    } else {
+      ///  Create an EPICS event (after the one of the previous run is gone)
+      epicsevent_kept.reset();
+      epicsevent_kept.reset(new QwEPICSEvent());
+      epicsevent_kept->ProcessOptions(gQwOptions);
+      epicsevent_kept->LoadChannelMap("EpicsTable.map");
+
+      ///  Load the detectors from file (after the previous ones are gone)
+      detectors_kept.reset();
+      detectors_kept.reset(new QwSubsystemArrayParity(gQwOptions));
+      detectors_kept->ProcessOptions(gQwOptions);
+      detectors_kept->ListPublishedValues();
+    }
+    QwEPICSEvent& epicsevent = *epicsevent_kept;
+    QwSubsystemArrayParity& detectors = *detectors_kept;
 
     /// Create event-based correction subsystem
     //    TString name = "EvtCorrector";
@@ -158,7 +192,7 @@ Int_t main(Int_t argc, Char_t* argv[])
     /// Create the data handler arrays
     QwDataHandlerArray datahandlerarray_evt(gQwOptions,ringoutput,run_label);
     QwDataHandlerArray datahandlerarray_mul(gQwOptions,helicitypattern,run_label);
-    QwDataHandlerArray datahandlerarray_burst(gQwOptions,helicitypattern,run_label);
+    QwDataHandlerArray datahandlerarray_burst(gQwOptions,helicitypattern,run_label,kTRUE);
 
     ///  Create the burst sum
     QwHelicityPattern patternsum_per_burst(helicitypattern);
@@ -176,6 +210,10 @@ Int_t main(Int_t argc, Char_t* argv[])
     database.SetupOneRun(eventbuffer);
     #endif // __USE_DATABASE__
 
+    //  Shared-memory live output, one region for all files of the run
+    std::unique_ptr<QwSharedMemoryWriter> sharedmemory(
+      QwRootFile::CreateSharedMemoryWriter(run_label));
+
     //  Open the ROOT file (close when scope ends)
     QwRootFile *treerootfile  = NULL;
     QwRootFile *burstrootfile = NULL;
@@ -186,6 +224,7 @@ Int_t main(Int_t argc, Char_t* argv[])
 
       treerootfile  = new QwRootFile(run_label);
       burstrootfile = historootfile = treerootfile;
+      treerootfile->SetSharedMemoryWriter(sharedmemory.get());
       //  Construct a tree which contains map file names which are used to analyze data
       treerootfile->WriteParamFileList("mapfiles", detectors);
 
@@ -194,6 +233,9 @@ Int_t main(Int_t argc, Char_t* argv[])
       treerootfile  = new QwRootFile(run_label + ".trees");
       burstrootfile = new QwRootFile(run_label + ".bursts");
       historootfile = new QwRootFile(run_label + ".histos");
+      treerootfile->SetSharedMemoryWriter(sharedmemory.get());
+      burstrootfile->SetSharedMemoryWriter(sharedmemory.get());
+      historootfile->SetSharedMemoryWriter(sharedmemory.get());
 
       //  Construct a tree which contains map file names which are used to analyze data
       detectors.PrintParamFileList();
@@ -256,6 +298,15 @@ Int_t main(Int_t argc, Char_t* argv[])
     burstrootfile->ConstructNTupleFields("bursts", "Burst running sum RNTuple", burstsum, "|stat");
 #endif
 
+    //  Stop computing the derived quantities which nothing reads,
+    //  unless the prompt summary or the database read all of them
+    Bool_t read_all_derived = gQwOptions.GetValue<bool>("write-promptsummary");
+    #ifdef __USE_DATABASE__
+    read_all_derived |= database.AllowsWriteAccess();
+    #endif // __USE_DATABASE__
+    if (! read_all_derived)
+      detectors.DisableUnusedDerivedQuantities();
+
     // Summarize the ROOT file structure
     //treerootfile->PrintTrees();
     //treerootfile->PrintDirs();
@@ -286,14 +337,12 @@ Int_t main(Int_t argc, Char_t* argv[])
     //  the blinder, but only for disk files, not online.
     if (! eventbuffer.IsOnline() ){
       QwMessage << "Finding first EPICS event" << QwLog::endl;
-      while (eventbuffer.GetNextEvent() == CODA_OK) {
-	if (eventbuffer.IsEPICSEvent()) {
-	  eventbuffer.FillEPICSData(epicsevent);
-	  if (epicsevent.HasDataLoaded()) {
-	    helicitypattern.UpdateBlinder(epicsevent);
-	    // and break out of this event loop
-	    break;
-	  }
+      while (eventbuffer.GetNextEPICSEvent() == CODA_OK) {
+	eventbuffer.FillEPICSData(epicsevent);
+	if (epicsevent.HasDataLoaded()) {
+	  helicitypattern.UpdateBlinder(epicsevent);
+	  // and break out of this event loop
+	  break;
 	}
       }
       epicsevent.ResetCounters();
@@ -302,6 +351,12 @@ Int_t main(Int_t argc, Char_t* argv[])
       eventbuffer.ReOpenStream();
     }
 
+    if (config_snapshot.size() > 0)
+      QwParameterFile::SaveSnapshot(config_snapshot);
+    QwVerbose << "Parameter file lookups: " << QwParameterFile::GetNumberOfResolutions()
+              << " files in " << QwParameterFile::GetResolutionTime() * 1e3 << " ms"
+              << QwLog::endl;
+
     // Start event loop instrumentation
 #ifdef CALLGRIND_START_INSTRUMENTATION
     if (gQwOptions.GetValue<bool>("callgrind-instr-start-event-loop")) {
@@ -483,8 +538,8 @@ Int_t main(Int_t argc, Char_t* argv[])
                 burstrootfile->FillNTuple("burst");
 #endif
 
-                // Finish data handler for burst
-                datahandlerarray_burst.FinishDataHandler();
+                // Finish data handler for burst, in the background if enabled
+                datahandlerarray_burst.FinishDataHandlerInBackground();
 
                 // Fill data handler histograms
                 burstrootfile->FillHistograms(datahandlerarray_burst);
@@ -557,8 +612,8 @@ Int_t main(Int_t argc, Char_t* argv[])
       burstrootfile->FillNTuple("burst");
 #endif
 
-      // Finish data handler for burst
-      datahandlerarray_burst.FinishDataHandler();
+      // Finish data handler for burst, in the background if enabled
+      datahandlerarray_burst.FinishDataHandlerInBackground();
 
       // Fill data handler histograms
       burstrootfile->FillHistograms(datahandlerarray_burst);
@@ -573,6 +628,9 @@ Int_t main(Int_t argc, Char_t* argv[])
       patternsum_per_burst.PrintIndexMapFile(run_number);
     }
 
+    //  Fill the bursts still being finished in the background
+    datahandlerarray_burst.FillFinishedDataHandlers();
+
     //  Perform actions at the end of the event loop on the
     //  detectors object, which ought to have handles for the
     //  MPS based histograms.
@@ -636,6 +694,9 @@ Int_t main(Int_t argc, Char_t* argv[])
     //  Construct objects
     burstrootfile->ConstructObjects("objects", helicitypattern);
 
+    //  Publish the final histograms while the files still hold them
+    if (sharedmemory) sharedmemory->PublishHistograms();
+
     /*  Write to the root file, being sure to delete the old cycles  *
      *  which were written by Autosave.                              *
      *  Doing this will remove the multiple copies of the ntuples    *
@@ -691,6 +752,12 @@ Int_t main(Int_t argc, Char_t* argv[])
       ringoutput.PrintErrorCounters();
     }
 
+    //  Print the heap footprint of the subsystem copies
+    QwSubsystemArray::PrintMemoryReport();
+
+    //  Print the result of the stripline BPM kernel self-test
+    VQwBPM::PrintFusedKernelReport();
+
     if (gQwOptions.GetValue<bool>("write-promptsummary")) {
       //      runningsum.WritePromptSummary(&promptsummary, "yield");
       // runningsum.WritePromptSummary(&promptsummary, "asymmetry");
@@ -26,10 +26,62 @@ LinRegBevPeb::LinRegBevPeb()
 //=================================================
 LinRegBevPeb::LinRegBevPeb(const LinRegBevPeb& source)
 : nP(source.nP),nY(source.nY),
-  fErrorFlag(-1),
-  fGoodEventNumber(0)
+  fErrorFlag(source.fErrorFlag),
+  fGoodEventNumber(source.fGoodEventNumber),
+  mRPY(source.mRPY), mRYP(source.mRYP),
+  mRPP(source.mRPP), mRYY(source.mRYY),
+  mRYYp(source.mRYYp),
+  mVPY(source.mVPY), mVYP(source.mVYP),
+  mVPP(source.mVPP), mVYY(source.mVYY),
+  mVYYp(source.mVYYp),
+  mVP(source.mVP), mVY(source.mVY),
+  mVYp(source.mVYp),
+  mSPY(source.mSPY), mSYP(source.mSYP),
+  mSPP(source.mSPP), mSYY(source.mSYY),
+  mSYYp(source.mSYYp),
+  mSP(source.mSP), mSY(source.mSY),
+  mSYp(source.mSYp),
+  mMP(source.mMP), mMY(source.mMY), mMYp(source.mMYp),
+  Axy(source.Axy), Ayx(source.Ayx), dAxy(source.dAxy), dAyx(source.dAyx)
+{ }
+
+//=================================================
+//=================================================
+/// Copy a matrix or vector, keeping the storage when the shapes agree
+template<class T>
+static void AssignInPlace(T& target, const T& source)
 {
-  QwMessage << fGoodEventNumber << QwLog::endl;
+  target.ResizeTo(source);
+  target = source;
+}
+
+LinRegBevPeb& LinRegBevPeb::operator=(const LinRegBevPeb& source)
+{
+  if (this == &source) return *this;
+  nP = source.nP;
+  nY = source.nY;
+  fErrorFlag = source.fErrorFlag;
+  fGoodEventNumber = source.fGoodEventNumber;
+  for (auto m: { std::make_pair(&mRPY, &source.mRPY), std::make_pair(&mRYP, &source.mRYP),
+                 std::make_pair(&mRPP, &source.mRPP), std::make_pair(&mRYY, &source.mRYY),
+                 std::make_pair(&mRYYp, &source.mRYYp),
+                 std::make_pair(&mVPY, &source.mVPY), std::make_pair(&mVYP, &source.mVYP),
+                 std::make_pair(&mVPP, &source.mVPP), std::make_pair(&mVYY, &source.mVYY),
+                 std::make_pair(&mVYYp, &source.mVYYp),
+                 std::make_pair(&mSPY, &source.mSPY), std::make_pair(&mSYP, &source.mSYP),
+                 std::make_pair(&mSPP, &source.mSPP), std::make_pair(&mSYY, &source.mSYY),
+                 std::make_pair(&mSYYp, &source.mSYYp),
+                 std::make_pair(&Axy, &source.Axy), std::make_pair(&Ayx, &source.Ayx),
+                 std::make_pair(&dAxy, &source.dAxy), std::make_pair(&dAyx, &source.dAyx) })
+    AssignInPlace(*m.first, *m.second);
+  for (auto v: { std::make_pair(&mVP, &source.mVP), std::make_pair(&mVY, &source.mVY),
+                 std::make_pair(&mVYp, &source.mVYp),
+                 std::make_pair(&mSP, &source.mSP), std::make_pair(&mSY, &source.mSY),
+                 std::make_pair(&mSYp, &source.mSYp),
+                 std::make_pair(&mMP, &source.mMP), std::make_pair(&mMY, &source.mMY),
+                 std::make_pair(&mMYp, &source.mMYp) })
+    AssignInPlace(*v.first, *v.second);
+  return *this;
 }
 
 //=================================================
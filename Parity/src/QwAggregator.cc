@@ -0,0 +1,307 @@
+/*!
+ * \file   QwAggregator.cc
+ * \brief  Implementation of the run and minirun aggregator data handler
+ */
+
+#include "QwAggregator.h"
+
+// System headers
+#include <algorithm>
+#include <cmath>
+
+// ROOT headers
+#include "TFile.h"
+#include "TTree.h"
+
+// Qweak headers
+#include "QwParameterFile.h"
+
+/// Value of the aggregator for quantities that could not be determined
+static const Double_t kAggregatorPlaceholder = -1.0e6;
+
+void QwAggregator::Moments::Add(Double_t x)
+{
+  fN += 1.0;
+  Double_t delta = x - fMean;
+  fMean += delta / fN;
+  fM2 += delta * (x - fMean);
+}
+
+void QwAggregator::Moments::Merge(const Moments& value)
+{
+  if (value.fN == 0.0) return;
+  Double_t n = fN + value.fN;
+  Double_t delta = value.fMean - fMean;
+  fMean += delta * value.fN / n;
+  fM2 += value.fM2 + delta * delta * fN * value.fN / n;
+  fN = n;
+}
+
+void QwAggregator::CoMoments::Add(Double_t x, Double_t y)
+{
+  // The co-moment uses the old mean of one and the new mean of the other
+  Double_t dx = x - fX.fMean;
+  fX.Add(x);
+  fY.Add(y);
+  fCXY += dx * (y - fY.fMean);
+}
+
+void QwAggregator::CoMoments::Merge(const CoMoments& value)
+{
+  if (value.fX.fN == 0.0) return;
+  Double_t n = fX.fN + value.fX.fN;
+  fCXY += value.fCXY + (value.fX.fMean - fX.fMean) * (value.fY.fMean - fY.fMean)
+    * fX.fN * value.fX.fN / n;
+  fX.Merge(value.fX);
+  fY.Merge(value.fY);
+}
+
+
+/// \brief Constructor with name
+QwAggregator::QwAggregator(const TString& name)
+: VQwDataHandler(name),
+  fOutputPath("."),
+  fWriteMiniruns(kTRUE),
+  fMinirunStarted(kFALSE)
+{
+  ParseSeparator = "_";
+}
+
+QwAggregator::QwAggregator(const QwAggregator &source)
+: VQwDataHandler(source),
+  fOutputPath(source.fOutputPath),
+  fWriteMiniruns(source.fWriteMiniruns),
+  fMinirunStarted(kFALSE),
+  fVariableFull(source.fVariableFull),
+  fVariableType(source.fVariableType),
+  fVariableName(source.fVariableName),
+  fVariable(source.fVariable),
+  fCorrelation(source.fCorrelation),
+  fMinirunMoments(source.fVariable.size()),
+  fRunMoments(source.fVariable.size()),
+  fMinirunCoMoments(source.fCorrelation.size()),
+  fRunCoMoments(source.fCorrelation.size())
+{
+}
+
+void QwAggregator::ParseConfigFile(QwParameterFile& file)
+{
+  VQwDataHandler::ParseConfigFile(file);
+  file.PopValue("aggregator-path", fOutputPath);
+  file.PopValue("write-miniruns", fWriteMiniruns);
+}
+
+/** Load the channel map
+ *
+ * @param mapfile Filename of map file
+ * @return Zero when success
+ */
+Int_t QwAggregator::LoadChannelMap(const std::string& mapfile)
+{
+  // Open the file
+  QwParameterFile map(mapfile);
+
+  // Add a variable, or find it when already added
+  auto add = [this](const std::string& variable) {
+    auto found = std::find(fVariableFull.begin(), fVariableFull.end(), variable);
+    if (found != fVariableFull.end())
+      return static_cast<size_t>(found - fVariableFull.begin());
+    std::pair<EQwHandleType,std::string> type_name = ParseHandledVariable(variable);
+    fVariableFull.push_back(variable);
+    fVariableType.push_back(type_name.first);
+    fVariableName.push_back(type_name.second);
+    return fVariableFull.size() - 1;
+  };
+
+  while (map.ReadNextLine()) {
+    // Throw away comments, whitespace, empty lines
+    map.TrimComment();
+    map.TrimWhitespace();
+    if (map.LineIsEmpty()) continue;
+    // First token is either a variable or the keyword for a correlation
+    std::string token = map.GetNextToken(" ");
+    if (token == "cor") {
+      std::string dv = map.GetNextToken(" ");
+      std::string iv = map.GetNextToken(" ");
+      if (dv.empty() || iv.empty()) {
+        QwWarning << "QwAggregator: correlation needs a dependent and an "
+                  << "independent variable: " << map.GetLine() << QwLog::endl;
+        continue;
+      }
+      size_t i = add(dv);
+      size_t j = add(iv);
+      fCorrelation.push_back(std::make_pair(i, j));
+    } else {
+      add(token);
+    }
+  }
+
+  fMinirunMoments.assign(fVariableFull.size(), Moments());
+  fRunMoments.assign(fVariableFull.size(), Moments());
+  fMinirunCoMoments.assign(fCorrelation.size(), CoMoments());
+  fRunCoMoments.assign(fCorrelation.size(), CoMoments());
+  return 0;
+}
+
+Int_t QwAggregator::ConnectChannels(
+    QwSubsystemArrayParity& yield,
+    QwSubsystemArrayParity& asym,
+    QwSubsystemArrayParity& diff)
+{
+  fVariable.assign(fVariableFull.size(), NULL);
+  for (size_t i = 0; i < fVariableFull.size(); i++) {
+    const VQwHardwareChannel* ptr = RequestExternalPointer(fVariableFull.at(i));
+    if (ptr == NULL) {
+      switch (fVariableType.at(i)) {
+      case kHandleTypeYield:
+        ptr = yield.RequestExternalPointer(fVariableName.at(i));
+        break;
+      case kHandleTypeAsym:
+        ptr = asym.RequestExternalPointer(fVariableName.at(i));
+        break;
+      case kHandleTypeDiff:
+        ptr = diff.RequestExternalPointer(fVariableName.at(i));
+        break;
+      default:
+        QwWarning << "QwAggregator: variable " << fVariableFull.at(i)
+                  << " is not a yield, asymmetry or difference."
+                  << QwLog::endl;
+        break;
+      }
+    }
+    if (ptr == NULL) {
+      QwWarning << "QwAggregator: variable " << fVariableFull.at(i)
+                << " could not be found; it will be written as "
+                << kAggregatorPlaceholder << "." << QwLog::endl;
+    }
+    fVariable[i] = ptr;
+  }
+  return 0;
+}
+
+void QwAggregator::ProcessData()
+{
+  fMinirunStarted = kTRUE;
+
+  // Only patterns passing the event cuts, as the ErrorFlag==0 cut
+  if (GetEventcutErrorFlag() != 0) return;
+
+  for (size_t i = 0; i < fVariable.size(); i++) {
+    if (fVariable[i] == NULL) continue;
+    fMinirunMoments[i].Add(fVariable[i]->GetValue());
+  }
+  for (size_t k = 0; k < fCorrelation.size(); k++) {
+    const VQwHardwareChannel* dv = fVariable[fCorrelation[k].first];
+    const VQwHardwareChannel* iv = fVariable[fCorrelation[k].second];
+    if (dv == NULL || iv == NULL) continue;
+    fMinirunCoMoments[k].Add(iv->GetValue(), dv->GetValue());
+  }
+}
+
+void QwAggregator::UpdateBurstCounter(Short_t burstcounter)
+{
+  if (burstcounter != fBurstCounter) FinishMinirun();
+  fBurstCounter = burstcounter;
+}
+
+void QwAggregator::FinishDataHandler()
+{
+  FinishMinirun();
+
+  Int_t run = run_label.Atoi();
+  WriteAggregates(fOutputPath + Form("/run_aggregator_%d.root", run),
+                  kAggregatorPlaceholder, fRunMoments, fRunCoMoments);
+}
+
+void QwAggregator::FinishMinirun()
+{
+  if (! fMinirunStarted) return;
+
+  if (fWriteMiniruns) {
+    Int_t run = run_label.Atoi();
+    WriteAggregates(fOutputPath + Form("/minirun_aggregator_%d_%d.root", run, fBurstCounter),
+                    fBurstCounter, fMinirunMoments, fMinirunCoMoments);
+  }
+
+  // Merge into the run and start the next minirun
+  for (size_t i = 0; i < fRunMoments.size(); i++) {
+    fRunMoments[i].Merge(fMinirunMoments[i]);
+    fMinirunMoments[i] = Moments();
+  }
+  for (size_t k = 0; k < fRunCoMoments.size(); k++) {
+    fRunCoMoments[k].Merge(fMinirunCoMoments[k]);
+    fMinirunCoMoments[k] = CoMoments();
+  }
+  fMinirunStarted = kFALSE;
+}
+
+/**
+ * Write one entry into a new agg tree, with the run identification and the
+ * branches of camguin.  The split number is the segment of the run label
+ * if the segments are replayed separately.
+ */
+void QwAggregator::WriteAggregates(
+    const std::string& filename,
+    Double_t minirun,
+    const std::vector<Moments>& moments,
+    const std::vector<CoMoments>& comoments) const
+{
+  TFile file(filename.c_str(), "RECREATE", "Aggregator");
+  if (! file.IsWritable()) {
+    QwError << "QwAggregator could not create output file " << filename << QwLog::endl;
+    return;
+  }
+  TTree* tree = new TTree("agg", "Aggregator Tree");
+
+  // Stable storage for the branch addresses
+  std::vector<Double_t> values;
+  std::vector<std::string> names;
+  values.reserve(4 + 5 * moments.size() + 2 * comoments.size());
+  names.reserve(values.capacity());
+  auto add = [&values, &names](const std::string& name, Double_t value) {
+    names.push_back(name);
+    values.push_back(value);
+  };
+
+  Ssiz_t dot = run_label.First('.');
+  add("run_number", run_label.Atoi());
+  add("n_runs", 1.0);
+  add("split_n", dot == kNPOS ? -1.0 : TString(run_label(dot + 1, run_label.Length())).Atoi());
+  add("minirun_n", minirun);
+
+  for (size_t i = 0; i < moments.size(); i++) {
+    const Moments& m = moments[i];
+    const std::string& name = fVariableFull[i];
+    Bool_t ok = (m.fN > 0.0);
+    Double_t rms = ok ? std::sqrt(m.fM2 / m.fN) : kAggregatorPlaceholder;
+    add(name + "_mean",       ok ? m.fMean : kAggregatorPlaceholder);
+    add(name + "_mean_error", ok ? rms / std::sqrt(m.fN) : kAggregatorPlaceholder);
+    add(name + "_rms",        rms);
+    add(name + "_rms_error",  ok ? rms / std::sqrt(2.0 * m.fN) : kAggregatorPlaceholder);
+    add(name + "_nentries",   m.fN);
+  }
+
+  // Least-squares slope of the dependent on the independent variable
+  for (size_t k = 0; k < comoments.size(); k++) {
+    const CoMoments& c = comoments[k];
+    const std::string name = "cor_" + fVariableFull[fCorrelation[k].first]
+                           + "_" + fVariableFull[fCorrelation[k].second];
+    Double_t slope = kAggregatorPlaceholder;
+    Double_t error = kAggregatorPlaceholder;
+    if (c.fX.fN > 2.0 && c.fX.fM2 > 0.0) {
+      slope = c.fCXY / c.fX.fM2;
+      Double_t residual = std::max(c.fY.fM2 - slope * c.fCXY, 0.0);
+      error = std::sqrt(residual / (c.fX.fN - 2.0) / c.fX.fM2);
+    }
+    add(name + "_slope", slope);
+    add(name + "_slope_error", error);
+  }
+
+  for (size_t i = 0; i < values.size(); i++)
+    tree->Branch(names[i].c_str(), &values[i], (names[i] + "/D").c_str());
+  tree->Fill();
+  tree->Write("", TObject::kOverwrite);
+  file.Close();
+
+  QwMessage << "QwAggregator " << fName << " wrote " << filename << QwLog::endl;
+}
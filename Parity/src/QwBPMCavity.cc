@@ -185,6 +185,33 @@ void QwBPMCavity::IncrementErrorCounters()
   }
 }
 
+/** Collect the error flags of all subelements and derived channels. */
+void QwBPMCavity::CollectErrorFlags(std::vector<const UInt_t*>& flags) const
+{
+  size_t i=0;
+
+  for(i=0;i<kNumElements;i++){
+    fElement[i].CollectErrorFlags(flags);
+  }
+  for(i=0;i<kNumAxes;i++){
+    fRelPos[i].CollectErrorFlags(flags);
+    fAbsPos[i].CollectErrorFlags(flags);
+  }
+}
+
+void QwBPMCavity::CollectChannels(std::vector<VQwHardwareChannel*>& channels)
+{
+  size_t i=0;
+
+  for(i=0;i<kNumElements;i++){
+    fElement[i].CollectChannels(channels);
+  }
+  for(i=0;i<kNumAxes;i++){
+    fRelPos[i].CollectChannels(channels);
+    fAbsPos[i].CollectChannels(channels);
+  }
+}
+
 /** Print persistent error counter summaries for diagnostics. */
 void QwBPMCavity::PrintErrorCounters() const
 {
@@ -7,6 +7,7 @@
 
 // System headers
 #include <stdexcept>
+#include <type_traits>
 
 // ROOT headers
 #include "ROOT/RNTupleModel.hxx"
@@ -19,6 +20,7 @@
 #include "QwVQWK_Channel.h"
 #include "QwScaler_Channel.h"
 #include "QwMollerADC_Channel.h"
+#include "QwBlockChannelValues.h"
 
 /* Position calibration factor, transform ADC counts in mm*/
 //const Double_t QwBPStripline::kQwStriplineCalibration = 18.77;
@@ -26,6 +28,11 @@
 template<typename T>
 const TString QwBPMStripline<T>::subelement[4]={"XP","XM","YP","YM"};
 
+/// Channel types with four blocks and a hardware sum, which the fused kernel supports
+template<typename T>
+constexpr Bool_t kHasBlockValues =
+  std::is_same_v<T, QwVQWK_Channel> || std::is_same_v<T, QwMollerADC_Channel>;
+
 /**
  * \brief Initialize this BPM stripline with a detector name.
  * \param name Detector name used for subchannel naming.
@@ -161,6 +168,35 @@ void QwBPMStripline<T>::IncrementErrorCounters()
   fEllipticity.IncrementErrorCounters();
 }
 
+/** \brief Collect the error flags of all internal channels. */
+template<typename T>
+void QwBPMStripline<T>::CollectErrorFlags(std::vector<const UInt_t*>& flags) const
+{
+  Short_t i=0;
+
+  for(i=0;i<4;i++) fWire[i].CollectErrorFlags(flags);
+  for(i=kXAxis;i<kNumAxes;i++) {
+    fRelPos[i].CollectErrorFlags(flags);
+    fAbsPos[i].CollectErrorFlags(flags);
+  }
+  fEffectiveCharge.CollectErrorFlags(flags);
+  fEllipticity.CollectErrorFlags(flags);
+}
+
+template<typename T>
+void QwBPMStripline<T>::CollectChannels(std::vector<VQwHardwareChannel*>& channels)
+{
+  Short_t i=0;
+
+  for(i=0;i<4;i++) fWire[i].CollectChannels(channels);
+  for(i=kXAxis;i<kNumAxes;i++) {
+    fRelPos[i].CollectChannels(channels);
+    fAbsPos[i].CollectChannels(channels);
+  }
+  fEffectiveCharge.CollectChannels(channels);
+  fEllipticity.CollectChannels(channels);
+}
+
 /** \brief Print error counters for all internal channels. */
 template<typename T>
 void QwBPMStripline<T>::PrintErrorCounters() const
@@ -446,6 +482,26 @@ void QwBPMStripline<T>::SetSingleEventCuts(TString ch_name, UInt_t errorflag,Dou
 
 template<typename T>
 void  QwBPMStripline<T>::ProcessEvent()
+{
+  ApplyHWChecks();
+  /**First apply HW checks and update HW  error flags.
+     Calling this routine here and not in ApplySingleEventCuts
+     makes a difference for a BPMs because they have derived devices.
+  */
+
+  for(Short_t i=0;i<4;i++)
+    fWire[i].ProcessEvent();
+
+  if (fVerifyFusedKernel) {
+    VerifyFusedKernel();
+  } else if (! fUseFusedKernel || ! ProcessFusedKernel()) {
+    ProcessDerivedChannels();
+  }
+}
+
+
+template<typename T>
+void  QwBPMStripline<T>::ProcessDerivedChannels()
 {
   Bool_t localdebug = kFALSE;
   static T numer("numerator","derived"), denom("denominator","derived");
@@ -456,18 +512,11 @@ void  QwBPMStripline<T>::ProcessEvent()
 
   Short_t i = 0;
 
-  ApplyHWChecks();
-  /**First apply HW checks and update HW  error flags.
-     Calling this routine here and not in ApplySingleEventCuts
-     makes a difference for a BPMs because they have derived devices.
-  */
-
   fEffectiveCharge.ClearEventData();
   fEllipticity.ClearEventData();
 
   for(i=0;i<4;i++)
     {
-      fWire[i].ProcessEvent();
       fEffectiveCharge+=fWire[i];
       if (i<2)
       {
@@ -563,6 +612,206 @@ void  QwBPMStripline<T>::ProcessEvent()
 }
 
 
+template<typename T>
+Bool_t QwBPMStripline<T>::IsFullyNamed() const
+{
+  for (Short_t i = 0; i < 4; i++)
+    if (fWire[i].IsNameEmpty()) return kFALSE;
+  for (Short_t i = kXAxis; i < kNumAxes; i++)
+    if (fRelPos[i].IsNameEmpty() || fAbsPos[i].IsNameEmpty()) return kFALSE;
+  return ! (fEffectiveCharge.IsNameEmpty() || fEllipticity.IsNameEmpty());
+}
+
+/**
+ * \brief Compute the positions, effective charge and ellipticity in one pass.
+ *
+ * Performs the same chain of operations as ProcessDerivedChannels, but on
+ * the packed values of the four wires: all intermediate results for one
+ * lane (block or hardware sum) are computed in registers before the next
+ * lane, and the scalar fields (sample counts, good event counts, error
+ * flags) are combined once per event instead of once per operation.  The
+ * floating point operations are done in the same order as in the channel
+ * arithmetic, so the results are identical bit for bit; this is checked
+ * with --verify-bpm-kernel.
+ *
+ * \return kFALSE when the kernel does not apply to this channel type or a
+ *         channel is unnamed; the caller then uses ProcessDerivedChannels
+ */
+template<typename T>
+Bool_t QwBPMStripline<T>::ProcessFusedKernel()
+{
+  if constexpr (kHasBlockValues<T>) {
+    if (! IsFullyNamed()) return kFALSE;
+
+    QwBlockChannelValues wire[4];
+    for (Short_t i = 0; i < 4; i++)
+      fWire[i].GetBlockValues(wire[i]);
+
+    QwBlockChannelValues relpos[kNumAxes], abspos[kNumAxes];
+    QwBlockChannelValues charge, ellipticity;
+
+    const Double_t ellipticity_scale = 0.5*fQwStriplineCalibration*fQwStriplineCalibration;
+    const Double_t ellipticity_correction = -1.0*0.250014;
+    const Double_t gain_scale[kNumAxes] = {1.0/fGains[kXAxis], 1.0/fGains[kYAxis]};
+
+    Bool_t nan = kFALSE;
+    for (Int_t l = 0; l < QwBlockChannelValues::kLanes; l++) {
+      // Effective charge and uncorrected ellipticity
+      Double_t q = 0.0, e = 0.0, e_m2 = 0.0;
+      q += wire[0].fValue[l];  e += wire[0].fValue[l];
+      q += wire[1].fValue[l];  e += wire[1].fValue[l];
+      q += wire[2].fValue[l];  e -= wire[2].fValue[l];
+      q += wire[3].fValue[l];  e -= wire[3].fValue[l];
+      QwBlockChannelValues::DivideLane(l, e, e_m2, q, 0.0);
+      nan |= (l == QwBlockChannelValues::kSum && e != e);
+      e *= ellipticity_scale;
+
+      // Relative gains of the minus wires, and raw positions
+      Double_t rawpos[kNumAxes];
+      for (Int_t a = kXAxis; a < kNumAxes; a++) {
+        Double_t& minus    = wire[2*a+1].fValue[l];
+        Double_t& minus_m2 = wire[2*a+1].fValueM2[l];
+        minus    *= fRelativeGains[a];
+        minus_m2 *= fRelativeGains[a] * fRelativeGains[a];
+        Double_t numer = wire[2*a].fValue[l];
+        numer -= minus;
+        Double_t denom = wire[2*a].fValue[l];
+        denom += minus;
+        Double_t rawpos_m2 = 0.0;
+        rawpos[a] = numer;
+        QwBlockChannelValues::DivideLane(l, rawpos[a], rawpos_m2, denom, 0.0);
+        nan |= (l == QwBlockChannelValues::kSum && rawpos[a] != rawpos[a]);
+        rawpos[a] *= fQwStriplineCalibration;
+      }
+
+      // Rotation into the accelerator frame, and absolute positions
+      for (Int_t a = kXAxis; a < kNumAxes; a++) {
+        Double_t tmp1 = rawpos[a]   * fCosRotation;
+        Double_t tmp2 = rawpos[1-a] * fSinRotation;
+        Double_t pos = tmp1;
+        if (a == kXAxis) pos -= tmp2;
+        else             pos += tmp2;
+        relpos[a].fValue[l]   = pos;
+        relpos[a].fValueM2[l] = 0.0;
+        pos += fPositionCenter[a];
+        pos *= gain_scale[a];
+        abspos[a].fValue[l]   = pos;
+        abspos[a].fValueM2[l] = 0.0;
+        abspos[a].fValueM2[l] *= gain_scale[a] * gain_scale[a];
+      }
+
+      // Ellipticity correction for the beam position
+      Double_t tmp3 = relpos[kXAxis].fValue[l] * relpos[kXAxis].fValue[l];
+      Double_t tmp4 = relpos[kYAxis].fValue[l] * relpos[kYAxis].fValue[l];
+      Double_t tmp5 = tmp3;
+      tmp5 -= tmp4;
+      tmp5 *= ellipticity_correction;
+      e += tmp5;
+
+      charge.fValue[l]        = q;
+      charge.fValueM2[l]      = 0.0;
+      ellipticity.fValue[l]   = e;
+      ellipticity.fValueM2[l] = 0.0;
+    }
+
+    // Scalar fields, combined as the channel operations combine them
+    UInt_t samples = 0, errorflag = 0;
+    for (Short_t i = 0; i < 4; i++) {
+      samples   += wire[i].fNumberOfSamples;
+      errorflag |= wire[i].fErrorFlag;
+    }
+    UInt_t raw_samples[kNumAxes];
+    for (Int_t a = kXAxis; a < kNumAxes; a++)
+      raw_samples[a] = wire[2*a].fNumberOfSamples + wire[2*a+1].fNumberOfSamples;
+    for (Int_t a = kXAxis; a < kNumAxes; a++) {
+      relpos[a].fSumError        = wire[2*a].fSumError;
+      relpos[a].fNumberOfSamples = raw_samples[a] + raw_samples[1-a];
+      relpos[a].fSequenceNumber  = 0;
+      relpos[a].fGoodEventCount  = wire[2*a].fGoodEventCount;
+      relpos[a].fErrorFlag       = errorflag;
+      abspos[a].fSumError        = relpos[a].fSumError;
+      abspos[a].fNumberOfSamples = relpos[a].fNumberOfSamples;
+      abspos[a].fSequenceNumber  = 0;
+      abspos[a].fGoodEventCount  = relpos[a].fGoodEventCount;
+      abspos[a].fErrorFlag       = errorflag;
+    }
+    charge.fSumError        = 0.0;
+    charge.fNumberOfSamples = samples;
+    charge.fSequenceNumber  = 0;
+    charge.fGoodEventCount  = 0;
+    charge.fErrorFlag       = errorflag;
+    ellipticity.fSumError        = 0.0;
+    ellipticity.fNumberOfSamples = samples
+      + (relpos[kXAxis].fNumberOfSamples + relpos[kYAxis].fNumberOfSamples);
+    ellipticity.fSequenceNumber  = 0;
+    ellipticity.fGoodEventCount  = 0;
+    ellipticity.fErrorFlag       = errorflag;
+
+    fWire[1].SetBlockValues(wire[1]);
+    fWire[3].SetBlockValues(wire[3]);
+    for (Int_t a = kXAxis; a < kNumAxes; a++) {
+      fRelPos[a].SetBlockValues(relpos[a]);
+      fAbsPos[a].SetBlockValues(abspos[a]);
+    }
+    fEffectiveCharge.SetBlockValues(charge);
+    fEllipticity.SetBlockValues(ellipticity);
+
+    if (nan)
+      QwWarningLimited(this,10) << "Angry Nanny: NaN detected in " << GetElementName() << QwLog::endl;
+    return kTRUE;
+  }
+  return kFALSE;
+}
+
+/**
+ * \brief Self-test of the fused kernel against the channel arithmetic.
+ *
+ * Computes the derived channels with ProcessDerivedChannels, restores the
+ * wires (which are scaled by the relative gains in place), computes them
+ * again with ProcessFusedKernel and compares all outputs bit for bit.
+ */
+template<typename T>
+void QwBPMStripline<T>::VerifyFusedKernel()
+{
+  if constexpr (kHasBlockValues<T>) {
+    if (IsFullyNamed()) {
+      auto outputs = [this](QwBlockChannelValues* values) {
+        fWire[1].GetBlockValues(values[0]);
+        fWire[3].GetBlockValues(values[1]);
+        for (Int_t a = kXAxis; a < kNumAxes; a++) {
+          fRelPos[a].GetBlockValues(values[2+a]);
+          fAbsPos[a].GetBlockValues(values[4+a]);
+        }
+        fEffectiveCharge.GetBlockValues(values[6]);
+        fEllipticity.GetBlockValues(values[7]);
+      };
+      QwBlockChannelValues wire[4], reference[8], fused[8];
+      for (Short_t i = 0; i < 4; i++)
+        fWire[i].GetBlockValues(wire[i]);
+      ProcessDerivedChannels();
+      outputs(reference);
+      for (Short_t i = 0; i < 4; i++)
+        fWire[i].SetBlockValues(wire[i]);
+      ProcessFusedKernel();
+      outputs(fused);
+
+      Bool_t match = kTRUE;
+      for (Short_t k = 0; k < 8; k++)
+        match &= fused[k].IsIdentical(reference[k]);
+      fFusedKernelComparisons++;
+      if (! match) {
+        fFusedKernelMismatches++;
+        QwWarningLimited(this,10) << "Stripline BPM kernel self-test: fused kernel differs "
+                             << "from the channel arithmetic for " << GetElementName()
+                             << QwLog::endl;
+      }
+      return;
+    }
+  }
+  ProcessDerivedChannels();
+}
+
+
 template<typename T>
 Int_t QwBPMStripline<T>::ProcessEvBuffer(UInt_t* buffer, UInt_t word_position_in_buffer,UInt_t index)
 {
@@ -39,6 +39,11 @@ class QwParityDB;
 /** Parse and handle beamline-specific command-line options. */
 void QwBeamLine::ProcessOptions(QwOptions &options){
       //Handle command line options
+      fADC18Bank.SetVerify(options.GetValue<bool>("verify-bank-decoders"));
+      fMollerADCBank.SetVerify(options.GetValue<bool>("verify-bank-decoders"));
+      VQwBPM::SetFusedKernel(options.GetValue<bool>("fused-bpm-kernel"),
+                             options.GetValue<bool>("verify-bpm-kernel"));
+      fLazyDerivedDevices = options.GetValue<bool>("lazy-derived-devices");
 }
 
 //*****************************************************************//
@@ -435,6 +440,27 @@ Int_t QwBeamLine::LoadChannelMap(TString mapfile)
       }
     }
   }
+  // Mark the subbanks with ADC18 modules, which are decoded as a whole bank
+  fADC18Subbank.clear();
+  for (size_t i=0; i<fBeamDetectorID.size(); i++) {
+    Int_t subbank = fBeamDetectorID[i].fSubbankIndex;
+    if (subbank < 0 || fBeamDetectorID[i].fmoduletype != "ADC18") continue;
+    if (subbank >= (Int_t) fADC18Subbank.size())
+      fADC18Subbank.resize(subbank+1, kFALSE);
+    fADC18Subbank[subbank] = kTRUE;
+  }
+  // Mark the first record of the MollerADC modules in each subbank,
+  // from where the bank is decoded as a whole
+  fMollerADCFirstWord.clear();
+  for (size_t i=0; i<fBeamDetectorID.size(); i++) {
+    Int_t subbank = fBeamDetectorID[i].fSubbankIndex;
+    Int_t word = fBeamDetectorID[i].fWordInSubbank;
+    if (subbank < 0 || word < 0 || fBeamDetectorID[i].fmoduletype != "MOLLERADC") continue;
+    if (subbank >= (Int_t) fMollerADCFirstWord.size())
+      fMollerADCFirstWord.resize(subbank+1, -1);
+    if (fMollerADCFirstWord[subbank] < 0 || word < fMollerADCFirstWord[subbank])
+      fMollerADCFirstWord[subbank] = word;
+  }
   ldebug=kFALSE;
 
   mapstr.Close(); // Close the file (ifstream)
@@ -457,6 +483,8 @@ void QwBeamLine::LoadEventCuts_Line(QwParameterFile &mapstr, TString &varvalue,
   if (det_index == -1) {
     QwWarning << " Device not found " << device_name << " of type " << device_type << QwLog::endl;
     //continue;
+  } else {
+    MarkDerivedDeviceUsed(GetQwBeamInstrumentType(device_type), det_index);
   }
 
   TString channel_name;
@@ -1174,14 +1202,25 @@ Int_t QwBeamLine::ProcessEvBuffer(const ROCID_t roc_id, const BankID_t bank_id,
 		<< "Begin processing ROC" << roc_id
 		<< " and subbank "<<bank_id
 		<< " number of words="<<num_words<<std::endl;
+    UInt_t num_padding_words = 0;
     if (buffer[0]==0xf0f0f0f0 && num_words%2==1){
       buffer++;
+      num_padding_words++;
       if (lkDEBUG)
 	std::cout << "QwBeamLine::ProcessEvBuffer:  "
 		  << "Skipped padding word 0xf0f0f0f0 at beginning of buffer."
 		  << std::endl;
     }
 
+    //  Decode ADC18 banks once for all channels in them
+    Bool_t adc18_bank = (index < (Int_t) fADC18Subbank.size() && fADC18Subbank[index]);
+    if (adc18_bank)
+      fADC18Bank.Decode(buffer, num_words - num_padding_words);
+    //  Decode the MollerADC records once for all channels in them
+    Bool_t molleradc_bank = (index < (Int_t) fMollerADCFirstWord.size() && fMollerADCFirstWord[index] >= 0);
+    if (molleradc_bank)
+      fMollerADCBank.Decode(buffer, num_words - num_padding_words, fMollerADCFirstWord[index]);
+
     for(size_t i=0;i<fBeamDetectorID.size();i++)
       {
 	if(fBeamDetectorID[i].fSubbankIndex==index)
@@ -1278,6 +1317,11 @@ Int_t QwBeamLine::ProcessEvBuffer(const ROCID_t roc_id, const BankID_t bank_id,
 
 	  }
       }
+
+    if (adc18_bank)
+      fADC18Bank.Release();
+    if (molleradc_bank)
+      fMollerADCBank.Release();
   }
 
   return 0;
@@ -1499,6 +1543,76 @@ void QwBeamLine::IncrementErrorCounters()
   }
 }
 
+//*****************************************************************//
+/** Collect the error flags of the channels of all managed devices. */
+void QwBeamLine::CollectErrorFlags(std::vector<const UInt_t*>& flags) const
+{
+  for(size_t i=0;i<fClock.size();i++){
+    fClock[i].get()->CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fBCM.size();i++){
+    fBCM[i].get()->CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fHaloMonitor.size();i++){
+    fHaloMonitor[i].CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fStripline.size();i++){
+    fStripline[i].get()->CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fQPD.size();i++){
+    fQPD[i].CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fLinearArray.size();i++){
+    fLinearArray[i].CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fCavity.size();i++){
+    fCavity[i].CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fBCMCombo.size();i++){
+    fBCMCombo[i].get()->CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fBPMCombo.size();i++){
+    fBPMCombo[i].get()->CollectErrorFlags(flags);
+  }
+  for(size_t i=0;i<fECalculator.size();i++){
+    fECalculator[i].CollectErrorFlags(flags);
+  }
+}
+
+void QwBeamLine::CollectChannels(std::vector<VQwHardwareChannel*>& channels)
+{
+  for(size_t i=0;i<fClock.size();i++){
+    fClock[i].get()->CollectChannels(channels);
+  }
+  for(size_t i=0;i<fBCM.size();i++){
+    fBCM[i].get()->CollectChannels(channels);
+  }
+  for(size_t i=0;i<fHaloMonitor.size();i++){
+    fHaloMonitor[i].CollectChannels(channels);
+  }
+  for(size_t i=0;i<fStripline.size();i++){
+    fStripline[i].get()->CollectChannels(channels);
+  }
+  for(size_t i=0;i<fQPD.size();i++){
+    fQPD[i].CollectChannels(channels);
+  }
+  for(size_t i=0;i<fLinearArray.size();i++){
+    fLinearArray[i].CollectChannels(channels);
+  }
+  for(size_t i=0;i<fCavity.size();i++){
+    fCavity[i].CollectChannels(channels);
+  }
+  for(size_t i=0;i<fBCMCombo.size();i++){
+    fBCMCombo[i].get()->CollectChannels(channels);
+  }
+  for(size_t i=0;i<fBPMCombo.size();i++){
+    fBPMCombo[i].get()->CollectChannels(channels);
+  }
+  for(size_t i=0;i<fECalculator.size();i++){
+    fECalculator[i].CollectChannels(channels);
+  }
+}
+
 //*****************************************************************//
 /** Return the OR of per-device event-cut error flags. */
 UInt_t QwBeamLine::GetEventcutErrorFlag(){//return the error flag
@@ -1640,15 +1754,20 @@ void  QwBeamLine::ProcessEvent()
     fHaloMonitor[i].ProcessEvent();
   }
 
+  //  Derived devices without readers are skipped, see DisableUnusedDerivedQuantities
+  const DerivedDeviceUsage& usage = *fDerivedUsage;
   for(size_t i=0;i<fBCMCombo.size();i++){
+    if (i < usage.fSkipBCMCombo.size() && usage.fSkipBCMCombo[i]) continue;
     fBCMCombo[i].get()->ProcessEvent();
      // fBCMCombo[i].get()->PrintInfo();
   }
   for(size_t i=0;i<fBPMCombo.size();i++){
+    if (i < usage.fSkipBPMCombo.size() && usage.fSkipBPMCombo[i]) continue;
      fBPMCombo[i].get()->ProcessEvent();
     // fBPMCombo[i].get()->PrintInfo();
   }
   for(size_t i=0;i<fECalculator.size();i++){
+    if (i < usage.fSkipECalculator.size() && usage.fSkipECalculator[i]) continue;
     fECalculator[i].ProcessEvent();
   }
   return;
@@ -1804,6 +1923,107 @@ void QwBeamLine::ClearEventData()
   return;
 }
 
+//*****************************************************************//
+/**
+ * Record that a combined BCM, combined BPM or energy calculator is read.
+ * An energy calculator also reads its combined BPMs.  A device which was
+ * already skipped, because it is requested after the outputs were set up,
+ * is computed again from the next event on.
+ */
+void QwBeamLine::MarkDerivedDeviceUsed(EQwBeamInstrumentType type_id, Int_t index) const
+{
+  DerivedDeviceUsage& usage = *fDerivedUsage;
+  std::vector<Bool_t>* used = nullptr;
+  std::vector<Bool_t>* skip = nullptr;
+  size_t size = 0;
+  switch (type_id) {
+  case kQwCombinedBCM:
+    used = &usage.fUsedBCMCombo; skip = &usage.fSkipBCMCombo; size = fBCMCombo.size();
+    break;
+  case kQwCombinedBPM:
+    used = &usage.fUsedBPMCombo; skip = &usage.fSkipBPMCombo; size = fBPMCombo.size();
+    break;
+  case kQwEnergyCalculator:
+    used = &usage.fUsedECalculator; skip = &usage.fSkipECalculator; size = fECalculator.size();
+    break;
+  default:
+    return;
+  }
+  if (index < 0 || static_cast<size_t>(index) >= size) return;
+
+  used->resize(size, kFALSE);
+  (*used)[index] = kTRUE;
+  if (static_cast<size_t>(index) < skip->size() && (*skip)[index]) {
+    (*skip)[index] = kFALSE;
+    QwMessage << "QwBeamLine " << GetName() << ": computing "
+              << GetElement(type_id, index)->GetElementName()
+              << " again for a late request" << QwLog::endl;
+  }
+
+  if (type_id == kQwEnergyCalculator) {
+    const QwEnergyCalculator& ecalc = fECalculator.at(index);
+    for (size_t j = 0; j < ecalc.GetNumberOfElements(); j++) {
+      for (size_t k = 0; k < fBPMCombo.size(); k++) {
+        if (fBPMCombo[k].get()->GetElementName() == ecalc.GetSubElementName(j))
+          MarkDerivedDeviceUsed(kQwCombinedBPM, k);
+      }
+    }
+  }
+}
+
+/** Record that all derived devices are read, e.g. by an untrimmed tree. */
+void QwBeamLine::MarkAllDerivedDevicesUsed() const
+{
+  for (size_t i = 0; i < fBCMCombo.size(); i++)
+    MarkDerivedDeviceUsed(kQwCombinedBCM, i);
+  for (size_t i = 0; i < fBPMCombo.size(); i++)
+    MarkDerivedDeviceUsed(kQwCombinedBPM, i);
+  for (size_t i = 0; i < fECalculator.size(); i++)
+    MarkDerivedDeviceUsed(kQwEnergyCalculator, i);
+}
+
+//*****************************************************************//
+/**
+ * Skip the combined BCMs, combined BPMs and energy calculators which are
+ * not read by any tree, histogram, event cut or published value of this
+ * subsystem or its copies, and list them.  Skipped devices keep their
+ * cleared values.  Untrimmed trees and histograms read all devices, so this
+ * only saves time when those outputs are disabled or trimmed.
+ */
+void QwBeamLine::DisableUnusedDerivedQuantities()
+{
+  if (! fLazyDerivedDevices) return;
+
+  DerivedDeviceUsage& usage = *fDerivedUsage;
+  usage.fUsedBCMCombo.resize(fBCMCombo.size(), kFALSE);
+  usage.fUsedBPMCombo.resize(fBPMCombo.size(), kFALSE);
+  usage.fUsedECalculator.resize(fECalculator.size(), kFALSE);
+
+  TString skipped;
+  for (size_t i = 0; i < fBCMCombo.size(); i++)
+    if (! usage.fUsedBCMCombo[i]) skipped += " " + fBCMCombo[i].get()->GetElementName();
+  for (size_t i = 0; i < fBPMCombo.size(); i++)
+    if (! usage.fUsedBPMCombo[i]) skipped += " " + fBPMCombo[i].get()->GetElementName();
+  for (size_t i = 0; i < fECalculator.size(); i++)
+    if (! usage.fUsedECalculator[i]) skipped += " " + fECalculator[i].GetElementName();
+
+  usage.fSkipBCMCombo = usage.fUsedBCMCombo;
+  usage.fSkipBCMCombo.flip();
+  usage.fSkipBPMCombo = usage.fUsedBPMCombo;
+  usage.fSkipBPMCombo.flip();
+  usage.fSkipECalculator = usage.fUsedECalculator;
+  usage.fSkipECalculator.flip();
+
+  if (skipped.Length() > 0) {
+    QwMessage << "QwBeamLine " << GetName()
+              << ": derived devices without readers, not computed:"
+              << skipped << QwLog::endl;
+  } else {
+    QwMessage << "QwBeamLine " << GetName()
+              << ": all derived devices are read" << QwLog::endl;
+  }
+}
+
 //*****************************************************************//
 /** Lookup the element index for a given device type and name. */
 Int_t QwBeamLine::GetDetectorIndex( EQwBeamInstrumentType type_id, TString name) const
@@ -1900,6 +2120,8 @@ const VQwHardwareChannel* QwBeamLine::GetChannel(EQwBeamInstrumentType TypeID, I
 {
   const VQwHardwareChannel* tmp_channel = 0;
 
+  MarkDerivedDeviceUsed(TypeID, index);
+
   if (TypeID==kQwBPMStripline || TypeID==kQwBPMCavity || TypeID==kQwQPD){
     const VQwBPM* tmp_ptr = dynamic_cast<const VQwBPM*>(GetElement(TypeID, index));
     if (device_prop == "x")
@@ -2467,6 +2689,7 @@ void  QwBeamLine::ConstructHistograms(TDirectory *folder, TString &prefix)
 {
 
   //  std::cout<<" here is QwBeamLine::ConstructHistogram with prefix ="<<prefix<<"\n";
+  MarkAllDerivedDevicesUsed();
   for(size_t i=0;i<fClock.size();i++)
       fClock[i].get()->ConstructHistograms(folder,prefix);
 
@@ -2530,6 +2753,7 @@ void  QwBeamLine::FillHistograms()
 //*****************************************************************//
 void QwBeamLine::ConstructBranchAndVector(TTree *tree, TString & prefix, QwRootTreeBranchVector &values)
 {
+  MarkAllDerivedDevicesUsed();
 
   for(size_t i = 0; i < fClock.size(); i++)
     fClock[i].get()->ConstructBranchAndVector(tree, prefix, values);
@@ -2558,6 +2782,7 @@ void QwBeamLine::ConstructBranchAndVector(TTree *tree, TString & prefix, QwRootT
 //*****************************************************************//
 void QwBeamLine::ConstructBranch(TTree *tree, TString & prefix)
 {
+  MarkAllDerivedDevicesUsed();
   for(size_t i = 0; i < fClock.size(); i++)
     fClock[i].get()->ConstructBranch(tree, prefix);
   for(size_t i = 0; i < fStripline.size(); i++)
@@ -2655,8 +2880,13 @@ void QwBeamLine::ConstructBranch(TTree *tree, TString & prefix, QwParameterFile&
   trim_file.RewindToFileStart();
   if (trim_file.FileHasModuleHeader(tmp)){
     nextmodule=trim_file.ReadUntilNextModule();//This section contains sub modules and or channels to be included in the tree
-    for(size_t i = 0; i <fBCMCombo.size();i++)
+    for(size_t i = 0; i <fBCMCombo.size();i++) {
       fBCMCombo[i].get()->ConstructBranch(tree, prefix,*nextmodule);
+      TString devicename = fBCMCombo[i].get()->GetElementName();
+      devicename.ToLower();
+      if (nextmodule->HasValue(devicename))
+        MarkDerivedDeviceUsed(kQwCombinedBCM, i);
+    }
   }
 
 
@@ -2664,16 +2894,26 @@ void QwBeamLine::ConstructBranch(TTree *tree, TString & prefix, QwParameterFile&
   trim_file.RewindToFileStart();
   if (trim_file.FileHasModuleHeader(tmp)){
     nextmodule=trim_file.ReadUntilNextModule();//This section contains sub modules and or channels to be included in the tree
-    for(size_t i = 0; i <fBPMCombo.size();i++)
+    for(size_t i = 0; i <fBPMCombo.size();i++) {
       fBPMCombo[i].get()->ConstructBranch(tree, prefix,*nextmodule);
+      TString devicename = fBPMCombo[i].get()->GetElementName();
+      devicename.ToLower();
+      if (nextmodule->HasValue(devicename))
+        MarkDerivedDeviceUsed(kQwCombinedBPM, i);
+    }
   }
 
   tmp="QwEnergyCalculator";
   trim_file.RewindToFileStart();
   if (trim_file.FileHasModuleHeader(tmp)){
     nextmodule=trim_file.ReadUntilNextModule();//This section contains sub modules and or channels to be included in the tree
-    for(size_t i = 0; i <fECalculator.size();i++)
+    for(size_t i = 0; i <fECalculator.size();i++) {
       fECalculator[i].ConstructBranch(tree, prefix,*nextmodule);
+      TString devicename = fECalculator[i].GetElementName();
+      devicename.ToLower();
+      if (nextmodule->HasValue(devicename))
+        MarkDerivedDeviceUsed(kQwEnergyCalculator, i);
+    }
   }
 
   return;
@@ -2709,6 +2949,7 @@ void QwBeamLine::FillTreeVector(QwRootTreeBranchVector &values) const
 //*****************************************************************//
 void QwBeamLine::ConstructNTupleAndVector(std::unique_ptr<ROOT::RNTupleModel>& model, TString& prefix, std::vector<Double_t>& values, std::vector<std::shared_ptr<Double_t>>& fieldPtrs)
 {
+  MarkAllDerivedDevicesUsed();
   for(size_t i = 0; i < fClock.size(); i++)
     fClock[i].get()->ConstructNTupleAndVector(model, prefix, values, fieldPtrs);
   for(size_t i = 0; i < fStripline.size(); i++)
@@ -515,6 +515,13 @@ void QwBeamMod::IncrementErrorCounters()
   }
 }
 
+void QwBeamMod::CollectErrorFlags(std::vector<const UInt_t*>& flags) const
+{
+  for(size_t i=0;i<fModChannel.size();i++){
+    fModChannel[i]->CollectErrorFlags(flags);
+  }
+}
+
 void QwBeamMod::PrintErrorCounters() const{//inherited from the VQwSubsystemParity; this will display the error summary
 
   std::cout<<"*********QwBeamMod Error Summary****************"<<std::endl;
@@ -584,6 +591,12 @@ Int_t QwBeamMod::ProcessConfigurationBuffer(const ROCID_t roc_id, const BankID_t
    fFFB_ErrorFlag=0;
 }
 
+void QwBeamMod::ClearRunState(){
+  for(size_t i=0;i<fModChannel.size();i++)
+    fModChannel[i]->ClearRunState();
+  ClearEventData();
+}
+
 //*****************************************************************
 Int_t QwBeamMod::GetDetectorIndex(TString name)
 {
@@ -1052,6 +1052,33 @@ Bool_t QwBlinder::CheckTestValues()
       status = kFALSE;
     }
   }
+
+  /// Third test: compare the span blinding with the blinding of single
+  /// values, for asymmetries and differences (the bit for bit agreement
+  /// is checked by qwblindertest)
+  std::vector<double> batch(fTestValues), yields(fTestValues.size());
+  std::vector<double> single(fTestValues);
+  for (size_t i = 0; i < fTestValues.size(); i++)
+    yields[i] = 1.0 - 1.0e5 * fTestValues[i];
+  BlindValues(batch.data(), batch.size());
+  for (size_t i = 0; i < single.size(); i++)
+    BlindValue(single[i]);
+  BlindValues(batch.data(), yields.data(), batch.size());
+  for (size_t i = 0; i < single.size(); i++)
+    BlindValue(single[i], yields[i]);
+  for (size_t i = 0; i < batch.size(); i++) {
+    double test1 = batch[i];
+    double test2 = single[i];
+    if ((test1 - test2) <= -epsilon || (test1 - test2) >= epsilon) {
+      QwError << "QwBlinder::CheckTestValues():  Span blinding of test value "
+              << i
+              << " does not agree with the blinding of the single value, "
+              << "with a difference of "
+              << (test1 - test2) << "." << QwLog::endl;
+      status = kFALSE;
+    }
+  }
+
   fBlindingOffset = tmp_offset;
   return status;
 }
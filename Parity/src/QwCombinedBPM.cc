@@ -194,6 +194,33 @@ void QwCombinedBPM<T>::IncrementErrorCounters()
   fEffectiveCharge.IncrementErrorCounters();
 }
 
+/** Collect the error flags of all derived outputs. */
+template<typename T>
+void QwCombinedBPM<T>::CollectErrorFlags(std::vector<const UInt_t*>& flags) const
+{
+  for(Short_t axis=kXAxis;axis<kNumAxes;axis++){
+    fAbsPos[axis].CollectErrorFlags(flags);
+    fSlope[axis].CollectErrorFlags(flags);
+    fIntercept[axis].CollectErrorFlags(flags);
+    fMinimumChiSquare[axis].CollectErrorFlags(flags);
+  }
+
+  fEffectiveCharge.CollectErrorFlags(flags);
+}
+
+template<typename T>
+void QwCombinedBPM<T>::CollectChannels(std::vector<VQwHardwareChannel*>& channels)
+{
+  for(Short_t axis=kXAxis;axis<kNumAxes;axis++){
+    fAbsPos[axis].CollectChannels(channels);
+    fSlope[axis].CollectChannels(channels);
+    fIntercept[axis].CollectChannels(channels);
+    fMinimumChiSquare[axis].CollectChannels(channels);
+  }
+
+  fEffectiveCharge.CollectChannels(channels);
+}
+
 /** Print persistent error counters for all derived outputs. */
 template<typename T>
 void QwCombinedBPM<T>::PrintErrorCounters() const
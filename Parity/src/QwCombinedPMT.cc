@@ -113,7 +113,7 @@ void QwCombinedPMT::CalculateSumAndAverage()
   Double_t  total_weights=0.0;
 
   fSumADC.ClearEventData();
-  static QwIntegrationPMT tmpADC("tmpADC");
+  thread_local QwIntegrationPMT tmpADC("tmpADC");
 
   for (size_t i=0;i<fElement.size();i++)
     {
@@ -371,7 +371,7 @@ void QwCombinedPMT::Scale(Double_t factor)
 //  fAvgADC.Scale(factor);
   return;
 }
-void QwCombinedPMT::Normalize(VQwDataElement* denom)
+void QwCombinedPMT::Normalize(const VQwDataElement* denom)
 {
   fSumADC.Normalize(denom);
 
@@ -39,6 +39,7 @@ QwCorrelator::QwCorrelator(const TString& name)
   fAliasOutputPath("."),
   fNameNoSpaces(name),
   nP(0),nY(0),
+  fSnapshotTotalCount(0),fSnapshotGoodCount(0),
   fCycleCounter(0)
 {
   fNameNoSpaces.ReplaceAll(" ","_");
@@ -65,6 +66,7 @@ QwCorrelator::QwCorrelator(const QwCorrelator& source)
   fAliasOutputFileSuff(source.fAliasOutputFileSuff),
   fAliasOutputPath(source.fAliasOutputPath),
   nP(source.nP),nY(source.nY),
+  fSnapshotTotalCount(0),fSnapshotGoodCount(0),
   fCycleCounter(source.fCycleCounter)
 {
   QwWarning << "QwCorrelator copy constructor required but untested" << QwLog::endl;
@@ -169,16 +171,13 @@ void QwCorrelator::AccumulateRunningSum(VQwDataHandler &value, Int_t count, Int_
   }
 }
 
-void QwCorrelator::CalcCorrelations()
+/**
+ * Print the entry counts and the entries that failed on the error flags,
+ * and warn when (almost) no entries were good
+ */
+void QwCorrelator::PrintEntrySummary() const
 {
-  // Check if any channels are active
-  if (nP == 0 || nY == 0) {
-    return;
-  }
-
-  QwMessage << "QwCorrelator::CalcCorrelations(): name=" << GetName() << QwLog::endl;
-
-  // Print entry summary
+  // Entry counts
   QwVerbose << "QwCorrelator: "
             << "total entries: " << fTotalCount << ", "
             << "good entries: " << fGoodCount
@@ -210,6 +209,19 @@ void QwCorrelator::CalcCorrelations()
                 << ": " <<  fErrCounts_IV.at(i) << QwLog::endl;
     }
   }
+}
+
+void QwCorrelator::CalcCorrelations()
+{
+  // Check if any channels are active
+  if (nP == 0 || nY == 0) {
+    return;
+  }
+
+  QwMessage << "QwCorrelator::CalcCorrelations(): name=" << GetName() << QwLog::endl;
+
+  // Print entry summary
+  PrintEntrySummary();
 
   if (! linReg.failed()) {
 
@@ -236,6 +248,77 @@ void QwCorrelator::CalcCorrelations()
   WriteAliasFile();
 }
 
+/**
+ * Take a snapshot of the regression accumulated over a burst, so that it
+ * can be solved and written on a background thread while the running
+ * regression is cleared for the next burst.
+ * @return True when the snapshot is to be finished in the background
+ */
+Bool_t QwCorrelator::SnapshotDataHandler()
+{
+  // Nothing to finish without active channels
+  if (nP == 0 || nY == 0) {
+    fSnapshot.reset();
+    return kTRUE;
+  }
+
+  QwMessage << "QwCorrelator::SnapshotDataHandler(): name=" << GetName() << QwLog::endl;
+
+  fSnapshot.reset(new LinRegBevPeb(linReg));
+  fSnapshotTotalCount = fTotalCount;
+  fSnapshotGoodCount = fGoodCount;
+
+  // Print entry summary
+  PrintEntrySummary();
+  if (fPrintCorrelations && ! fSnapshot->failed()) {
+    fSnapshot->printSummaryP();
+    fSnapshot->printSummaryY();
+  }
+  return kTRUE;
+}
+
+/**
+ * Solve the snapshot and write it to the alpha and alias files, which are
+ * only used by this correlator.  Runs on the background thread.
+ */
+void QwCorrelator::FinishSnapshot()
+{
+  if (! fSnapshot) return;
+  if (! fSnapshot->failed()) fSnapshot->solve();
+  WriteAlphaFile(*fSnapshot);
+  WriteAliasFile(*fSnapshot);
+}
+
+/**
+ * Fill the solved snapshot into the correlator tree.  The branches point
+ * to the running regression, which is accumulating the next burst by now,
+ * so the snapshot is copied into it for the fill and the running sums are
+ * restored afterwards.
+ */
+void QwCorrelator::FillSnapshot()
+{
+  if (! fSnapshot) return;
+
+  if (fPrintCorrelations && ! fSnapshot->failed()) {
+    fSnapshot->printSummaryAlphas();
+    fSnapshot->printSummaryMeansWithUnc();
+    fSnapshot->printSummaryMeansWithUncCorrected();
+  }
+
+  if (fTree) {
+    LinRegBevPeb running(linReg);
+    std::swap(fTotalCount, fSnapshotTotalCount);
+    std::swap(fGoodCount, fSnapshotGoodCount);
+    linReg = *fSnapshot;
+    fTree->Fill();
+    linReg = running;
+    std::swap(fTotalCount, fSnapshotTotalCount);
+    std::swap(fGoodCount, fSnapshotGoodCount);
+  } else QwWarning << "No tree" << QwLog::endl;
+
+  fSnapshot.reset();
+}
+
 
 /** Load the channel map
  *
@@ -575,27 +658,27 @@ void QwCorrelator::FillHistograms()
   }
 }
 
-void QwCorrelator::WriteAlphaFile()
+void QwCorrelator::WriteAlphaFile(LinRegBevPeb& reg)
 {
   // Ensure in output file
   if (fAlphaOutputFile) fAlphaOutputFile->cd();
 
   // Write objects
-  linReg.Axy.Write("slopes");
-  linReg.dAxy.Write("sigSlopes");
+  reg.Axy.Write("slopes");
+  reg.dAxy.Write("sigSlopes");
 
-  linReg.mRPP.Write("IV_IV_correlation");
-  linReg.mRPY.Write("IV_DV_correlation");
-  linReg.mRYY.Write("DV_DV_correlation");
-  linReg.mRYYp.Write("DV_DV_correlation_prime");
+  reg.mRPP.Write("IV_IV_correlation");
+  reg.mRPY.Write("IV_DV_correlation");
+  reg.mRYY.Write("DV_DV_correlation");
+  reg.mRYYp.Write("DV_DV_correlation_prime");
 
-  linReg.mMP.Write("IV_mean");
-  linReg.mMY.Write("DV_mean");
-  linReg.mMYp.Write("DV_mean_prime");
+  reg.mMP.Write("IV_mean");
+  reg.mMY.Write("DV_mean");
+  reg.mMYp.Write("DV_mean_prime");
 
   // number of events
   TMatrixD Mstat(1,1);
-  Mstat(0,0)=linReg.getUsedEve();
+  Mstat(0,0)=reg.getUsedEve();
   Mstat.Write("MyStat");
 
   //... IVs
@@ -609,36 +692,36 @@ void QwCorrelator::WriteAlphaFile()
   hdv.Write();
 
   // sigmas
-  linReg.mSP.Write("IV_sigma");
-  linReg.mSY.Write("DV_sigma");
-  linReg.mSYp.Write("DV_sigma_prime");
+  reg.mSP.Write("IV_sigma");
+  reg.mSY.Write("DV_sigma");
+  reg.mSYp.Write("DV_sigma_prime");
 
   // raw covariances
-  linReg.mVPP.Write("IV_IV_rawVariance");
-  linReg.mVPY.Write("IV_DV_rawVariance");
-  linReg.mVYY.Write("DV_DV_rawVariance");
-  linReg.mVYYp.Write("DV_DV_rawVariance_prime");
-  TVectorD mVY2(TMatrixDDiag(linReg.mVYY));
+  reg.mVPP.Write("IV_IV_rawVariance");
+  reg.mVPY.Write("IV_DV_rawVariance");
+  reg.mVYY.Write("DV_DV_rawVariance");
+  reg.mVYYp.Write("DV_DV_rawVariance_prime");
+  TVectorD mVY2(TMatrixDDiag(reg.mVYY));
   mVY2.Write("DV_rawVariance");
-  TVectorD mVP2(TMatrixDDiag(linReg.mVPP));
+  TVectorD mVP2(TMatrixDDiag(reg.mVPP));
   mVP2.Write("IV_rawVariance");
-  TVectorD mVY2prime(TMatrixDDiag(linReg.mVYYp));
+  TVectorD mVY2prime(TMatrixDDiag(reg.mVYYp));
   mVY2prime.Write("DV_rawVariance_prime");
 
   // normalized covariances
-  linReg.mSPP.Write("IV_IV_normVariance");
-  linReg.mSPY.Write("IV_DV_normVariance");
-  linReg.mSYY.Write("DV_DV_normVariance");
-  linReg.mSYYp.Write("DV_DV_normVariance_prime");
-  TVectorD sigY2(TMatrixDDiag(linReg.mSYY));
+  reg.mSPP.Write("IV_IV_normVariance");
+  reg.mSPY.Write("IV_DV_normVariance");
+  reg.mSYY.Write("DV_DV_normVariance");
+  reg.mSYYp.Write("DV_DV_normVariance_prime");
+  TVectorD sigY2(TMatrixDDiag(reg.mSYY));
   sigY2.Write("DV_normVariance");
-  TVectorD sigX2(TMatrixDDiag(linReg.mSPP));
+  TVectorD sigX2(TMatrixDDiag(reg.mSPP));
   sigX2.Write("IV_normVariance");
-  TVectorD sigY2prime(TMatrixDDiag(linReg.mSYYp));
+  TVectorD sigY2prime(TMatrixDDiag(reg.mSYYp));
   sigY2prime.Write("DV_normVariance_prime");
 
-  linReg.Axy.Write("A_xy");
-  linReg.Ayx.Write("A_yx");
+  reg.Axy.Write("A_xy");
+  reg.Ayx.Write("A_yx");
 }
 
 void QwCorrelator::OpenAlphaFile(const std::string& prefix)
@@ -696,7 +779,7 @@ void QwCorrelator::CloseAliasFile()
   }
 }
 
-void QwCorrelator::WriteAliasFile()
+void QwCorrelator::WriteAliasFile(const LinRegBevPeb& reg)
 {
   // Ensure output file is open
   if (fAliasOutputFile.bad()) {
@@ -710,7 +793,7 @@ void QwCorrelator::WriteAliasFile()
     fAliasOutputFile << Form("  tree->SetAlias(\"reg_%s\",",fDependentFull[i].c_str()) << std::endl;
     fAliasOutputFile << Form("         \"%s",fDependentFull[i].c_str());
     for (int j = 0; j < nP; j++) {
-      fAliasOutputFile << Form("%+.4e*%s", -linReg.Axy(j,i), fIndependentFull[j].c_str());
+      fAliasOutputFile << Form("%+.4e*%s", -reg.Axy(j,i), fIndependentFull[j].c_str());
     }
     fAliasOutputFile << "\");" << std::endl;
   }
@@ -12,13 +12,17 @@
 #include "VQwDataHandler.h"
 #include "QwParameterFile.h"
 #include "QwHelicityPattern.h"
+#include "QwTaskThread.h"
 
 //*****************************************************************//
 /**
  * Create a handler array based on the configuration option 'detectors'
+ * @param burst Handler array that is finished at the end of every burst
  */
-QwDataHandlerArray::QwDataHandlerArray(QwOptions& options, QwHelicityPattern& helicitypattern, const TString &run)
-  : fHelicityPattern(0),fSubsystemArray(0),fDataHandlersMapFile(""),fArrayScope(kPatternScope)
+QwDataHandlerArray::QwDataHandlerArray(QwOptions& options, QwHelicityPattern& helicitypattern, const TString &run, Bool_t burst)
+  : fHelicityPattern(0),fSubsystemArray(0),fDataHandlersMapFile(""),
+    fArrayScope(burst? kBurstScope: kPatternScope),
+    fPipelineBursts(kFALSE)
 {
   ProcessOptions(options);
   if (fDataHandlersMapFile != ""){
@@ -32,7 +36,8 @@ QwDataHandlerArray::QwDataHandlerArray(QwOptions& options, QwHelicityPattern& he
  * Create a handler array based on the configuration option 'detectors'
  */
 QwDataHandlerArray::QwDataHandlerArray(QwOptions& options, QwSubsystemArrayParity& detectors, const TString &run)
-  : fHelicityPattern(0),fSubsystemArray(0),fDataHandlersMapFile(""),fArrayScope(kEventScope)
+  : fHelicityPattern(0),fSubsystemArray(0),fDataHandlersMapFile(""),fArrayScope(kEventScope),
+    fPipelineBursts(kFALSE)
 {
   ProcessOptions(options);
   if (fDataHandlersMapFile != ""){
@@ -52,7 +57,8 @@ QwDataHandlerArray::QwDataHandlerArray(const QwDataHandlerArray& source)
   fSubsystemArray(source.fSubsystemArray),
   fDataHandlersMapFile(source.fDataHandlersMapFile),
   fDataHandlersDisabledByName(source.fDataHandlersDisabledByName),
-  fDataHandlersDisabledByType(source.fDataHandlersDisabledByType)
+  fDataHandlersDisabledByType(source.fDataHandlersDisabledByType),
+  fPipelineBursts(source.fPipelineBursts)
 {
   // Make copies of all handlers rather than copying just the pointers
   for (const_iterator handler = source.begin(); handler != source.end(); ++handler) {
@@ -73,7 +79,9 @@ QwDataHandlerArray::QwDataHandlerArray(const QwDataHandlerArray& source)
 /// Destructor
 QwDataHandlerArray::~QwDataHandlerArray()
 {
-  // nothing
+  // Let the finisher complete before the handlers go away; results not
+  // collected by now are not filled, since the output files may be gone
+  if (fFinisher) fFinisher->Wait();
 }
 
 /*
@@ -120,7 +128,7 @@ void QwDataHandlerArray::LoadDataHandlersFromParameterFile(
     } else {
       //  Assume the scope of a handler without a scope specifier is
       //  "pattern".
-      if (fArrayScope != kPatternScope) continue;
+      if (ScopeMismatch("pattern")) continue;
     }
 
     // If handler type is explicitly disabled
@@ -250,6 +258,10 @@ void QwDataHandlerArray::DefineOptions(QwOptions &options)
                        po::value<std::vector <std::string> >()->multitoken(),
                        "handler names to disable");
 #endif // BOOST_VERSION
+
+  options.AddOptions()("pipeline-bursts",
+                       po::value<bool>()->default_bool_value(false),
+                       "finish the burst data handlers on a background thread");
 }
 
 
@@ -270,6 +282,9 @@ void QwDataHandlerArray::ProcessOptions(QwOptions &options)
 
   //  Get the globally defined print running sum flag
   fPrintRunningSum = options.GetValue<bool>("print-runningsum");
+
+  //  Finish bursts in the background
+  fPipelineBursts = options.GetValue<bool>("pipeline-bursts");
 }
 
 /**
@@ -720,3 +735,47 @@ void QwDataHandlerArray::FinishDataHandler()
     }
   }
 }
+
+/**
+ * Finish the data handlers at the end of a burst.  With the option
+ * 'pipeline-bursts', handlers which support it hand a snapshot of their
+ * state to a background thread and the event loop continues with cleared
+ * accumulators; their results are filled into the trees by the next call
+ * of FillFinishedDataHandlers().  All other handlers are finished here.
+ */
+void QwDataHandlerArray::FinishDataHandlerInBackground()
+{
+  if (! fPipelineBursts) {
+    FinishDataHandler();
+    return;
+  }
+  // Fill the previous burst first, which keeps the tree entries in order
+  FillFinishedDataHandlers();
+  if (empty()) return;
+  for (iterator handler = begin(); handler != end(); ++handler) {
+    if ((*handler)->SnapshotDataHandler())
+      fFinishing.push_back(handler->get());
+    else
+      (*handler)->FinishDataHandler();
+  }
+  if (fFinishing.empty()) return;
+  if (! fFinisher) fFinisher.reset(new QwTaskThread());
+  std::vector<VQwDataHandler*> finishing(fFinishing);
+  fFinisher->Submit([finishing]() {
+    for (size_t i = 0; i < finishing.size(); i++)
+      finishing[i]->FinishSnapshot();
+  });
+}
+
+/**
+ * Wait for the background finisher and fill the results of the snapshots
+ * handed to it; to be called before the output files are written
+ */
+void QwDataHandlerArray::FillFinishedDataHandlers()
+{
+  if (fFinishing.empty()) return;
+  fFinisher->Wait();
+  for (size_t i = 0; i < fFinishing.size(); i++)
+    fFinishing[i]->FillSnapshot();
+  fFinishing.clear();
+}
@@ -12,11 +12,31 @@
 
 /** Constructor: initialize ring buffer with specified size and options. */
 QwEventRing::QwEventRing(QwOptions &options, QwSubsystemArrayParity &event)
-  : fRollingAvg(event), fBurpAvg(event)
+  : fCompress(kFALSE), fPackedSize(0), fLoadedSlot(-1),
+    fRollingAvg(event), fBurpAvg(event)
 {
   ProcessOptions(options);
 
-  fEvent_Ring.resize(fRING_SIZE,event);
+  if (fCompress) {
+    fSlotEvent.reset(new QwSubsystemArrayParity(event));
+    fSlotEvent->PackEventData(fPackBuffer);
+    fPackedSize = fPackBuffer.size();
+    fPackedRing.resize(fRING_SIZE * fPackedSize);
+    fUnpackedRing.resize(fRING_SIZE);
+    size_t nunpacked = 0;
+    for (size_t i = 0; i < fSlotEvent->size(); i++) {
+      if (fSlotEvent->at(i) == nullptr || fSlotEvent->IsPackable(i)) continue;
+      nunpacked++;
+      for (Int_t slot = 0; slot < fRING_SIZE; slot++)
+        fUnpackedRing[slot].push_back(
+          std::shared_ptr<VQwSubsystem>(fSlotEvent->at(i)->Clone()));
+    }
+    QwMessage << "QwEventRing: keeping " << fRING_SIZE << " events as packed records of "
+              << fPackedSize << " bytes, with copies of " << nunpacked
+              << " of " << fSlotEvent->size() << " subsystems" << QwLog::endl;
+  } else {
+    fEvent_Ring.resize(fRING_SIZE,event);
+  }
 
   bRING_READY = kFALSE;
   bEVENT_READY = kTRUE;
@@ -61,6 +81,9 @@ void QwEventRing::DefineOptions(QwOptions &options)
   options.AddOptions()("ring.holdoff",
       po::value<int>()->default_value(200),
       "QwEventRing: number of events ignored after the beam trips");
+  options.AddOptions()("ring.compress",
+      po::value<bool>()->default_bool_value(false),
+      "QwEventRing: keep the events in the ring as packed records");
 }
 
 /** Process options and validate ring/burp parameter consistency. */
@@ -110,6 +133,62 @@ void QwEventRing::ProcessOptions(QwOptions &options)
     bStability=kFALSE;
 
   fPrintAfterUnwind = gQwOptions.GetValue<bool>("ring.print-after-unwind");
+  fCompress = gQwOptions.GetValue<bool>("ring.compress");
+}
+
+/**
+ * Copy an event into a slot of the ring.  In the compressed ring the
+ * packable subsystems are packed into the record of the slot, and the
+ * others are assigned to the copies of the slot.
+ */
+void QwEventRing::Store(Int_t slot, const QwSubsystemArrayParity &event)
+{
+  if (! fCompress) {
+    fEvent_Ring[slot] = event;
+    return;
+  }
+  fPackBuffer.clear();
+  event.PackEventData(fPackBuffer);
+  std::copy(fPackBuffer.begin(), fPackBuffer.end(),
+            fPackedRing.begin() + slot * fPackedSize);
+  size_t j = 0;
+  for (size_t i = 0; i < event.size(); i++) {
+    if (event.at(i) == nullptr || fSlotEvent->IsPackable(i)) continue;
+    *(fUnpackedRing[slot][j++].get()) = event.at(i).get();
+  }
+  if (fLoadedSlot == slot) fLoadedSlot = -1;
+}
+
+/**
+ * Return the event in a slot of the ring.  The compressed ring rebuilds it
+ * in the scratch event, which stays valid until another slot is loaded.
+ */
+QwSubsystemArrayParity& QwEventRing::Load(Int_t slot)
+{
+  if (! fCompress) return fEvent_Ring[slot];
+  if (fLoadedSlot != slot) {
+    fSlotEvent->UnpackEventData(&fPackedRing[slot * fPackedSize]);
+    size_t j = 0;
+    for (size_t i = 0; i < fSlotEvent->size(); i++) {
+      if (fSlotEvent->at(i) == nullptr || fSlotEvent->IsPackable(i)) continue;
+      *(fSlotEvent->at(i).get()) = fUnpackedRing[slot][j++].get();
+    }
+    fLoadedSlot = slot;
+  }
+  return *fSlotEvent;
+}
+
+/// Write back the event of a slot that was modified after Load
+void QwEventRing::Save(Int_t slot)
+{
+  if (fCompress) Store(slot, *fSlotEvent);
+  fLoadedSlot = slot;
+}
+
+UInt_t QwEventRing::GetEventcutErrorFlag(Int_t slot)
+{
+  if (! fCompress) return fEvent_Ring[slot].GetEventcutErrorFlag();
+  return QwSubsystemArrayParity::GetPackedEventcutErrorFlag(&fPackedRing[slot * fPackedSize]);
 }
 /**
  * Add an event to the ring buffer, applying stability cuts and burp detection.
@@ -124,7 +203,7 @@ void QwEventRing::push(QwSubsystemArrayParity &event)
   if (bEVENT_READY){
     Int_t thisevent = fNextToBeFilled;
     Int_t prevevent = (thisevent+fRING_SIZE-1)%fRING_SIZE;
-    fEvent_Ring[thisevent]=event;//copy the current good event to the ring
+    Store(thisevent, event);//copy the current good event to the ring
     if (bStability){
       fRollingAvg.AccumulateAllRunningSum(event);
     }
@@ -162,18 +241,27 @@ void QwEventRing::push(QwSubsystemArrayParity &event)
 	      //  might have a local stability cut failure, instead of just this
 	      //  global stability cut failure.
 	      for(Int_t i=0;i<fRING_SIZE;i++){
-	        fEvent_Ring[i].UpdateErrorFlag(fRollingAvg);
-	        fEvent_Ring[i].UpdateErrorFlag();
+	        Load(i).UpdateErrorFlag(fRollingAvg);
+	        Load(i).UpdateErrorFlag();
+	        Save(i);
 	      }
 	    }
-	    if ((fEvent_Ring[thisevent].GetEventcutErrorFlag() & kBCMErrorFlag)!=0 &&
-	        (fEvent_Ring[prevevent].GetEventcutErrorFlag() & kBCMErrorFlag)!=0){
+	    if ((GetEventcutErrorFlag(thisevent) & kBCMErrorFlag)!=0 &&
+	        (GetEventcutErrorFlag(prevevent) & kBCMErrorFlag)!=0){
         countdown = holdoff;
       }
       if (countdown > 0) {
         --countdown;
   	    for(Int_t i=0;i<fRING_SIZE;i++){
-	        fEvent_Ring[i].UpdateErrorFlag(kBeamTripError);
+	        if (fCompress) {
+	          //  The error flag is in the record header, so only the
+	          //  record and a rebuilt copy of it need the update
+	          QwSubsystemArrayParity::UpdatePackedErrorFlag(&fPackedRing[i * fPackedSize],
+	                                                        kBeamTripError);
+	          if (fLoadedSlot == i) fSlotEvent->UpdateErrorFlag(kBeamTripError);
+	        } else {
+	          fEvent_Ring[i].UpdateErrorFlag(kBeamTripError);
+	        }
 	      }
     	}
     }
@@ -200,7 +288,7 @@ QwSubsystemArrayParity& QwEventRing::pop(){
     bRING_READY=kFALSE;//setting to false is an extra measure of security to prevent reading a NULL value.
   }
   if (bStability){
-     fRollingAvg.DeaccumulateRunningSum(fEvent_Ring[tempIndex]);
+     fRollingAvg.DeaccumulateRunningSum(Load(tempIndex));
   }
 
   // Increment read index
@@ -208,7 +296,7 @@ QwSubsystemArrayParity& QwEventRing::pop(){
   fNextToBeRead = (fNextToBeRead + 1) % fRING_SIZE;
 
   // Return the event
-  return fEvent_Ring[tempIndex];
+  return Load(tempIndex);
 }
 
 
@@ -224,16 +312,17 @@ Bool_t QwEventRing::IsReady(){ //Check for readiness to read data from the ring
 void QwEventRing::CheckBurpCut(Int_t thisevent)
 {
   if (bRING_READY || thisevent>fBurpExtent){
-    if (fBurpAvg.CheckForBurpFail(fEvent_Ring[thisevent])){
+    if (fBurpAvg.CheckForBurpFail(Load(thisevent))){
       Int_t precut_start = (thisevent+fRING_SIZE-fBurpPrecut)%fRING_SIZE;
       for(Int_t i=precut_start;i!=(thisevent+1)%fRING_SIZE;i=(i+1)%fRING_SIZE){
-	      fEvent_Ring[i].UpdateErrorFlag(fBurpAvg);
-	      fEvent_Ring[i].UpdateErrorFlag();
+	      Load(i).UpdateErrorFlag(fBurpAvg);
+	      Load(i).UpdateErrorFlag();
+	      Save(i);
       }
     }
     Int_t beforeburp = (thisevent+fRING_SIZE-fBurpExtent-1)%fRING_SIZE;
-    fBurpAvg.DeaccumulateRunningSum(fEvent_Ring[beforeburp], kPreserveError);
+    fBurpAvg.DeaccumulateRunningSum(Load(beforeburp), kPreserveError);
   }
-  fBurpAvg.AccumulateAllRunningSum(fEvent_Ring[thisevent], 0, kPreserveError);
+  fBurpAvg.AccumulateAllRunningSum(Load(thisevent), 0, kPreserveError);
 
 }
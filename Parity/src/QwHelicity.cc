@@ -132,6 +132,7 @@ void QwHelicity::DefineOptions(QwOptions &options)
   options.AddOptions("Helicity options")
       ("helicity.toggle-mode", po::value<bool>()->default_bool_value(false),
           "Activates helicity toggle-mode, overriding the 'delay', 'patternphase', 'bitpattern', and 'seed' options.");
+  DefinePredictorSeedOptions(options);
 }
 
 //**************************************************//
@@ -189,6 +190,8 @@ void QwHelicity::ProcessOptions(QwOptions &options)
   if (fMaxPatternPhase > 8 && fHelicityBitPattern == kDefaultHelicityBitPattern) {
   }
 
+  ProcessPredictorSeedOptions(options);
+
   //  Here we're going to try to get the "online" option which
   //  is defined by QwEventBuffer.
   if (options.HasValue("online")){
@@ -138,6 +138,10 @@ QwHelicityBase::QwHelicityBase(const QwHelicityBase& source)
   iseed_Delayed = source.iseed_Delayed;
   iseed_Actual = source.iseed_Actual;
   n_ranbits = source.n_ranbits;
+  fUsePredictorSeed = source.fUsePredictorSeed;
+  fPredictorSeed = source.fPredictorSeed;
+  fPredictorSeedPattern = source.fPredictorSeedPattern;
+  fPrintPredictorSeed = source.fPrintPredictorSeed;
   fEventNumber = source.fEventNumber;
   fEventNumberOld = source.fEventNumberOld;
   fPatternPhaseNumber = source.fPatternPhaseNumber;
@@ -170,6 +174,35 @@ void QwHelicityBase::DefineOptions(QwOptions &options)
   options.AddOptions("Helicity options")
       ("helicity.toggle-mode", po::value<bool>()->default_bool_value(false),
           "Activates helicity toggle-mode, overriding the 'delay', 'patternphase', 'bitpattern', and 'seed' options.");
+  DefinePredictorSeedOptions(options);
+}
+
+void QwHelicityBase::DefinePredictorSeedOptions(QwOptions &options)
+{
+  options.AddOptions("Helicity options")
+      ("helicity.seed-value", po::value<std::string>(),
+          "Delayed helicity predictor seed (hex) at pattern helicity.seed-pattern; the predictor jumps ahead from it instead of collecting the first 24/30 patterns (printed at the end of a run with helicity.print-seed)");
+  options.AddOptions("Helicity options")
+      ("helicity.seed-pattern", po::value<long long>(),
+          "Pattern number of helicity.seed-value");
+  options.AddOptions("Helicity options")
+      ("helicity.print-seed", po::value<bool>()->default_bool_value(false),
+          "Print the delayed helicity predictor seed and its pattern number at the end of a run");
+}
+
+void QwHelicityBase::ProcessPredictorSeedOptions(QwOptions &options)
+{
+  fPrintPredictorSeed = options.GetValue<bool>("helicity.print-seed");
+  if (options.HasValue("helicity.seed-value") && options.HasValue("helicity.seed-pattern")) {
+    fPredictorSeed = QwParameterFile::GetUInt(options.GetValue<std::string>("helicity.seed-value"));
+    fPredictorSeedPattern = options.GetValue<long long>("helicity.seed-pattern");
+    fUsePredictorSeed = (fPredictorSeed != 0) && CheckJumpAhead(fPredictorSeed);
+    if (fUsePredictorSeed)
+      QwMessage << " Helicity predictor seed = 0x" << std::hex << fPredictorSeed << std::dec
+                << " at pattern " << fPredictorSeedPattern << QwLog::endl;
+  } else if (options.HasValue("helicity.seed-value") || options.HasValue("helicity.seed-pattern")) {
+    QwError << "Both helicity.seed-value and helicity.seed-pattern are needed!" << QwLog::endl;
+  }
 }
 
 //**************************************************//
@@ -230,6 +263,8 @@ void QwHelicityBase::ProcessOptions(QwOptions &options)
     BuildHelicityBitPattern(fMaxPatternPhase);
   }
 
+  ProcessPredictorSeedOptions(options);
+
   //  Here we're going to try to get the "online" option which
   //  is defined by QwEventBuffer.
   if (options.HasValue("online")){
@@ -438,6 +473,10 @@ void QwHelicityBase::PrintErrorCounters() const{
   QwMessage << "Number of helicity prediction errors: "
 	    << fNumHelicityErrors
 	    << QwLog::endl;
+  if (fPrintPredictorSeed && n_ranbits == UInt_t(fRandBits))
+    QwMessage << "Helicity predictor seed: --helicity.seed-value 0x" << std::hex
+              << iseed_Delayed << std::dec << " --helicity.seed-pattern "
+              << fPatternNumber << QwLog::endl;
   QwMessage <<"---------------------------------------------------\n"
 	    << QwLog::endl;
 }
@@ -695,6 +734,103 @@ void QwHelicityBase::SetFirstBits(UInt_t nbits, UInt_t seed)
   for (int i = 0; i < fHelicityDelay; i++) GetRandbit(iseed_Actual);
 }
 
+/**
+ * Advance a predictor seed by a number of patterns.  The shift register
+ * update in GetRandbit is linear over GF(2), so advancing by n patterns is
+ * a multiplication with the n-th power of the one-step matrix, which takes
+ * O(log n) matrix products by repeated squaring.  The matrices are stored
+ * as the images of the unit vectors, i.e. one register word per column.
+ * @param seed Predictor seed
+ * @param npatterns Number of patterns
+ * @return Predictor seed after npatterns patterns
+ */
+UInt_t QwHelicityBase::JumpAhead(UInt_t seed, ULong64_t npatterns)
+{
+  const Int_t nbits = fRandBits;
+  // Apply a matrix to a register word
+  auto apply = [nbits](const UInt_t* matrix, UInt_t word) {
+    UInt_t result = 0;
+    for (Int_t j = 0; j < nbits; j++)
+      if ((word >> j) & 0x1) result ^= matrix[j];
+    return result;
+  };
+  // One-step matrix
+  UInt_t power[32], square[32];
+  for (Int_t j = 0; j < nbits; j++) {
+    power[j] = 1u << j;
+    GetRandbit(power[j]);
+  }
+  while (npatterns > 0) {
+    if (npatterns & 0x1) seed = apply(power, seed);
+    npatterns >>= 1;
+    if (npatterns > 0) {
+      for (Int_t j = 0; j < nbits; j++) square[j] = apply(power, power[j]);
+      for (Int_t j = 0; j < nbits; j++) power[j] = square[j];
+    }
+  }
+  return seed;
+}
+
+/**
+ * Check jump-ahead against stepping the shift register one pattern at a time
+ * @param seed Predictor seed to start from
+ * @return True when they agree
+ */
+Bool_t QwHelicityBase::CheckJumpAhead(UInt_t seed)
+{
+  UInt_t stepped = seed;
+  for (ULong64_t n = 1; n <= 1000; n++) {
+    GetRandbit(stepped);
+    if (n % 37 != 0 && n != 1000) continue;
+    UInt_t jumped = JumpAhead(seed, n);
+    if (jumped != stepped) {
+      QwError << "Helicity predictor jump-ahead by " << n << " patterns gives 0x"
+              << std::hex << jumped << " instead of 0x" << stepped << std::dec
+              << QwLog::endl;
+      return kFALSE;
+    }
+  }
+  return kTRUE;
+}
+
+/**
+ * Seed the predictor from the delayed seed known at some pattern number;
+ * from the next pattern onwards the predictor jumps ahead from this seed
+ * instead of collecting the pattern polarities.
+ * @param seed Delayed predictor seed at the pattern
+ * @param pattern Pattern number
+ */
+void QwHelicityBase::SetPredictorSeed(UInt_t seed, Long64_t pattern)
+{
+  fPredictorSeed = seed;
+  fPredictorSeedPattern = pattern;
+  fUsePredictorSeed = kTRUE;
+}
+
+void QwHelicityBase::JumpPredictor()
+{
+  //  The register sequence repeats after 2^n - 1 patterns, which also
+  //  allows jumping backward
+  const Long64_t period = (1LL << fRandBits) - 1;
+  Long64_t distance = (fPatternNumber - fPredictorSeedPattern) % period;
+  if (distance < 0) distance += period;
+
+  //  The seed after a pattern has the pattern polarity in its lowest bit
+  iseed_Delayed = JumpAhead(fPredictorSeed, distance);
+  fDelayedPatternPolarity = iseed_Delayed & 0x1;
+  fHelicityDelayed = fDelayedPatternPolarity;
+  if (fHelicityDelay > 0)
+    fPreviousPatternPolarity = JumpAhead(iseed_Delayed, fHelicityDelay - 1) & 0x1;
+  iseed_Actual = JumpAhead(iseed_Delayed, fHelicityDelay);
+  fActualPatternPolarity = iseed_Actual & 0x1;
+  fHelicityActual = fActualPatternPolarity;
+
+  n_ranbits = fRandBits;
+  fGoodHelicity = kFALSE;
+  QwMessage << "Jumped helicity predictor to pattern " << fPatternNumber
+            << " (event #" << fEventNumber << ")" << QwLog::endl;
+}
+
 void QwHelicityBase::SetHistoTreeSave(const TString &prefix)
 {
   Ssiz_t len;
@@ -1463,7 +1599,11 @@ void QwHelicityBase::PredictHelicity()
       can now be set as a cmd line option.
    */
 
-   if(CollectRandBits()) {
+   if (fUsePredictorSeed && n_ranbits != UInt_t(fRandBits)
+       && fPatternPhaseNumber == fMinPatternPhase && fPatternNumber >= 0) {
+     /** With a known seed, jump to this pattern instead of collecting bits. */
+     JumpPredictor();
+   } else if(CollectRandBits()) {
      /**After accumulating 24/30 helicity bits, iseed is up-to-date.
 	If nothing goes wrong, n-ranbits will stay as 24/30
 	Reset it to zero if something goes wrong.
@@ -1524,6 +1664,28 @@ void QwHelicityBase::SetHelicityBitPattern(TString hex)
   QwMessage << std::dec << QwLog::endl;
 }
 
+/**
+ * Forget the event and pattern numbers, the predictor sequence and the
+ * error counters of the previous run, as if the subsystem had just been
+ * constructed from its parameter files.
+ */
+void QwHelicityBase::ClearRunState()
+{
+  ClearEventData();
+  fEventNumberOld = -1; fEventNumber = -1;
+  fPatternPhaseNumberOld = -1; fPatternPhaseNumber = -1;
+  fPatternNumberOld = -1; fPatternNumber = -1;
+  fEventNumberFirst = -1; fPatternNumberFirst = -1;
+  fActualPatternPolarity = kUndefinedHelicity;
+  fDelayedPatternPolarity = kUndefinedHelicity;
+  fHelicityReported = kUndefinedHelicity;
+  fHelicityActual = kUndefinedHelicity;
+  fHelicityDelayed = kUndefinedHelicity;
+  ClearErrorCounters();
+  ResetPredictor();
+}
+
+
 void QwHelicityBase::ResetPredictor()
 {
   /**Start a new helicity prediction sequence.*/
@@ -45,6 +45,9 @@ void QwHelicityPattern::DefineOptions(QwOptions &options)
   options.AddOptions("Helicity pattern")
     ("enable-alternateasym", po::value<bool>()->default_bool_value(false),
      "enable alternate asymmetries");
+  options.AddOptions("Helicity pattern")
+    ("pattern-from-pairs", po::value<bool>()->default_bool_value(false),
+     "derive the pattern yield and difference from the sums of its pairs (faster, but rounds differently from the sum of its phases)");
 
   options.AddOptions("Helicity pattern")
     ("print-burstsum", po::value<bool>()->default_bool_value(false),
@@ -85,6 +88,7 @@ void QwHelicityPattern::ProcessOptions(QwOptions &options)
 
   fEnableDifference    = options.GetValue<bool>("enable-differences");
   fEnableAlternateAsym = options.GetValue<bool>("enable-alternateasym");
+  fUsePairSums         = options.GetValue<bool>("pattern-from-pairs");
 
   fBurstLength = options.GetValue<int>("burstlength");
   if (fBurstLength == 0) DisableBurstSum();
@@ -99,6 +103,12 @@ void QwHelicityPattern::ProcessOptions(QwOptions &options)
 	      << QwLog::endl;
     fEnableAlternateAsym = kFALSE;
   }
+  // Release the alternate asymmetry arrays when they are not needed
+  if (! fEnableAlternateAsym) {
+    fAsymmetry1.ReleaseSubsystems();
+    fAsymmetry2.ReleaseSubsystems();
+    fAlternateDiff.ReleaseSubsystems();
+  }
 
   fBlinder.ProcessOptions(options);
 }
@@ -118,6 +128,11 @@ QwHelicityPattern::QwHelicityPattern(QwSubsystemArrayParity &event, const TStrin
     fPairYield(event),
     fPairDifference(event),
     fPairAsymmetry(event),
+    fUsePairSums(kFALSE),
+    fPatternPairSum(event),
+    fPatternPairDifference(event),
+    fPairsInPatternSums(0),
+    fPatternPairSumsValid(kFALSE),
     fBurstLength(0),
     fMaxBurstIndex(0x7fffffff),
     fPrintIndexFile(kFALSE),
@@ -206,9 +221,15 @@ QwHelicityPattern::QwHelicityPattern(const QwHelicityPattern &source)
   fEnableAlternateAsym(source.fEnableAlternateAsym),
   fAsymmetry1(source.fAsymmetry1),
   fAsymmetry2(source.fAsymmetry2),
+  fEnablePairs(kFALSE),
   fPairYield(source.fYield),
   fPairDifference(source.fYield),
   fPairAsymmetry(source.fYield),
+  fUsePairSums(kFALSE),
+  fPatternPairSum(source.fYield),
+  fPatternPairDifference(source.fYield),
+  fPairsInPatternSums(0),
+  fPatternPairSumsValid(kFALSE),
   fBurstLength(source.fBurstLength),
   fMaxBurstIndex(source.fMaxBurstIndex),
   fPrintIndexFile(source.fPrintIndexFile),
@@ -231,6 +252,16 @@ QwHelicityPattern::QwHelicityPattern(const QwHelicityPattern &source)
   fPatternIsGood(false),
   fIsDataLoaded(false)
 {
+  // Copies hold running sums and never see events of a pattern, so
+  // they need neither the pair arrays nor the helicity sums
+  fPairYield.ReleaseSubsystems();
+  fPairDifference.ReleaseSubsystems();
+  fPairAsymmetry.ReleaseSubsystems();
+  fPatternPairSum.ReleaseSubsystems();
+  fPatternPairDifference.ReleaseSubsystems();
+  fAlternateDiff.ReleaseSubsystems();
+  fPositiveHelicitySum.ReleaseSubsystems();
+  fNegativeHelicitySum.ReleaseSubsystems();
 };
 
 
@@ -276,7 +307,7 @@ void QwHelicityPattern::LoadEventData(QwSubsystemArrayParity &event)
 
         //std::cout << " local phase: " << localPhaseNumber << " : local event : " << localEventNumber << " : local Pattern : " << localPatternNumber << " : local helicity : " << localHelicityActual << std::endl;
       } else {
-	QwError << "QwHelicityPattern::LoadEventData:  The helicity subsystem does not have valid data!"
+	QwErrorLimited(this,10) << "QwHelicityPattern::LoadEventData:  The helicity subsystem does not have valid data!"
 		<< QwLog::endl;
       }
     } else {
@@ -317,13 +348,14 @@ void QwHelicityPattern::LoadEventData(QwSubsystemArrayParity &event)
     fCurrentPatternNumber=localPatternNumber;
   }
   if(localPhaseNumber<0){
-std::cout << "local phase no: " << localPhaseNumber << " current pattern no: " << fCurrentPatternNumber << std::endl;
-    QwWarning << "QwHelicityPattern::LoadEventData:  "
-	    << "Reduced event phase number is less than zero; ignore this event."
+    QwWarningLimited(this,10) << "QwHelicityPattern::LoadEventData:  "
+	    << "Reduced event phase number " << localPhaseNumber
+	    << " is less than zero in pattern " << fCurrentPatternNumber
+	    << "; ignore this event."
 	    << QwLog::endl;
     ClearEventData();
   } else if(localPhaseNumber >= static_cast<Int_t>(fPatternSize)){
-    QwWarning<<" In QwHelicityPattern::LoadEventData trying upload an event with a phase larger than expected \n"
+    QwWarningLimited(this,10)<<" In QwHelicityPattern::LoadEventData trying upload an event with a phase larger than expected \n"
 	   <<" phase ="<<localPhaseNumber+1<<" maximum expected phase="<<fPatternSize<<"\n"
 	   <<" operation impossible, pattern reset to 0: no asymmetries will be computed "<<QwLog::endl;
     ClearEventData();
@@ -332,6 +364,9 @@ std::cout << "local phase no: " << localPhaseNumber << " current pattern no: " <
       std::cout<<"QwHelicityPattern::LoadEventData local i="
 	       <<localPhaseNumber<<"\n";
     }
+    //  A phase of a pair which is already in the pair sums is replaced
+    if (static_cast<size_t>(localPhaseNumber)/2 < fNextPair)
+      fPatternPairSumsValid = kFALSE;
     fEvents[localPhaseNumber]      = event;
     fEventLoaded[localPhaseNumber] = kTRUE;
     fHelicity[localPhaseNumber]    = localHelicityActual;
@@ -390,17 +425,30 @@ void  QwHelicityPattern::CalculatePairAsymmetry()
     fNextPair++;
 
     fPairYield.Sum(fEvents.at(firstevt), fEvents.at(secondevt));
+    if (fPatternPairSumsValid) {
+      //  Like the sum of the helicity sums, the pattern yield starts with
+      //  the first positive helicity event, whose data it keeps where the
+      //  data are not summed (e.g. the helicity bits)
+      if (fPairsInPatternSums == 0 && fHelicity[firstevt] != plushel)
+        fPatternPairSum.Sum(fEvents.at(secondevt), fEvents.at(firstevt));
+      else
+        AddToPatternPairSum(fPatternPairSum, fPairYield);
+    }
     fPairYield.Scale(0.5);
 
     if (fIgnoreHelicity){
       fPairDifference.Difference(fEvents.at(firstevt), fEvents.at(secondevt));
       fPairDifference.Scale(0.5);
+      //  The pattern assigns the helicity by the phase parity, not by pair
+      fPatternPairSumsValid = kFALSE;
     } else {
       if (fHelicity[firstevt] == plushel && fHelicity[firstevt]!=fHelicity[secondevt]) {
 	fPairDifference.Difference(fEvents.at(firstevt), fEvents.at(secondevt));
+	if (fPatternPairSumsValid) AddToPatternPairSum(fPatternPairDifference, fPairDifference);
 	fPairDifference.Scale(0.5);
       } else if (fHelicity[firstevt] == minushel && fHelicity[firstevt]!=fHelicity[secondevt]) {
 	fPairDifference.Difference(fEvents.at(secondevt),fEvents.at(firstevt));
+	if (fPatternPairSumsValid) AddToPatternPairSum(fPatternPairDifference, fPairDifference);
 	fPairDifference.Scale(0.5);
       } else if (fHelicity[firstevt] == -9999 || fHelicity[secondevt]==-9999) {
 	checkhel= -9999;
@@ -427,6 +475,12 @@ void  QwHelicityPattern::CalculatePairAsymmetry()
     }
   }
 
+  if (fPairIsGood) {
+    fPairsInPatternSums++;
+  } else {
+    fPatternPairSumsValid = kFALSE;
+  }
+
   if (fPairIsGood){
     if (! fIgnoreHelicity){
       //      // Update the blinder if conditions have changed
@@ -449,6 +503,21 @@ void  QwHelicityPattern::CalculatePairAsymmetry()
 }
 
 
+/**
+ * Add an unscaled pair sum or pair difference to the sums of the current
+ * pattern; the first pair of the pattern is copied.
+ */
+void QwHelicityPattern::AddToPatternPairSum(
+  QwSubsystemArrayParity& sum,
+  const QwSubsystemArrayParity& value)
+{
+  if (fPairsInPatternSums == 0)
+    sum = value;
+  else
+    sum += value;
+}
+
+
 Bool_t QwHelicityPattern::IsGoodAsymmetry()
 {
   Bool_t complete_and_good = kFALSE;
@@ -505,7 +574,15 @@ void  QwHelicityPattern::CalculateAsymmetry()
   fPositiveHelicitySum.ClearEventData();
   fNegativeHelicitySum.ClearEventData();
 
-  if (fIgnoreHelicity){
+  //  With all pairs good and in the pair sums, the sum of the pairs is the
+  //  sum of both helicities, and the sum of the pair differences is their
+  //  difference, so the phases do not have to be added up again
+  Bool_t from_pairs = fPatternPairSumsValid
+    && fPairsInPatternSums == fPatternSize/2 && ! fIgnoreHelicity;
+
+  if (from_pairs){
+    //  The pair helicities have been checked already
+  } else if (fIgnoreHelicity){
     //  Don't check to see if we have equal numbers of even and odd helicity states in this pattern.
     //  Build an asymmetry with even-parity phases as "+" and odd-parity phases as "-"
     for (size_t i = 0; i < fPatternSize; i++) {
@@ -584,9 +661,14 @@ void  QwHelicityPattern::CalculateAsymmetry()
     fQuartetNumber++;//Then increment the quartet number
     //std::cout<<" quartet count ="<<fQuartetNumber<<"\n";
 
-    fYield.Sum(fPositiveHelicitySum,fNegativeHelicitySum);
+    if (from_pairs) {
+      fYield = fPatternPairSum;
+      fDifference = fPatternPairDifference;
+    } else {
+      fYield.Sum(fPositiveHelicitySum,fNegativeHelicitySum);
+      fDifference.Difference(fPositiveHelicitySum,fNegativeHelicitySum);
+    }
     fYield.Scale(1.0/fPatternSize);
-    fDifference.Difference(fPositiveHelicitySum,fNegativeHelicitySum);
     fDifference.Scale(1.0/fPatternSize);
 
 
@@ -693,6 +775,8 @@ void QwHelicityPattern::ClearEventData()
 
   fPairIsGood = kFALSE;
   fNextPair   = 0;
+  fPairsInPatternSums   = 0;
+  fPatternPairSumsValid = fUsePairSums && fEnablePairs;
 
 
   fGoodPatterns = 0;
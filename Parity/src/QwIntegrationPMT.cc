@@ -506,12 +506,16 @@ void QwIntegrationPMT::Scale(Double_t factor)
   return;
 }
 
-void QwIntegrationPMT::Normalize(VQwDataElement* denom)
+void QwIntegrationPMT::Normalize(const VQwDataElement* denom)
 {
   if (fIsNormalizable) {
-    QwMollerADC_Channel* denom_ptr = dynamic_cast<QwMollerADC_Channel*>(denom);
-    QwMollerADC_Channel vqwk_denom(*denom_ptr);
-    fTriumf_ADC.DivideBy(vqwk_denom);
+    const QwMollerADC_Channel* denom_ptr = dynamic_cast<const QwMollerADC_Channel*>(denom);
+    if (denom_ptr)
+      fTriumf_ADC.DivideBy(*denom_ptr);
+    else
+      QwErrorLimited(this,1) << GetElementName() << " cannot be normalized "
+                             << "by a channel that is not a MollerADC channel"
+                             << QwLog::endl;
   }
 }
 
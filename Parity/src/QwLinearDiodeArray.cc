@@ -139,6 +139,27 @@ void QwLinearDiodeArray::IncrementErrorCounters()
   fEffectiveCharge.IncrementErrorCounters();
 }
 
+/** \brief Collect the error flags of all internal channels. */
+void QwLinearDiodeArray::CollectErrorFlags(std::vector<const UInt_t*>& flags) const
+{
+  size_t i=0;
+  for(i=0;i<8;i++) fPhotodiode[i].CollectErrorFlags(flags);
+  for(i=kXAxis;i<kNumAxes;i++) {
+    fRelPos[i].CollectErrorFlags(flags);
+  }
+  fEffectiveCharge.CollectErrorFlags(flags);
+}
+
+void QwLinearDiodeArray::CollectChannels(std::vector<VQwHardwareChannel*>& channels)
+{
+  size_t i=0;
+  for(i=0;i<8;i++) fPhotodiode[i].CollectChannels(channels);
+  for(i=kXAxis;i<kNumAxes;i++) {
+    fRelPos[i].CollectChannels(channels);
+  }
+  fEffectiveCharge.CollectChannels(channels);
+}
+
 /** \brief Print error counters for all internal channels. */
 void QwLinearDiodeArray::PrintErrorCounters() const
 {
@@ -131,6 +131,19 @@ void QwMollerDetector::ProcessOptions(QwOptions &){}
 Int_t QwMollerDetector::LoadInputParameters(TString){ return 0;}
 void QwMollerDetector::ClearEventData(){}
 
+/// The scalers are differenced with the previous reading, which starts
+/// from zero again in a new run
+void QwMollerDetector::ClearRunState()
+{
+  ClearEventData();
+  for (size_t i = 0; i < fSTR7200_Channel.size(); i++)
+    for (size_t j = 0; j < fSTR7200_Channel[i].size(); j++)
+      fSTR7200_Channel[i][j].ClearRunState();
+  for (size_t i = 0; i < fPrevious_STR7200_Channel.size(); i++)
+    for (size_t j = 0; j < fPrevious_STR7200_Channel[i].size(); j++)
+      fPrevious_STR7200_Channel[i][j].ClearRunState();
+}
+
 
 Int_t QwMollerDetector::ProcessConfigurationBuffer(const ROCID_t roc_id, const BankID_t bank_id, UInt_t* buffer, UInt_t num_words)
 {
@@ -156,6 +156,31 @@ void QwQPD::IncrementErrorCounters()
   fEffectiveCharge.IncrementErrorCounters();
 }
 
+/** Collect the error flags of all channels. */
+void QwQPD::CollectErrorFlags(std::vector<const UInt_t*>& flags) const
+{
+  Short_t i=0;
+  for(i=0;i<4;i++)
+    fPhotodiode[i].CollectErrorFlags(flags);
+  for(i=kXAxis;i<kNumAxes;i++) {
+    fRelPos[i].CollectErrorFlags(flags);
+    fAbsPos[i].CollectErrorFlags(flags);
+  }
+  fEffectiveCharge.CollectErrorFlags(flags);
+}
+
+void QwQPD::CollectChannels(std::vector<VQwHardwareChannel*>& channels)
+{
+  Short_t i=0;
+  for(i=0;i<4;i++)
+    fPhotodiode[i].CollectChannels(channels);
+  for(i=kXAxis;i<kNumAxes;i++) {
+    fRelPos[i].CollectChannels(channels);
+    fAbsPos[i].CollectChannels(channels);
+  }
+  fEffectiveCharge.CollectChannels(channels);
+}
+
 /** Print error counter summaries for all channels. */
 void QwQPD::PrintErrorCounters() const
 {
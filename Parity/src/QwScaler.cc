@@ -9,6 +9,9 @@
 
 #include "QwScaler.h"
 
+// System headers
+#include <algorithm>
+
 // ROOT headers
 #ifdef HAS_RNTUPLE_SUPPORT
 #include "ROOT/RNTupleModel.hxx"
@@ -16,6 +19,7 @@
 #endif // HAS_RNTUPLE_SUPPORT
 
 // Qweak headers
+#include "QwOptions.h"
 #include "QwParameterFile.h"
 
 
@@ -25,10 +29,11 @@ void QwScaler::DefineOptions(QwOptions &options)
   // Define command line options
 }
 
-/** Process command-line options for scaler subsystem (placeholder). */
-void QwScaler::ProcessOptions(QwOptions &/*options*/)
+/** Process command-line options for scaler subsystem. */
+void QwScaler::ProcessOptions(QwOptions &options)
 {
   // Handle command line options
+  fVerifyBankDecoder = options.GetValue<bool>("verify-bank-decoders");
 }
 
 
@@ -36,7 +41,8 @@ void QwScaler::ProcessOptions(QwOptions &/*options*/)
  * Constructor: initialize scaler subsystem with name.
  */
 QwScaler::QwScaler(const TString& name)
-: VQwSubsystem(name),VQwSubsystemParity(name)
+: VQwSubsystem(name),VQwSubsystemParity(name),
+  fVerifyBankDecoder(kFALSE),fNumberOfComparisons(0),fNumberOfMismatches(0)
 {
   // Nothing, really
 }
@@ -46,6 +52,13 @@ QwScaler::QwScaler(const TString& name)
  */
 QwScaler::~QwScaler()
 {
+  // Report the bank decoder self-test
+  if (fVerifyBankDecoder && fNumberOfComparisons > 0) {
+    QwMessage << GetName() << " scaler bank decoder self-test: "
+              << fNumberOfComparisons << " channel reads, "
+              << fNumberOfMismatches << " mismatches" << QwLog::endl;
+  }
+
   // Delete scalers
   for (size_t i = 0; i < fScaler.size(); i++) {
     delete fScaler.at(i);
@@ -231,6 +244,27 @@ Int_t QwScaler::LoadChannelMap(TString mapfile)
     }
   }
 
+  // Collect the scaler words of each subbank in buffer order
+  fSubbank_Words.clear();
+  for (Subbank_to_Scaler_Map_t::iterator subbank = fSubbank_Map.begin();
+       subbank != fSubbank_Map.end(); subbank++) {
+    std::vector<BankWord>& words = fSubbank_Words[subbank->first];
+    for (size_t modnum = 0; modnum < subbank->second.size(); modnum++) {
+      for (size_t channum = 0; channum < subbank->second.at(modnum).size(); channum++) {
+        Int_t index = subbank->second.at(modnum).at(channum);
+        if (index < 0 || fScaler.at(index)->IsNameEmpty()) continue;
+        BankWord word;
+        word.offset = fBufferOffset.at(index);
+        word.mask   = fScaler.at(index)->GetDataMask();
+        word.shift  = fScaler.at(index)->GetDataShift();
+        word.index  = index;
+        words.push_back(word);
+      }
+    }
+    std::sort(words.begin(), words.end(),
+              [](const BankWord& a, const BankWord& b) { return a.offset < b.offset; });
+  }
+
   mapstr.Close(); // Close the file (ifstream)
   return 0;
 }
@@ -285,6 +319,17 @@ void QwScaler::ClearEventData()
   fGoodEventCount = 0;
 }
 
+/**
+ * Clear the event data and the previous readings of all scaler channels.
+ */
+void QwScaler::ClearRunState()
+{
+  for (size_t i = 0; i < fScaler.size(); i++) {
+    fScaler.at(i)->ClearRunState();
+  }
+  ClearEventData();
+}
+
 /**
  * Process the configuration buffer for this subsystem
  * @param roc_id ROC ID
@@ -301,12 +346,14 @@ Int_t QwScaler::ProcessConfigurationBuffer(const ROCID_t /*roc_id*/, const BankI
 /**
  * Process raw buffer data, routing to registered scaler channels.
  *
+ * All scaler words of the bank are split into header and count in a
+ * single pass, and then scattered to the scaler channels.  Words beyond
+ * the end of the bank are skipped.
+ *
  * @return Number of words consumed from the buffer.
  */
 Int_t QwScaler::ProcessEvBuffer(const ROCID_t roc_id, const BankID_t bank_id, UInt_t* buffer, UInt_t num_words)
 {
-  // TODO fix :-)
-
   UInt_t words_read = 0;
 
   // Get the subbank index (or -1 when no match)
@@ -316,17 +363,45 @@ Int_t QwScaler::ProcessEvBuffer(const ROCID_t roc_id, const BankID_t bank_id, UI
 
     // Read header word
     //UInt_t num_events = buffer[words_read];
-    words_read++;
     // TODO Multiscaler functionality
 
-    // Read scalers
-    for (size_t modnum = 0; modnum < fSubbank_Map[subbank].size(); modnum++) {
-      for (size_t channum = 0; channum < fSubbank_Map[subbank].at(modnum).size(); channum++) {
-        Int_t index = fSubbank_Map[subbank].at(modnum).at(channum);
-        if (index >= 0) {
-          UInt_t offset = fBufferOffset.at(index);
-          words_read += fScaler[index]->ProcessEvBuffer(&(buffer[offset]), num_words - offset);
+    // Decode all scaler words in this bank
+    const std::vector<BankWord>& words = fSubbank_Words[subbank];
+    fBankHeader.resize(words.size());
+    fBankValue.resize(words.size());
+    size_t num_decoded = 0;
+    for ( ; num_decoded < words.size() && words[num_decoded].offset < num_words; num_decoded++) {
+      const BankWord& word = words[num_decoded];
+      UInt_t rawd = buffer[word.offset];
+      fBankHeader[num_decoded] = rawd & ~word.mask;
+      fBankValue[num_decoded]  = (rawd & word.mask) >> word.shift;
+    }
+    if (num_decoded < words.size()) {
+      QwWarningLimited(this,10) << "QwScaler::ProcessEvBuffer: "
+                           << words.size() - num_decoded << " scaler channels beyond the end of bank 0x"
+                           << std::hex << bank_id << std::dec << " with " << num_words << " words"
+                           << QwLog::endl;
+    }
+
+    // Scatter them to the scaler channels
+    for (size_t i = 0; i < num_decoded; i++) {
+      const BankWord& word = words[i];
+      VQwScaler_Channel* scaler = fScaler[word.index];
+      if (fVerifyBankDecoder) {
+        // Self-test: decode a copy of the channel with the per-channel decoder
+        VQwHardwareChannel* reference = scaler->Clone();
+        reference->ProcessEvBuffer(&(buffer[word.offset]), num_words - word.offset);
+        scaler->SetRawWord(fBankHeader[i], fBankValue[i]);
+        fNumberOfComparisons++;
+        if (reference->GetRawValue() != scaler->GetRawValue()
+         || reference->GetValue() != scaler->GetValue()) {
+          fNumberOfMismatches++;
+          QwErrorLimited(scaler,10) << "QwScaler::ProcessEvBuffer: bank and per-channel decoders differ for "
+                             << scaler->GetElementName() << QwLog::endl;
         }
+        delete reference;
+      } else {
+        scaler->SetRawWord(fBankHeader[i], fBankValue[i]);
       }
     }
     words_read = num_words;
@@ -8,6 +8,8 @@
 #include "QwSubsystemArrayParity.h"
 
 // System headers
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 // Qweak headers
@@ -34,6 +36,23 @@ QwSubsystemArrayParity::QwSubsystemArrayParity(const QwSubsystemArrayParity& sou
   // Copy error flags
   fErrorFlag = source.fErrorFlag;
   fErrorFlagTreeIndex = source.fErrorFlagTreeIndex;
+
+  // Verify once that the copies have the types of the template, so that
+  // the arithmetic between arrays of this family can skip the type checks
+  std::shared_ptr<const SubsystemLayout> layout = source.GetLayout();
+  Bool_t same_types = (layout->fTypes.size() == size());
+  for (size_t i = 0; same_types && i < size(); i++) {
+    const VQwSubsystem* subsys = at(i).get();
+    same_types = (subsys == nullptr)? (layout->fTypes[i] == nullptr):
+      (layout->fTypes[i] != nullptr && typeid(*subsys) == *(layout->fTypes[i]));
+  }
+  if (same_types) {
+    fLayout = layout;
+  } else {
+    QwWarning << "QwSubsystemArrayParity: the copied subsystems do not have "
+              << "the types of the template; the types are checked on every operation"
+              << QwLog::endl;
+  }
 }
 
 //*****************************************************************//
@@ -46,6 +65,54 @@ QwSubsystemArrayParity::~QwSubsystemArrayParity()
 
 //*****************************************************************//
 
+/**
+ * Cast the subsystems to parity subsystems once.  Subsystems are only
+ * appended to an array, never replaced, so the table stays valid as long
+ * as the number of subsystems does not change.
+ */
+void QwSubsystemArrayParity::BuildParitySubsystemTable() const
+{
+  fParitySubsystem.resize(size());
+  for (size_t i = 0; i < size(); i++)
+    fParitySubsystem[i] = dynamic_cast<VQwSubsystemParity*>(at(i).get());
+}
+
+/**
+ * Return the types of the subsystems of this array.  The layout is kept
+ * while the number of subsystems does not change; arrays which are
+ * copy-constructed from this one share it.
+ */
+std::shared_ptr<const QwSubsystemArrayParity::SubsystemLayout>
+QwSubsystemArrayParity::GetLayout() const
+{
+  if (! fLayout || fLayout->fTypes.size() != size()) {
+    std::shared_ptr<SubsystemLayout> layout = std::make_shared<SubsystemLayout>();
+    for (const_iterator subsys = begin(); subsys != end(); ++subsys)
+      layout->fTypes.push_back(subsys->get()? &typeid(*(subsys->get())): nullptr);
+    fLayout = layout;
+  }
+  return fLayout;
+}
+
+/**
+ * Two arrays with the same layout were copied from the same template, and
+ * hold subsystems of the same types in the same order, so the per-call
+ * typeid comparison of the operations between them can be skipped.  Builds
+ * with QW_CHECK_SUBSYSTEM_TYPES keep the checks.
+ */
+Bool_t QwSubsystemArrayParity::HasSameLayout(const QwSubsystemArrayParity& value) const
+{
+#ifdef QW_CHECK_SUBSYSTEM_TYPES
+  return kFALSE;
+#else
+  return fLayout && fLayout == value.fLayout
+    && size() == fLayout->fTypes.size()
+    && value.size() == fLayout->fTypes.size();
+#endif
+}
+
+//*****************************************************************//
+
 VQwSubsystemParity* QwSubsystemArrayParity::GetSubsystemByName(const TString& name)
 {
   return dynamic_cast<VQwSubsystemParity*>(QwSubsystemArray::GetSubsystemByName(name));
@@ -94,7 +161,17 @@ void QwSubsystemArrayParity::WritePromptSummary(QwPromptSummary *ps, TString typ
  */
 QwSubsystemArrayParity& QwSubsystemArrayParity::operator= (const QwSubsystemArrayParity &source)
 {
-  QwSubsystemArray::operator=(source);
+  if (this != &source && HasSameLayout(source)) {
+    //  Same subsystem types, as QwSubsystemArray::operator= without the checks
+    this->fCodaEventNumber = source.fCodaEventNumber;
+    this->fCodaEventType   = source.fCodaEventType;
+    for (size_t i = 0; i < source.size(); i++) {
+      if (source.at(i) != NULL && this->at(i) != NULL)
+        *(this->at(i).get()) = source.at(i).get();
+    }
+  } else {
+    QwSubsystemArray::operator=(source);
+  }
   this->fErrorFlag = source.fErrorFlag;
   return *this;
 }
@@ -112,15 +189,15 @@ QwSubsystemArrayParity& QwSubsystemArrayParity::operator+= (const QwSubsystemArr
         std::min(fCodaEventNumber, value.fCodaEventNumber);
     if (this->size() == value.size()){
       this->fErrorFlag|=value.fErrorFlag;
+      Bool_t same_layout = HasSameLayout(value);
       for(size_t i=0;i<value.size();i++){
 	if (value.at(i)==NULL || this->at(i)==NULL){
 	  //  Either the value or the destination subsystem
 	  //  are null
 	} else {
-	  VQwSubsystemParity *ptr1 =
-	    dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	  VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
           VQwSubsystem *ptr2 = value.at(i).get();
-	  if (typeid(*ptr1)==typeid(*ptr2)){
+	  if (same_layout || typeid(*ptr1)==typeid(*ptr2)){
 	    *(ptr1) += ptr2;
 	    //std::cout<<"QwSubsystemArrayParity::operator+ here where types match \n";
 	  } else {
@@ -153,15 +230,15 @@ QwSubsystemArrayParity& QwSubsystemArrayParity::operator-= (const QwSubsystemArr
         std::min(fCodaEventNumber, value.fCodaEventNumber);
     if (this->size() == value.size()){
       this->fErrorFlag|=value.fErrorFlag;
+      Bool_t same_layout = HasSameLayout(value);
       for(size_t i=0;i<value.size();i++){
 	if (value.at(i)==NULL || this->at(i)==NULL){
 	  //  Either the value or the destination subsystem
 	  //  are null
 	} else {
-	  VQwSubsystemParity *ptr1 =
-	    dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	  VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
           VQwSubsystem *ptr2 = value.at(i).get();
-	  if (typeid(*ptr1)==typeid(*ptr2)){
+	  if (same_layout || typeid(*ptr1)==typeid(*ptr2)){
 	    *(ptr1) -= ptr2;
 	  } else {
 	    //  Subsystems don't match
@@ -218,10 +295,8 @@ void QwSubsystemArrayParity::Difference(
  */
 void QwSubsystemArrayParity::Scale(Double_t factor)
 {
-  for (iterator subsys = begin(); subsys != end(); ++subsys) {
-    VQwSubsystemParity* subsys_parity = dynamic_cast<VQwSubsystemParity*>(subsys->get());
-    subsys_parity->Scale(factor);
-  }
+  for (size_t i = 0; i < size(); i++)
+    GetParitySubsystem(i)->Scale(factor);
 }
 
 //*****************************************************************//
@@ -241,10 +316,8 @@ void QwSubsystemArrayParity::PrintValue() const
 Bool_t QwSubsystemArrayParity::CheckForEndOfBurst() const
 {
   Bool_t status = kFALSE;
-  for (const_iterator subsys = begin(); subsys != end(); ++subsys) {
-    VQwSubsystemParity* subsys_parity = dynamic_cast<VQwSubsystemParity*>(subsys->get());
-    status |= subsys_parity->CheckForEndOfBurst();
-  }
+  for (size_t i = 0; i < size(); i++)
+    status |= GetParitySubsystem(i)->CheckForEndOfBurst();
   return status;
 };
 
@@ -252,10 +325,8 @@ Bool_t QwSubsystemArrayParity::CheckForEndOfBurst() const
 
 void QwSubsystemArrayParity::CalculateRunningAverage()
 {
-  for (iterator subsys = begin(); subsys != end(); ++subsys) {
-    VQwSubsystemParity* subsys_parity = dynamic_cast<VQwSubsystemParity*>(subsys->get());
-    subsys_parity->CalculateRunningAverage();
-  }
+  for (size_t i = 0; i < size(); i++)
+    GetParitySubsystem(i)->CalculateRunningAverage();
 }
 
 
@@ -267,15 +338,15 @@ void QwSubsystemArrayParity::AccumulateRunningSum(const QwSubsystemArrayParity&
       if (value.GetEventcutErrorFlag()==0){//do running sum only if error flag is zero. This way will prevent any Beam Trip(in ev mode 3) related events going into the running sum.
         fCodaEventNumber = (fCodaEventNumber == 0) ? value.fCodaEventNumber :
             std::min(fCodaEventNumber, value.fCodaEventNumber);
+        Bool_t same_layout = HasSameLayout(value);
         for (size_t i = 0; i < value.size(); i++) {
 	  if (value.at(i)==NULL || this->at(i)==NULL) {
 	    //  Either the value or the destination subsystem
 	    //  are null
 	  } else {
-	    VQwSubsystemParity *ptr1 =
-	      dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	    VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
             VQwSubsystem *ptr2 = value.at(i).get();
-	    if (typeid(*ptr1) == typeid(*ptr2)) {
+	    if (same_layout || typeid(*ptr1) == typeid(*ptr2)) {
 	      ptr1->AccumulateRunningSum(ptr2, count, ErrorMask);
 	    } else {
 	      QwError << "QwSubsystemArrayParity::AccumulateRunningSum here where types don't match" << QwLog::endl;
@@ -302,15 +373,15 @@ void QwSubsystemArrayParity::AccumulateAllRunningSum(const QwSubsystemArrayParit
   if (!value.empty()) {
     if (this->size() == value.size()) {
       //if (value.GetEventcutErrorFlag()==0){//do running sum only if error flag is zero. This way will prevent any Beam Trip(in ev mode 3) related events going into the running sum.
+	Bool_t same_layout = HasSameLayout(value);
 	for (size_t i = 0; i < value.size(); i++) {
 	  if (value.at(i)==NULL || this->at(i)==NULL) {
 	    //  Either the value or the destination subsystem
 	    //  are null
 	  } else {
-	    VQwSubsystemParity *ptr1 =
-	      dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	    VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
             VQwSubsystem *ptr2 = value.at(i).get();
-	    if (typeid(*ptr1) == typeid(*ptr2)) {
+	    if (same_layout || typeid(*ptr1) == typeid(*ptr2)) {
 	      ptr1->AccumulateRunningSum(ptr2, count, ErrorMask);
 	    } else {
 	      QwError << "QwSubsystemArrayParity::AccumulateRunningSum here where types don't match" << QwLog::endl;
@@ -343,15 +414,15 @@ void QwSubsystemArrayParity::DeaccumulateRunningSum(const QwSubsystemArrayParity
   if (!value.empty()) {
     if (this->size() == value.size()) {
       //if (value.GetEventcutErrorFlag()==0){//do derunningsum only if error flag is zero.
+	Bool_t same_layout = HasSameLayout(value);
 	for (size_t i = 0; i < value.size(); i++) {
 	  if (value.at(i)==NULL || this->at(i)==NULL) {
 	    //  Either the value or the destination subsystem
 	    //  are null
 	  } else {
-	    VQwSubsystemParity *ptr1 =
-	      dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	    VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
             VQwSubsystem *ptr2 = value.at(i).get();
-	    if (typeid(*ptr1) == typeid(*ptr2)) {
+	    if (same_layout || typeid(*ptr1) == typeid(*ptr2)) {
 	      ptr1->DeaccumulateRunningSum(ptr2, ErrorMask);
 	    } else {
 	      QwError << "QwSubsystemArrayParity::AccumulateRunningSum here where types don't match" << QwLog::endl;
@@ -380,7 +451,7 @@ void QwSubsystemArrayParity::Blind(const QwBlinder *blinder)
   // Loop over subsystem array
   for (size_t i = 0; i < this->size(); i++) {
     // Cast into parity subsystems
-    VQwSubsystemParity* subsys = dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+    VQwSubsystemParity* subsys = GetParitySubsystem(i);
 
     // Check for null pointers
     if (this->at(i) == 0) {
@@ -406,8 +477,8 @@ void QwSubsystemArrayParity::Blind(const QwBlinder *blinder, const QwSubsystemAr
   // Loop over subsystem array
   for (size_t i = 0; i < this->size(); i++) {
     // Cast into parity subsystems
-    VQwSubsystemParity* subsys_diff  = dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
-    VQwSubsystemParity* subsys_yield = dynamic_cast<VQwSubsystemParity*>(yield.at(i).get());
+    VQwSubsystemParity* subsys_diff  = GetParitySubsystem(i);
+    VQwSubsystemParity* subsys_yield = yield.GetParitySubsystem(i);
 
     // Check for null pointers
     if (subsys_diff == 0 || subsys_yield == 0) {
@@ -432,15 +503,15 @@ void QwSubsystemArrayParity::Ratio(
   if ( !denom.empty()){
     this->fErrorFlag=(numer.fErrorFlag|denom.fErrorFlag);
     if (this->size() == denom.size() ){
+      Bool_t same_layout = HasSameLayout(denom);
       for(size_t i=0;i<denom.size();i++){
         if (denom.at(i)==NULL || this->at(i)==NULL){
           //  Either the value or the destination subsystem  are null
 	  if(localdebug) std::cout<<"Either the value or the destination subsystem  are null\n";
         } else {
-	  VQwSubsystemParity *ptr1 =
-	    dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	  VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
           VQwSubsystem *ptr2 = denom.at(i).get();
-	  if (typeid(*ptr1)==typeid(*ptr2))
+	  if (same_layout || typeid(*ptr1)==typeid(*ptr2))
             {
               ptr1->Ratio(numer.at(i).get(),denom.at(i).get());
             } else {
@@ -473,8 +544,8 @@ Bool_t QwSubsystemArrayParity::ApplySingleEventCuts(){
   VQwSubsystemParity *subsys_parity = nullptr;
   CountFalse=0;
   if (!empty()){
-    for (iterator subsys = begin(); subsys != end(); ++subsys){
-      subsys_parity=dynamic_cast<VQwSubsystemParity*>((subsys)->get());
+    for (size_t i = 0; i < size(); i++){
+      subsys_parity=GetParitySubsystem(i);
       status=subsys_parity->ApplySingleEventCuts();
       ErrorFlag = subsys_parity->GetEventcutErrorFlag();
       if ((ErrorFlag & kEventCutMode3)==kEventCutMode3)//we only care about the event cut flag in event cut mode 3
@@ -505,24 +576,149 @@ Bool_t QwSubsystemArrayParity::ApplySingleEventCuts(){
 
 void QwSubsystemArrayParity::IncrementErrorCounters()
 {
+  //  The error counters only count the bits that are set, so subsystems
+  //  without any error flag set in their channels are skipped.
   VQwSubsystemParity *subsys_parity = nullptr;
-  if (!empty()){
-    for (iterator subsys = begin(); subsys != end(); ++subsys){
-      subsys_parity=dynamic_cast<VQwSubsystemParity*>((subsys)->get());
-      subsys_parity->IncrementErrorCounters();
-    }
+  for (size_t i = 0; i < size(); i++){
+    if (GetErrorSummary(i) == 0) continue;
+    subsys_parity=GetParitySubsystem(i);
+    subsys_parity->IncrementErrorCounters();
   }
 }
 
+/**
+ * Build the table of the addresses of the error flags of all channels,
+ * per subsystem.  The subsystem objects and their devices are not
+ * replaced after they are created (assignment copies element by element),
+ * so the table stays valid for the lifetime of this array.
+ */
+void QwSubsystemArrayParity::BuildErrorFlagTable() const
+{
+  fErrorFlagTable.assign(size(), std::vector<const UInt_t*>());
+  fErrorFlagTableComplete.assign(size(), kFALSE);
+  for (size_t i = 0; i < size(); i++){
+    const VQwSubsystemParity* subsys_parity =
+      dynamic_cast<const VQwSubsystemParity*>(at(i).get());
+    if (subsys_parity == nullptr) continue;
+    std::vector<const UInt_t*>& flags = fErrorFlagTable[i];
+    subsys_parity->CollectErrorFlags(flags);
+    fErrorFlagTableComplete[i] =
+      (std::find(flags.begin(), flags.end(), nullptr) == flags.end());
+    if (! fErrorFlagTableComplete[i]) flags.clear();
+  }
+}
+
+/**
+ * Return the summary of the error flags of a subsystem: the OR of the
+ * error flags of all its channels.  When the summary is zero, the error
+ * counters and the error flag propagation of that subsystem have nothing
+ * to do and can be skipped without walking its devices.
+ * @param i Index of the subsystem
+ * @return OR of the channel error flags, or kErrorSummaryUnknown
+ */
+UInt_t QwSubsystemArrayParity::GetErrorSummary(size_t i) const
+{
+  if (fErrorFlagTable.size() != size()) BuildErrorFlagTable();
+  if (! fErrorFlagTableComplete[i]) return kErrorSummaryUnknown;
+  UInt_t summary = 0;
+  const std::vector<const UInt_t*>& flags = fErrorFlagTable[i];
+  for (size_t j = 0; j < flags.size(); j++)
+    summary |= *flags[j];
+  return summary;
+}
+
+/**
+ * Build the table of the channels that hold the event data of each
+ * subsystem, as for the error flag table.  A subsystem is packable when it
+ * enumerates channels for all its event data (see
+ * VQwSubsystemParity::CollectChannels).
+ */
+void QwSubsystemArrayParity::BuildPackedChannelTable() const
+{
+  fPackedChannelTable.assign(size(), std::vector<VQwHardwareChannel*>());
+  fPackedChannelTableComplete.assign(size(), kFALSE);
+  for (size_t i = 0; i < size(); i++){
+    VQwSubsystemParity* subsys_parity =
+      dynamic_cast<VQwSubsystemParity*>(at(i).get());
+    if (subsys_parity == nullptr) continue;
+    std::vector<VQwHardwareChannel*>& channels = fPackedChannelTable[i];
+    subsys_parity->CollectChannels(channels);
+    fPackedChannelTableComplete[i] =
+      (std::find(channels.begin(), channels.end(), nullptr) == channels.end());
+    if (! fPackedChannelTableComplete[i]) channels.clear();
+  }
+}
+
+Bool_t QwSubsystemArrayParity::IsPackable(size_t i) const
+{
+  if (fPackedChannelTable.size() != size()) BuildPackedChannelTable();
+  return fPackedChannelTableComplete[i];
+}
+
+/**
+ * Append the event data of this array to a packed record: the event cut
+ * error flag and CODA event number and type, and then, for every packable
+ * subsystem, the data that its operator= copies.  The other subsystems are
+ * not in the record.  Arrays copied from the same array give records of the
+ * same size.
+ * @param record Packed record
+ */
+void QwSubsystemArrayParity::PackEventData(std::vector<char>& record) const
+{
+  if (fPackedChannelTable.size() != size()) BuildPackedChannelTable();
+  const char* header[3] = {
+    reinterpret_cast<const char*>(&fErrorFlag),
+    reinterpret_cast<const char*>(&fCodaEventNumber),
+    reinterpret_cast<const char*>(&fCodaEventType) };
+  for (size_t j = 0; j < 3; j++)
+    record.insert(record.end(), header[j], header[j] + sizeof(UInt_t));
+  for (size_t i = 0; i < size(); i++){
+    if (fPackedChannelTableComplete[i])
+      GetParitySubsystem(i)->PackEventData(fPackedChannelTable[i], record);
+  }
+}
+
+/**
+ * Restore the event data of this array from a record packed by an array
+ * copied from the same array
+ * @param record Packed record
+ */
+void QwSubsystemArrayParity::UnpackEventData(const char* record)
+{
+  if (fPackedChannelTable.size() != size()) BuildPackedChannelTable();
+  std::memcpy(&fErrorFlag,       record, sizeof(UInt_t)); record += sizeof(UInt_t);
+  std::memcpy(&fCodaEventNumber, record, sizeof(UInt_t)); record += sizeof(UInt_t);
+  std::memcpy(&fCodaEventType,   record, sizeof(UInt_t)); record += sizeof(UInt_t);
+  for (size_t i = 0; i < size(); i++){
+    if (fPackedChannelTableComplete[i])
+      GetParitySubsystem(i)->UnpackEventData(fPackedChannelTable[i], record);
+  }
+}
+
+/// The event cut error flag is the first word of a packed record
+UInt_t QwSubsystemArrayParity::GetPackedEventcutErrorFlag(const char* record)
+{
+  UInt_t errflag;
+  std::memcpy(&errflag, record, sizeof(UInt_t));
+  return errflag;
+}
+
+void QwSubsystemArrayParity::UpdatePackedErrorFlag(char* record, UInt_t errflag)
+{
+  errflag |= GetPackedEventcutErrorFlag(record);
+  std::memcpy(record, &errflag, sizeof(UInt_t));
+}
+
 Bool_t QwSubsystemArrayParity::CheckForBurpFail(QwSubsystemArrayParity &event)
 {
   Bool_t burpstatus = kFALSE;
   if (!event.empty() && this->size() == event.size()){
+    Bool_t same_layout = HasSameLayout(event);
     for(size_t i=0;i<event.size();i++){
       if (event.at(i)!=NULL && this->at(i)!=NULL){
-	      VQwSubsystemParity *ptr1 = dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	      VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
               VQwSubsystem *ptr2 = event.at(i).get();
-	      if (typeid(*ptr1)==typeid(*ptr2)){
+	      if (same_layout || typeid(*ptr1)==typeid(*ptr2)){
 	        //*(ptr1) = event.at(i).get();//when =operator is used
 	        //pass the correct subsystem to update the errorflags at subsystem to devices to channel levels
           //wError << "************* test " << typeid(*ptr1).name() << "*****************" << QwLog::endl;
@@ -553,21 +749,37 @@ void QwSubsystemArrayParity::PrintErrorCounters() const{// report number of even
   }
 }
 
+/**
+ * Let each subsystem skip the derived quantities without readers.  This
+ * has to be called on the array which processes the events, after the
+ * trees, histograms, event cuts and data handlers of all copies are set up.
+ */
+void QwSubsystemArrayParity::DisableUnusedDerivedQuantities()
+{
+  for (iterator subsys = begin(); subsys != end(); ++subsys) {
+    VQwSubsystemParity* subsys_parity = dynamic_cast<VQwSubsystemParity*>(subsys->get());
+    if (subsys_parity != nullptr)
+      subsys_parity->DisableUnusedDerivedQuantities();
+  }
+}
+
 void QwSubsystemArrayParity::UpdateErrorFlag(const QwSubsystemArrayParity& ev_error){
   Bool_t localdebug=kFALSE;//kTRUE;
   if(localdebug)  std::cout<<"QwSubsystemArrayParity::UpdateErrorFlag \n";
   if (!ev_error.empty()){
     if (this->size() == ev_error.size()){
       this->fErrorFlag |= ev_error.fErrorFlag;
+      Bool_t same_layout = HasSameLayout(ev_error);
       for(size_t i=0;i<ev_error.size();i++){
 	if (ev_error.at(i)==NULL || this->at(i)==NULL){
 	  //  Either the source or the destination subsystem
 	  //  are null
+	} else if (ev_error.GetErrorSummary(i) == 0){
+	  //  No error flags to propagate from this subsystem
 	} else {
-	  VQwSubsystemParity *ptr1 =
-	    dynamic_cast<VQwSubsystemParity*>(this->at(i).get());
+	  VQwSubsystemParity *ptr1 = GetParitySubsystem(i);
           VQwSubsystem *ptr2 = ev_error.at(i).get();
-	  if (typeid(*ptr1)==typeid(*ptr2)){
+	  if (same_layout || typeid(*ptr1)==typeid(*ptr2)){
 	    if(localdebug) std::cout<<" here in QwSubsystemArrayParity::UpdateErrorFlag types mach \n";
 	    //*(ptr1) = ev_error.at(i).get();//when =operator is used
 	    //pass the correct subsystem to update the errorflags at subsystem to devices to channel levels
@@ -600,8 +812,8 @@ void QwSubsystemArrayParity::UpdateErrorFlag() {
 
   VQwSubsystemParity *subsys_parity = nullptr;
   if (!empty()){
-    for (iterator subsys = begin(); subsys != end(); ++subsys){
-      subsys_parity=dynamic_cast<VQwSubsystemParity*>((subsys)->get());
+    for (size_t i = 0; i < size(); i++){
+      subsys_parity=GetParitySubsystem(i);
       //Update the error flag of the parity subsystem
       fErrorFlag|=subsys_parity->UpdateErrorFlag();
     }
@@ -24,6 +24,33 @@
 /* With X being vertical up and Z being the beam direction toward the beamdump */
 const TString  VQwBPM::kAxisLabel[2]={"X","Y"};
 
+Bool_t VQwBPM::fUseFusedKernel = kTRUE;
+Bool_t VQwBPM::fVerifyFusedKernel = kFALSE;
+std::atomic<UInt_t> VQwBPM::fFusedKernelComparisons(0);
+std::atomic<UInt_t> VQwBPM::fFusedKernelMismatches(0);
+
+/**
+ * \brief Select the fused position kernel of the stripline BPMs.
+ * \param use    Compute the derived channels of VQWK and Moller ADC
+ *               striplines in one pass over packed wire values
+ * \param verify Also compute them with the channel arithmetic and
+ *               compare the results bit for bit
+ */
+void VQwBPM::SetFusedKernel(Bool_t use, Bool_t verify)
+{
+  fUseFusedKernel = use || verify;
+  fVerifyFusedKernel = verify;
+}
+
+void VQwBPM::PrintFusedKernelReport()
+{
+  if (fVerifyFusedKernel && fFusedKernelComparisons > 0) {
+    QwMessage << "Stripline BPM kernel self-test: " << fFusedKernelComparisons
+              << " events compared, " << fFusedKernelMismatches
+              << " mismatches" << QwLog::endl;
+  }
+}
+
 
 /*!
  * \brief Initialize common BPM state and set the element name.
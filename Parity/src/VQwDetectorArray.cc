@@ -65,6 +65,8 @@ void VQwDetectorArray::ProcessOptions(QwOptions &options) {
 
   fNormThreshold = options.GetValue<double>("QwDetectorArray.norm_threshold");
 
+  fMollerADCBank.SetVerify(options.GetValue<bool>("verify-bank-decoders"));
+
 }
 
 
@@ -500,6 +502,20 @@ Int_t VQwDetectorArray::LoadChannelMap(TString mapfile) {
         }
     }
 
+    // Mark the first record of the MollerADC modules in each subbank,
+    // from where the bank is decoded as a whole
+    fMollerADCFirstWord.clear();
+    for (size_t i=0; i<fMainDetID.size(); i++) {
+
+        Int_t subbank = fMainDetID[i].fSubbankIndex;
+        Int_t word = fMainDetID[i].fWordInSubbank;
+        if (subbank < 0 || word < 0 || fMainDetID[i].fmoduletype != "MOLLERADC") continue;
+        if (subbank >= (Int_t) fMollerADCFirstWord.size())
+         fMollerADCFirstWord.resize(subbank+1, -1);
+        if (fMollerADCFirstWord[subbank] < 0 || word < fMollerADCFirstWord[subbank])
+         fMollerADCFirstWord[subbank] = word;
+    }
+
 
      // Now load the variables to publish
     mapstr.RewindToFileStart();
@@ -911,6 +927,9 @@ void  VQwDetectorArray::RandomizeMollerEvent(int helicity /*, const QwBeamCharge
         fTargetYprime.PrintInfo();
         fTargetEnergy.PrintInfo();*/
 
+    //  The bound beam charge from ExchangeProcessedData
+    if (fTargetChargeSource) fTargetCharge.AssignValueFrom(fTargetChargeSource);
+
     if(RequestExternalValue("x_targ", &fTargetX)){
 
         if (bDEBUG){
@@ -1031,6 +1050,11 @@ Int_t VQwDetectorArray::ProcessEvBuffer(const ROCID_t roc_id, const BankID_t ban
              << " and subbank "<<bank_id
              << " number of words="<<num_words<<std::endl;
 
+        //  Decode the MollerADC records once for all channels in them
+        Bool_t molleradc_bank = (index < (Int_t) fMollerADCFirstWord.size() && fMollerADCFirstWord[index] >= 0);
+        if (molleradc_bank)
+         fMollerADCBank.Decode(buffer, num_words, fMollerADCFirstWord[index]);
+
         for (size_t i=0;i<fMainDetID.size();i++) {
 
             if (fMainDetID[i].fSubbankIndex==index) {
@@ -1053,6 +1077,9 @@ Int_t VQwDetectorArray::ProcessEvBuffer(const ROCID_t roc_id, const BankID_t ban
 
         }
 
+        if (molleradc_bank)
+         fMollerADCBank.Release();
+
     }
 
   return 0;
@@ -1123,6 +1150,39 @@ void VQwDetectorArray::IncrementErrorCounters() {
 
 }
 
+
+void VQwDetectorArray::CollectErrorFlags(std::vector<const UInt_t*>& flags) const {
+
+    for(size_t i=0;i<fIntegrationPMT.size();i++){
+
+        fIntegrationPMT[i].CollectErrorFlags(flags);
+
+    }
+
+    for(size_t i=0;i<fCombinedPMT.size();i++){
+
+        fCombinedPMT[i].CollectErrorFlags(flags);
+
+    }
+
+}
+
+void VQwDetectorArray::CollectChannels(std::vector<VQwHardwareChannel*>& channels) {
+
+    for(size_t i=0;i<fIntegrationPMT.size();i++){
+
+        fIntegrationPMT[i].CollectChannels(channels);
+
+    }
+
+    for(size_t i=0;i<fCombinedPMT.size();i++){
+
+        fCombinedPMT[i].CollectChannels(channels);
+
+    }
+
+}
+
 //inherited from the VQwSubsystemParity; this will display the error summary
 void VQwDetectorArray::PrintErrorCounters() const {
 
@@ -1204,6 +1264,30 @@ void  VQwDetectorArray::ProcessEvent() {
 
 }
 
+/**
+ * Bind the q_targ channel of the beamline, once all subsystems have
+ * published their values.  The detectors are normalized by that channel
+ * directly; a q_targ of another channel type is copied into fTargetCharge
+ * in every exchange instead.
+ */
+
+void  VQwDetectorArray::BindExternalValues() {
+
+    fTargetChargeSource = nullptr;
+    fCopyTargetCharge = kFALSE;
+    if (BindExternalValue("q_targ", fTargetChargeSource)) {
+
+        fCopyTargetCharge =
+          (dynamic_cast<const QwBeamCharge*>(fTargetChargeSource) == nullptr);
+        if (fCopyTargetCharge)
+            QwMessage << GetName() << " copies " << fTargetChargeSource->GetElementName()
+                      << " for the normalization, since it is not a MollerADC channel"
+                      << QwLog::endl;
+
+    }
+
+}
+
 /**
  * Exchange data between subsystems
  */
@@ -1215,13 +1299,17 @@ void  VQwDetectorArray::ExchangeProcessedData() {
 
     if (1==1 || bNormalization) {
 
-        if(RequestExternalValue("q_targ", &fTargetCharge)) {
+        //  Bound in BindExternalValues, and read directly from the beamline
+        if (fTargetChargeSource) {
+
+            if (fCopyTargetCharge)
+                fTargetCharge.AssignValueFrom(fTargetChargeSource);
 
             if (bDEBUG) {
 
-	            QwWarning << "VQwDetectorArray::ExchangeProcessedData Found "<<fTargetCharge.GetElementName()<< QwLog::endl;
+	            QwWarning << "VQwDetectorArray::ExchangeProcessedData Found "<<fTargetChargeSource->GetElementName()<< QwLog::endl;
 	            //QwWarning <<"****VQwDetectorArray****"<< QwLog::endl;
-	            (dynamic_cast<QwMollerADC_Channel*>(&fTargetCharge))->PrintInfo();
+	            fTargetChargeSource->PrintInfo();
 
             }
 
@@ -1246,16 +1334,16 @@ void  VQwDetectorArray::ProcessEvent_2() {
 
         if (bDEBUG) {
 
-            Double_t  pedestal = fTargetCharge.GetPedestal();
-            Double_t  calfactor = fTargetCharge.GetCalibrationFactor();
-            Double_t  volts = fTargetCharge.GetAverageVolts();
+            Double_t  pedestal = GetNormalizationCharge()->GetPedestal();
+            Double_t  calfactor = GetNormalizationCharge()->GetCalibrationFactor();
+            Double_t  volts = GetNormalizationCharge()->GetAverageVolts();
 
             std::cout<<"VQwDetectorArray::ProcessEvent_2(): processing with exchanged data"<<std::endl;
             std::cout<<"pedestal, calfactor, average volts = "<<pedestal<<", "<<calfactor<<", "<<volts<<std::endl;
 
         }
 
-        if (bNormalization && fTargetCharge.GetValue()>fNormThreshold)
+        if (bNormalization && GetNormalizationCharge()->GetValue()>fNormThreshold)
 	     this->DoNormalization();
 
     } else {
@@ -1521,7 +1609,7 @@ void VQwDetectorArray::Scale(Double_t factor) {
 
 //*****************************************************************//
 
-void VQwDetectorArray::Normalize(VQwDataElement* denom) {
+void VQwDetectorArray::Normalize(const VQwDataElement* denom) {
 
     for (size_t i = 0; i < fIntegrationPMT.size(); i++)
      fIntegrationPMT[i].Normalize(denom);
@@ -1667,7 +1755,7 @@ void VQwDetectorArray::DoNormalization(Double_t factor) {
 
         try {
 
-	        this->Normalize(&fTargetCharge);
+	        this->Normalize(GetNormalizationCharge());
 
         }
 
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# Test 005:
+#
+#   Run the event-processing benchmark and compare it against a baseline.
+#
+#   The benchmark is only built with -DQW_BUILD_BENCHMARKS=ON, and timing
+#   baselines are machine specific, so this test is skipped unless both the
+#   executable and the baseline file (default Tests/benchmark/baseline.json,
+#   or QW_BENCHMARK_BASELINE) exist.  Create a baseline with
+#
+#     build/qwbenchmark --config qwparity.conf --detectors mock_detectors.map \
+#       --bench-output Tests/benchmark/baseline.json
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+baseline=${QW_BENCHMARK_BASELINE:-Tests/benchmark/baseline.json}
+
+if [ ! -x build/qwbenchmark ] ; then
+  echo "Benchmark not built (configure with -DQW_BUILD_BENCHMARKS=ON), skipping."
+  exit 0
+fi
+if [ ! -e ${baseline} ] ; then
+  echo "Benchmark baseline ${baseline} not found, skipping."
+  exit 0
+fi
+
+build/qwbenchmark --config qwparity.conf --detectors mock_detectors.map \
+  --bench-baseline ${baseline} || exit -1
+
+exit 0
@@ -0,0 +1,42 @@
+#!/bin/bash
+
+# Test 006:
+#
+#   Decode a recorded run with --verify-bank-decoders, which decodes every
+#   ADC18 and scaler bank both with the bulk bank decoders and with the
+#   per-channel decoders, and make sure they agree.
+#
+#   The mock data has no ADC18 or scaler banks, so this test is skipped
+#   unless a recorded run is given as QW_BANKDECODER_RUN (with the map in
+#   QW_BANKDECODER_DETECTORS, default detectors.map).
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+if [ -z "${QW_BANKDECODER_RUN}" ] ; then
+  echo "No recorded run in QW_BANKDECODER_RUN, skipping."
+  exit 0
+fi
+detectors=${QW_BANKDECODER_DETECTORS:-detectors.map}
+
+OUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r ${QW_BANKDECODER_RUN} -e :10000 --config qwparity.conf \
+  --detectors ${detectors} --verify-bank-decoders | tee $OUT || exit -1
+
+if ! grep -q "bank decoder self-test" $OUT ; then
+  echo "No ADC18 or scaler banks were compared."
+  exit -1
+fi
+if grep "bank decoder self-test" $OUT | grep -v -q " 0 mismatches" ; then
+  echo "Bank decoders disagree with the per-channel decoders."
+  exit -1
+fi
+
+exit 0
@@ -0,0 +1,35 @@
+#!/bin/bash
+
+# Test 007:
+#
+#   Analyze the mock data run of test 004 twice with --config-snapshot: the
+#   first pass writes the snapshot, the second pass reads its parameter
+#   files from it.  Both must give the same output as test 004.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+SNAPSHOT=`mktemp -t qwparity.XXXXXX.snapshot`
+rm -f $SNAPSHOT
+
+for pass in write read ; do
+  OUT=`mktemp -t qwparity.XXXXXX.out`
+  build/qwparity -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map \
+    --config-snapshot $SNAPSHOT | grep -i -v time | grep -v `hostname` | grep -v "Processing event" \
+    | tee $OUT.raw | grep -v "configuration snapshot" | sed 's/ (snapshot)//' > $OUT || exit -1
+  diff $OUT Tests/004_qwparity.ref || exit -1
+  if [ ${pass} = read ] && ! grep -q "Using configuration snapshot" $OUT.raw ; then
+    echo "The configuration snapshot was not used."
+    exit -1
+  fi
+done
+
+rm -f $SNAPSHOT
+exit 0
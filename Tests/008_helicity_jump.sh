@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# Test 008:
+#
+#   Analyze the mock data run of test 004 and take the helicity predictor
+#   seed at its end, then analyze the second half of the run again with
+#   that seed.  The predictor jumps back to the first pattern in the event
+#   range instead of collecting the first 30 patterns, and must not make
+#   prediction errors.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+OUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map \
+  --helicity.print-seed > $OUT || exit -1
+SEED=`grep "Helicity predictor seed:" $OUT | tail -1 | sed 's/.*Helicity predictor seed: //'`
+if [ -z "${SEED}" ] ; then
+  echo "No helicity predictor seed at the end of the run."
+  exit -1
+fi
+
+OUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 -e 6000:10000 --config qwparity.conf --detectors mock_detectors.map \
+  ${SEED} | tee $OUT || exit -1
+if ! grep -q "Jumped helicity predictor" $OUT ; then
+  echo "The helicity predictor did not jump."
+  exit -1
+fi
+if grep -q "Collecting information" $OUT ; then
+  echo "The helicity predictor collected bits."
+  exit -1
+fi
+if ! grep -q "Number of helicity prediction errors: 0" $OUT ; then
+  echo "The helicity predictor made prediction errors after the jump."
+  exit -1
+fi
+
+exit 0
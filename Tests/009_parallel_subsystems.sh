@@ -0,0 +1,30 @@
+#!/bin/bash
+
+# Test 009:
+#
+#   Analyze the mock data run of test 004 with the subsystems processed
+#   serially and on a worker pool.  Apart from timing information the
+#   output must be identical.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+SERIAL=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 --config qwparity.conf --detectors mock_detectors.map \
+  | grep -i -v time > $SERIAL || exit -1
+
+PARALLEL=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 --config qwparity.conf --detectors mock_detectors.map \
+  --parallel-subsystems 4 \
+  | grep -i -v time | grep -v "Processing subsystems on" > $PARALLEL || exit -1
+
+diff $SERIAL $PARALLEL || exit -1
+
+exit 0
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Test 010:
+#
+#   Analyze the mock data run of test 004 with the heap footprint of the
+#   subsystem copies accounted, and check that the memory report lists
+#   the copies at the end of the run.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+OUTPUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 --config qwparity.conf --detectors mock_detectors.map \
+  --memory-report > $OUTPUT || exit -1
+
+grep -q "memory report" $OUTPUT || exit -1
+grep -q "Subsystem copies hold" $OUTPUT || exit -1
+
+exit 0
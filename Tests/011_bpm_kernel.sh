@@ -0,0 +1,33 @@
+#!/bin/bash
+
+# Test 011:
+#
+#   Analyze the mock data run of test 004 with --verify-bpm-kernel, which
+#   computes the derived channels of every stripline BPM both with the
+#   channel arithmetic and with the fused kernel, and make sure the two
+#   agree bit for bit.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+OUTPUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 --config qwparity.conf --detectors mock_detectors.map \
+  --verify-bpm-kernel > $OUTPUT || exit -1
+
+if ! grep -q "Stripline BPM kernel self-test" $OUTPUT ; then
+  echo "No stripline BPMs were compared."
+  exit -1
+fi
+if grep "Stripline BPM kernel self-test" $OUTPUT | grep -v -q " 0 mismatches" ; then
+  echo "Fused stripline BPM kernel disagrees with the channel arithmetic."
+  exit -1
+fi
+
+exit 0
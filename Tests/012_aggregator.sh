@@ -0,0 +1,94 @@
+#!/bin/bash
+
+# Test 012:
+#
+#   Analyze the mock data run of test 004 with only an aggregator handler
+#   in the pattern handler array, and make sure that it wrote the run
+#   aggregator file once.  The means and widths in its agg tree must agree
+#   with those of the same quantities in the mul tree, for the patterns
+#   without event cut errors.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+DIR=`mktemp -d -t qwparity.XXXXXX`
+cat > ${DIR}/aggregator_datahandlers.map <<EOF
+[QwAggregator]
+  name = aggregator
+  scope = mul
+  map  = mock_aggregator.map
+  aggregator-path = ${DIR}
+EOF
+
+OUTPUT=${DIR}/qwparity.out
+build/qwparity -r 10 --config qwparity.conf --detectors mock_detectors.map \
+  --datahandlers ${DIR}/aggregator_datahandlers.map \
+  --rootfiles ${DIR} --rootfile-stem mock_ > $OUTPUT || exit -1
+
+if [ `grep -c "QwAggregator aggregator wrote ${DIR}/run_aggregator_10.root" $OUTPUT` -ne 1 ] ; then
+  echo "The aggregator did not write the run aggregator file once."
+  exit -1
+fi
+if [ ! -e ${DIR}/run_aggregator_10.root ] ; then
+  echo "Run aggregator file run_aggregator_10.root not found."
+  exit -1
+fi
+
+cat > ${DIR}/compare.C <<'EOF'
+void compare(const char* name_mul, const char* name_agg)
+{
+  TFile file_mul(name_mul);
+  TFile file_agg(name_agg);
+  TTree* mul = (TTree*) file_mul.Get("mul");
+  TTree* agg = (TTree*) file_agg.Get("agg");
+  if (mul == 0 || agg == 0 || agg->GetEntries() != 1) {
+    std::cout << "The mul or agg tree is missing." << std::endl;
+    gSystem->Exit(1);
+  }
+  agg->GetEntry(0);
+  TLeaf* flag = mul->GetLeaf("ErrorFlag");
+  Int_t nbad = 0;
+  const char* names[] = {"yield_bcm_target", "asym_bcm_target"};
+  for (Int_t k = 0; k < 2; k++) {
+    TLeaf* leaf = mul->GetLeaf(names[k], "hw_sum");
+    TLeaf* mean = agg->GetLeaf(TString(names[k]) + "_mean");
+    TLeaf* rms  = agg->GetLeaf(TString(names[k]) + "_rms");
+    TLeaf* n    = agg->GetLeaf(TString(names[k]) + "_nentries");
+    if (flag == 0 || leaf == 0 || mean == 0 || rms == 0 || n == 0) {
+      std::cout << "Leaves of " << names[k] << " are missing." << std::endl;
+      gSystem->Exit(1);
+    }
+    Double_t sum = 0.0, sum2 = 0.0, count = 0.0;
+    for (Long64_t entry = 0; entry < mul->GetEntries(); entry++) {
+      mul->GetEntry(entry);
+      if (flag->GetValue() != 0) continue;
+      sum  += leaf->GetValue();
+      sum2 += leaf->GetValue() * leaf->GetValue();
+      count++;
+    }
+    Double_t mul_mean = sum / count;
+    Double_t mul_rms  = TMath::Sqrt(TMath::Max(sum2 / count - mul_mean * mul_mean, 0.0));
+    std::cout << names[k] << ": mean " << mean->GetValue() << " (mul " << mul_mean
+              << "), rms " << rms->GetValue() << " (mul " << mul_rms << "), "
+              << n->GetValue() << " patterns (mul " << count << ")" << std::endl;
+    if (count == 0 || n->GetValue() != count
+     || TMath::Abs(mean->GetValue() - mul_mean) > 1e-6 * mul_rms + 1e-12 * TMath::Abs(mul_mean)
+     || TMath::Abs(rms->GetValue() - mul_rms) > 1e-6 * mul_rms)
+      nbad++;
+  }
+  gSystem->Exit(nbad > 0);
+}
+EOF
+
+root -l -b -q "${DIR}/compare.C(\"${DIR}/mock_10.root\",\"${DIR}/run_aggregator_10.root\")" || exit -1
+
+rm -rf ${DIR}
+
+exit 0
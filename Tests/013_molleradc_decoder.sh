@@ -0,0 +1,32 @@
+#!/bin/bash
+
+# Test 013:
+#
+#   Analyze the mock data run of test 004 with --verify-bank-decoders, which
+#   decodes every MollerADC channel both with the bank decoder and with the
+#   per-channel decoder, and make sure the two agree bit for bit.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+OUTPUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 --config qwparity.conf --detectors mock_detectors.map \
+  --verify-bank-decoders > $OUTPUT || exit -1
+
+if ! grep -q "MollerADC bank decoder self-test" $OUTPUT ; then
+  echo "No MollerADC banks were compared."
+  exit -1
+fi
+if grep "MollerADC bank decoder self-test" $OUTPUT | grep -v -q " 0 mismatches" ; then
+  echo "MollerADC bank decoder disagrees with the per-channel decoder."
+  exit -1
+fi
+
+exit 0
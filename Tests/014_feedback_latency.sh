@@ -0,0 +1,38 @@
+#!/bin/bash
+
+# Test 014:
+#
+#   Replay the mock data run of test 004 through the charge feedback on the
+#   mock actuators, and make sure that the latency harness wrote its results.
+#
+#   The harness is only built with -DQW_FEEDBACK_MOCK_ACTUATORS=ON, so this
+#   test is reported as skipped (exit code 77) unless the executable exists.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+harness=build/Feedback/qwfeedbacklatency
+if [ ! -x ${harness} ] ; then
+  echo "Feedback harness not built (configure with -DQW_FEEDBACK_MOCK_ACTUATORS=ON), skipping."
+  exit 77
+fi
+
+RESULTS=`mktemp -t qwfeedbacklatency.XXXXXX.json`
+${harness} -r 10 --config qwfeedback_offline.conf --detectors mock_detectors.map \
+  --fb-bench-output ${RESULTS} || exit -1
+
+if ! grep -q "\"benchmark\": \"qwfeedbacklatency\"" ${RESULTS} ; then
+  echo "The feedback harness did not write its results."
+  exit -1
+fi
+
+rm -f ${RESULTS}
+
+exit 0
@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# Test 015:
+#
+#   Analyze the mock data runs 10 and 11 in one job, once constructing the
+#   detectors for every run and once with --reuse-analyzer-state, which
+#   keeps the detectors of run 10 for run 11 since no parameter file
+#   changed.  Both jobs must give the same end of run summaries.
+#
+#   The mock ADC channels count their sequence numbers from the start of
+#   each run, so the end of run 10 does not continue into run 11: the
+#   reused detectors must forget the history of their hardware checks, or
+#   the first events of run 11 fail the sequence number check.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+build/qwmockdatagenerator -r 11 -e :10000 --config qwparity.conf --detectors mock_detectors.map > /dev/null || exit -1
+
+for reuse in false true ; do
+  OUT=`mktemp -t qwparity.XXXXXX.out`
+  build/qwparity -r 10:11 -e :10000 --config qwparity.conf --detectors mock_detectors.map \
+    --reuse-analyzer-state=${reuse} | grep -i -v time | grep -v `hostname` | grep -v "Processing event" \
+    | tee $OUT.raw | sed -n '/Number of events processed/,/physics events were processed/p' > $OUT || exit -1
+  if [ `grep -c "physics events were processed" $OUT` -ne 2 ] ; then
+    echo "Not both runs were analyzed."
+    exit -1
+  fi
+  if [ ${reuse} = true ] ; then
+    if ! grep -q "reusing the detectors of the previous run" $OUT.raw ; then
+      echo "The detectors were not reused for run 11."
+      exit -1
+    fi
+    diff $REF $OUT || exit -1
+  fi
+  REF=$OUT
+done
+
+exit 0
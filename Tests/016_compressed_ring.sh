@@ -0,0 +1,31 @@
+#!/bin/bash
+
+# Test 016:
+#
+#   Analyze the mock data run 10 with --ring.compress, which keeps the
+#   events in the event ring as packed records, and make sure that the
+#   output is the same as that of test 004 with the full copies.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+build/qwmockdatagenerator -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map > /dev/null || exit -1
+
+OUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map --ring.compress \
+  | grep -i -v time | grep -v `hostname` | grep -v "Processing event" \
+  | tee $OUT.raw | grep -v "QwEventRing: keeping" > $OUT || exit -1
+if ! grep -q "QwEventRing: keeping" $OUT.raw ; then
+  echo "The event ring was not compressed."
+  exit -1
+fi
+diff $OUT Tests/004_qwparity.ref || exit -1
+
+exit 0
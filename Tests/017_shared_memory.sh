@@ -0,0 +1,37 @@
+#!/bin/bash
+
+# Test 017:
+#
+#   Write a histogram with variable bins, a two-dimensional histogram and
+#   tree entries to a shared-memory region and read them back.  Then
+#   analyze the mock data run of test 004 with --enable-shmem and make sure
+#   that one region holds the histograms and the trees of all output files.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+build/qwsharedmemorytest || exit -1
+
+region=/QwTest017.$$
+OUTPUT=`mktemp -t qwparity.XXXXXX.out`
+build/qwparity -r 10 -e :1000 --config qwparity.conf --detectors mock_detectors.map \
+  --enable-shmem --shmem-name ${region} > $OUTPUT || exit -1
+rm -f /dev/shm${region}
+
+if [ `grep -c "Created shared memory region ${region} " $OUTPUT` -ne 1 ] ; then
+  echo "Expected exactly one shared memory region for the run."
+  exit -1
+fi
+if ! grep "Created shared memory region ${region} " $OUTPUT | grep -q -E "with [1-9][0-9]* histograms and [1-9][0-9]* trees" ; then
+  echo "The shared memory region does not hold both histograms and trees."
+  exit -1
+fi
+
+exit 0
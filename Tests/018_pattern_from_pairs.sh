@@ -0,0 +1,79 @@
+#!/bin/bash
+
+# Test 018:
+#
+#   Analyze the mock data run of test 004 with the pattern yields and
+#   differences derived from the pair sums, and with the pattern built from
+#   the helicity sums of its phases.  The mul trees must have the same
+#   entries, with the same values up to the rounding of the different
+#   order of the additions; the data that are not summed (e.g. the
+#   helicity bits of the yield) must be identical.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+build/qwmockdatagenerator -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map > /dev/null || exit -1
+
+DIR=`mktemp -d -t qwparity.XXXXXX`
+for pairs in true false ; do
+  mkdir -p ${DIR}/${pairs}
+  build/qwparity -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map \
+    --pattern-from-pairs=${pairs} --rootfiles ${DIR}/${pairs} --rootfile-stem mock_ \
+    > /dev/null || exit -1
+done
+
+cat > ${DIR}/compare.C <<'EOF'
+void compare(const char* name_pairs, const char* name_phases)
+{
+  TFile file_pairs(name_pairs);
+  TFile file_phases(name_phases);
+  TTree* pairs  = (TTree*) file_pairs.Get("mul");
+  TTree* phases = (TTree*) file_phases.Get("mul");
+  if (pairs == 0 || phases == 0 || pairs->GetEntries() == 0
+   || pairs->GetEntries() != phases->GetEntries()) {
+    std::cout << "The mul trees do not have the same entries." << std::endl;
+    gSystem->Exit(1);
+  }
+  Int_t ndiff = 0;
+  TObjArray* leaves = pairs->GetListOfLeaves();
+  for (Long64_t entry = 0; entry < pairs->GetEntries(); entry++) {
+    pairs->GetEntry(entry);
+    phases->GetEntry(entry);
+    for (Int_t i = 0; i < leaves->GetEntriesFast(); i++) {
+      TLeaf* leaf_pairs  = (TLeaf*) leaves->At(i);
+      TLeaf* leaf_phases = phases->GetLeaf(leaf_pairs->GetBranch()->GetName(),
+                                           leaf_pairs->GetName());
+      if (leaf_phases == 0) {
+        std::cout << "Leaf " << leaf_pairs->GetBranch()->GetName() << "."
+                  << leaf_pairs->GetName() << " is missing." << std::endl;
+        gSystem->Exit(1);
+      }
+      for (Int_t j = 0; j < leaf_pairs->GetLen(); j++) {
+        Double_t value_pairs  = leaf_pairs->GetValue(j);
+        Double_t value_phases = leaf_phases->GetValue(j);
+        Double_t scale = TMath::Max(1.0,
+          TMath::Max(TMath::Abs(value_pairs), TMath::Abs(value_phases)));
+        if (TMath::Abs(value_pairs - value_phases) > 1e-9 * scale && ndiff++ < 10)
+          std::cout << "Entry " << entry << " " << leaf_pairs->GetBranch()->GetName()
+                    << "." << leaf_pairs->GetName() << ": " << value_pairs
+                    << " from the pairs, " << value_phases << " from the phases"
+                    << std::endl;
+      }
+    }
+  }
+  gSystem->Exit(ndiff > 0);
+}
+EOF
+
+root -l -b -q "${DIR}/compare.C(\"${DIR}/true/mock_10.root\",\"${DIR}/false/mock_10.root\")" || exit -1
+
+rm -rf ${DIR}
+
+exit 0
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+# Test 019:
+#
+#   Blind asymmetries and differences with the span blinding of QwBlinder
+#   and one value at a time, for each blinding strategy, and make sure that
+#   the results are identical bit for bit.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+build/qwblindertest || exit -1
+
+exit 0
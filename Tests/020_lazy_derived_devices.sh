@@ -0,0 +1,55 @@
+#!/bin/bash
+
+# Test 020:
+#
+#   Analyze the mock data run of test 004 without trees and histograms,
+#   once with the derived beamline devices that nothing reads skipped and
+#   once with all of them computed.  The energy calculator target_energy,
+#   which no output, cut or published value reads, must be skipped; the
+#   combined BCM bcm_target, which is published as q_targ, must not be
+#   skipped and must have the same pattern running average in both runs.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+DIR=`mktemp -d -t qwparity.XXXXXX`
+for lazy in true false ; do
+  build/qwparity -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map \
+    --disable-trees --disable-histos --print-patternsum \
+    --lazy-derived-devices=${lazy} --rootfiles ${DIR} > ${DIR}/${lazy}.out || exit -1
+done
+
+SKIPPED=`grep "derived devices without readers, not computed:" ${DIR}/true.out`
+if ! echo "${SKIPPED}" | grep -q " target_energy" ; then
+  echo "The unused energy calculator target_energy was not skipped."
+  exit -1
+fi
+if echo "${SKIPPED}" | grep -q " bcm_target" ; then
+  echo "The published combined BCM bcm_target was skipped."
+  exit -1
+fi
+if grep -q "derived devices without readers" ${DIR}/false.out ; then
+  echo "Derived devices were skipped with --lazy-derived-devices=false."
+  exit -1
+fi
+
+# First line of bcm_target in the pattern running averages: the yield
+LAZY=`sed -n '/Running average of patterns/,$p' ${DIR}/true.out | grep " bcm_target " | head -1`
+FULL=`sed -n '/Running average of patterns/,$p' ${DIR}/false.out | grep " bcm_target " | head -1`
+if [ -z "${LAZY}" -o "${LAZY}" != "${FULL}" ] ; then
+  echo "The running average of bcm_target differs when unused devices are skipped:"
+  echo "${LAZY}"
+  echo "${FULL}"
+  exit -1
+fi
+
+rm -rf ${DIR}
+
+exit 0
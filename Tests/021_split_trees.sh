@@ -0,0 +1,120 @@
+#!/bin/bash
+
+# Test 021:
+#
+#   Analyze the mock data run of test 004 with the default trees, and with
+#   --split-trees and --split-tree-floats.  In the split mul, pr and burst
+#   trees every leaf of a leaflist branch must be a branch "branch.leaf" of
+#   its own, with the type of the leaf, except for the double leaves of the
+#   asym_ and diff_ branches, which must be floats.  All columns must hold
+#   the values of the leaves, rounded to float for the float columns.
+#   Branches with a single leaf or with array leaves are not split.
+#
+
+setupscript=SetupFiles/SET_ME_UP.bash
+
+if [ ! -e ${setupscript} ] ; then
+  echo "Setup script ${setupscript} could not be found."
+  exit -1
+fi
+
+source ${setupscript} || exit -1
+
+DIR=`mktemp -d -t qwparity.XXXXXX`
+mkdir -p ${DIR}/leaflist ${DIR}/split
+# Short bursts, so that the burst tree has several entries
+build/qwparity -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map \
+  --burstlength 500 --min-burstlength 100 \
+  --rootfiles ${DIR}/leaflist --rootfile-stem mock_ > /dev/null || exit -1
+build/qwparity -r 10 -e :10000 --config qwparity.conf --detectors mock_detectors.map \
+  --burstlength 500 --min-burstlength 100 --split-trees --split-tree-floats \
+  --rootfiles ${DIR}/split --rootfile-stem mock_ > /dev/null || exit -1
+
+cat > ${DIR}/compare.C <<'EOF'
+void compare(const char* name_leaflist, const char* name_split)
+{
+  TFile file_leaflist(name_leaflist);
+  TFile file_split(name_split);
+  Int_t nbad = 0;
+  const char* trees[] = {"mul", "pr", "burst"};
+  for (Int_t t = 0; t < 3; t++) {
+    TTree* leaflist = (TTree*) file_leaflist.Get(trees[t]);
+    TTree* split    = (TTree*) file_split.Get(trees[t]);
+    if (leaflist == 0 || split == 0 || leaflist->GetEntries() == 0
+     || leaflist->GetEntries() != split->GetEntries()) {
+      std::cout << "The " << trees[t] << " trees do not have the same entries." << std::endl;
+      gSystem->Exit(1);
+    }
+
+    // Names and types of the columns
+    std::vector<TLeaf*> leaves, columns;
+    std::vector<Bool_t> floats;
+    TIter next(leaflist->GetListOfBranches());
+    while (TBranch* branch = (TBranch*) next()) {
+      TString name = branch->GetName();
+      Int_t nleaves = branch->GetListOfLeaves()->GetEntriesFast();
+      Bool_t splittable = (nleaves > 1);
+      for (Int_t l = 0; l < nleaves; l++) {
+        TLeaf* leaf = (TLeaf*) branch->GetListOfLeaves()->At(l);
+        splittable = splittable && leaf->GetLen() == 1 && leaf->GetLeafCount() == 0;
+      }
+      if (! splittable) continue;
+      if (split->GetBranch(name) != 0) {
+        std::cout << trees[t] << "." << name << " is not split." << std::endl;
+        nbad++;
+      }
+      Bool_t tofloat = name.BeginsWith("asym_") || name.BeginsWith("diff_");
+      for (Int_t l = 0; l < nleaves; l++) {
+        TLeaf* leaf = (TLeaf*) branch->GetListOfLeaves()->At(l);
+        TString column = name + "." + leaf->GetName();
+        TBranch* column_branch = split->GetBranch(column);
+        if (column_branch == 0 || column_branch->GetListOfLeaves()->GetEntriesFast() != 1) {
+          std::cout << trees[t] << "." << column << " is missing." << std::endl;
+          nbad++;
+          continue;
+        }
+        TLeaf* column_leaf = (TLeaf*) column_branch->GetListOfLeaves()->At(0);
+        Bool_t isfloat = tofloat && TString(leaf->GetTypeName()) == "Double_t";
+        TString type = isfloat ? "Float_t" : leaf->GetTypeName();
+        if (type != column_leaf->GetTypeName()) {
+          std::cout << trees[t] << "." << column << " is " << column_leaf->GetTypeName()
+                    << ", not " << type << std::endl;
+          nbad++;
+          continue;
+        }
+        leaves.push_back(leaf);
+        columns.push_back(column_leaf);
+        floats.push_back(isfloat);
+      }
+    }
+    if (leaves.size() == 0) {
+      std::cout << "The " << trees[t] << " tree has no columns." << std::endl;
+      nbad++;
+    }
+
+    // Values of the columns
+    Int_t ndiff = 0;
+    for (Long64_t entry = 0; entry < leaflist->GetEntries(); entry++) {
+      leaflist->GetEntry(entry);
+      split->GetEntry(entry);
+      for (size_t i = 0; i < leaves.size(); i++) {
+        Double_t value = leaves[i]->GetValue();
+        if (floats[i]) value = Float_t(value);
+        if (columns[i]->GetValue() != value && ndiff++ < 10)
+          std::cout << "Entry " << entry << " " << trees[t] << "." << columns[i]->GetName()
+                    << ": " << columns[i]->GetValue() << " instead of " << value << std::endl;
+      }
+    }
+    std::cout << trees[t] << ": " << leaves.size() << " columns, "
+              << leaflist->GetEntries() << " entries" << std::endl;
+    nbad += ndiff;
+  }
+  gSystem->Exit(nbad > 0);
+}
+EOF
+
+root -l -b -q "${DIR}/compare.C(\"${DIR}/leaflist/mock_10.root\",\"${DIR}/split/mock_10.root\")" || exit -1
+
+rm -rf ${DIR}
+
+exit 0
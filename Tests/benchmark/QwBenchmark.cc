@@ -0,0 +1,454 @@
+/*------------------------------------------------------------------------*//*!
+
+ \file QwBenchmark.cc
+
+ \brief Event-processing benchmark and performance regression gate
+
+ The benchmark generates a mock data run in a temporary CODA file using
+ the same mock parameters as qwmockdatagenerator, replays it through the
+ event loop of qwparity, and times each stage of the hot path separately:
+
+   - encode:      randomize and encode the subsystem data (mock generation)
+   - decode:      QwEventBuffer::FillSubsystemData (ProcessEvBuffer)
+   - process:     QwSubsystemArrayParity::ProcessEvent and single event cuts
+   - ring:        QwEventRing push and pop
+   - arithmetic:  subsystem array sum, difference, ratio, running sum
+   - asymmetry:   QwHelicityPattern::LoadEventData and CalculateAsymmetry
+   - linreg:      LinRegBevPeb running covariance update
+   - treefill:    QwRootFile::FillTreeBranches and FillTree
+   - replay:      the full replay loop, including all of the above
+
+ For every stage the throughput (calls per second) and the number of heap
+ allocations per call are reported.  The results can be written to a JSON
+ file with --bench-output, and compared against an earlier JSON file with
+ --bench-baseline; the exit code is non-zero when any stage regresses by
+ more than --bench-tolerance.
+
+*//*-------------------------------------------------------------------------*/
+
+// System headers
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// ROOT headers
+#include "TSystem.h"
+#include "TRandom3.h"
+#include "TVectorD.h"
+
+// Qweak headers
+#include "QwLog.h"
+#include "QwRootFile.h"
+#include "QwOptionsParity.h"
+#include "QwEventBuffer.h"
+#include "QwHistogramHelper.h"
+#include "QwSubsystemArrayParity.h"
+#include "QwHelicityPattern.h"
+#include "QwEventRing.h"
+#include "QwHelicity.h"
+#include "QwDetectorArray.h"
+#include "LinReg_Bevington_Pebay.h"
+
+
+//----------------------------------------------------------------------------
+// Allocation counting
+//
+// The global allocation functions are replaced in this executable only, so
+// that every heap allocation in the libraries is counted as well.
+static std::atomic<unsigned long long> gNumAllocations(0);
+
+void* operator new(std::size_t size)
+{
+  gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size)
+{
+  gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+
+//----------------------------------------------------------------------------
+/**
+ * \class QwBenchmarkStage
+ * \brief Accumulated timing and allocation count for one benchmark stage
+ */
+class QwBenchmarkStage {
+  public:
+    explicit QwBenchmarkStage(const std::string& name)
+    : fName(name), fCalls(0), fSeconds(0.0), fAllocations(0) { }
+
+    void Start() {
+      fStartAllocations = gNumAllocations.load(std::memory_order_relaxed);
+      fStartTime = std::chrono::steady_clock::now();
+    }
+    void Stop() {
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - fStartTime;
+      fSeconds += elapsed.count();
+      fAllocations += gNumAllocations.load(std::memory_order_relaxed) - fStartAllocations;
+      fCalls++;
+    }
+
+    const std::string& GetName() const { return fName; }
+    unsigned long long GetCalls() const { return fCalls; }
+    double GetSeconds() const { return fSeconds; }
+    double GetCallsPerSecond() const {
+      return (fSeconds > 0.0) ? fCalls / fSeconds : 0.0;
+    }
+    double GetAllocationsPerCall() const {
+      return (fCalls > 0) ? double(fAllocations) / fCalls : 0.0;
+    }
+
+  private:
+    std::string fName;
+    unsigned long long fCalls;
+    double fSeconds;
+    unsigned long long fAllocations;
+    unsigned long long fStartAllocations;
+    std::chrono::steady_clock::time_point fStartTime;
+};
+
+
+/// Summary of a stage as read back from a baseline file
+struct QwBenchmarkResult {
+  double calls_per_second;
+  double allocations_per_call;
+};
+
+
+//----------------------------------------------------------------------------
+/// Write the results as JSON, one stage per line
+static void WriteResults(std::ostream& stream,
+                         const std::vector<QwBenchmarkStage>& stages,
+                         int nevents)
+{
+  stream << "{" << std::endl;
+  stream << "  \"benchmark\": \"qwbenchmark\"," << std::endl;
+  stream << "  \"events\": " << nevents << "," << std::endl;
+  stream << "  \"stages\": [" << std::endl;
+  for (size_t i = 0; i < stages.size(); i++) {
+    const QwBenchmarkStage& stage = stages[i];
+    stream << "    {\"name\": \"" << stage.GetName() << "\""
+           << ", \"calls\": " << stage.GetCalls()
+           << ", \"seconds\": " << std::setprecision(6) << stage.GetSeconds()
+           << ", \"calls_per_second\": " << std::setprecision(8) << stage.GetCallsPerSecond()
+           << ", \"allocations_per_call\": " << std::setprecision(6) << stage.GetAllocationsPerCall()
+           << "}" << (i + 1 < stages.size() ? "," : "") << std::endl;
+  }
+  stream << "  ]" << std::endl;
+  stream << "}" << std::endl;
+}
+
+/// Read the results from a JSON file written by WriteResults
+static std::map<std::string,QwBenchmarkResult> ReadResults(const std::string& filename)
+{
+  std::map<std::string,QwBenchmarkResult> results;
+  std::ifstream file(filename.c_str());
+  if (! file.is_open()) {
+    QwError << "Could not open benchmark baseline " << filename << QwLog::endl;
+    return results;
+  }
+  static const std::regex line_regex(
+      "\"name\":\\s*\"([^\"]+)\".*"
+      "\"calls_per_second\":\\s*([-+0-9.eE]+).*"
+      "\"allocations_per_call\":\\s*([-+0-9.eE]+)");
+  std::string line;
+  while (std::getline(file, line)) {
+    std::smatch match;
+    if (std::regex_search(line, match, line_regex)) {
+      QwBenchmarkResult result;
+      result.calls_per_second     = std::atof(match[2].str().c_str());
+      result.allocations_per_call = std::atof(match[3].str().c_str());
+      results[match[1].str()] = result;
+    }
+  }
+  return results;
+}
+
+/// Compare the results against a baseline, return the number of regressions
+static int CompareResults(const std::vector<QwBenchmarkStage>& stages,
+                          const std::map<std::string,QwBenchmarkResult>& baseline,
+                          double tolerance)
+{
+  int nregressions = 0;
+  for (size_t i = 0; i < stages.size(); i++) {
+    const QwBenchmarkStage& stage = stages[i];
+    std::map<std::string,QwBenchmarkResult>::const_iterator base = baseline.find(stage.GetName());
+    if (base == baseline.end()) {
+      QwWarning << "Stage " << stage.GetName() << " not in baseline" << QwLog::endl;
+      continue;
+    }
+    // Throughput may not drop by more than the tolerance
+    double min_rate = base->second.calls_per_second * (1.0 - tolerance);
+    if (stage.GetCallsPerSecond() < min_rate) {
+      QwError << "Stage " << stage.GetName() << " regressed: "
+              << stage.GetCallsPerSecond() << " calls/s < "
+              << base->second.calls_per_second << " calls/s baseline" << QwLog::endl;
+      nregressions++;
+    }
+    // Allocations may not grow by more than the tolerance (allow half an
+    // allocation of slack so that stages with no allocations stay stable)
+    double max_allocs = base->second.allocations_per_call * (1.0 + tolerance) + 0.5;
+    if (stage.GetAllocationsPerCall() > max_allocs) {
+      QwError << "Stage " << stage.GetName() << " regressed: "
+              << stage.GetAllocationsPerCall() << " allocations/call > "
+              << base->second.allocations_per_call << " allocations/call baseline" << QwLog::endl;
+      nregressions++;
+    }
+  }
+  return nregressions;
+}
+
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  ///  Keep the benchmark ROOT files apart from regular output
+  QwRootFile::SetDefaultRootFileStem("QwBenchmark_");
+
+  ///  Define the command line options
+  DefineOptionsParity(gQwOptions);
+  gQwOptions.AddOptions("Benchmark options")
+    ("bench-events", po::value<int>()->default_value(20000),
+     "number of mock events to generate and replay");
+  gQwOptions.AddOptions("Benchmark options")
+    ("bench-output", po::value<std::string>()->default_value(""),
+     "write the benchmark results to this JSON file");
+  gQwOptions.AddOptions("Benchmark options")
+    ("bench-baseline", po::value<std::string>()->default_value(""),
+     "compare the benchmark results against this JSON file");
+  gQwOptions.AddOptions("Benchmark options")
+    ("bench-tolerance", po::value<double>()->default_value(0.10),
+     "relative regression tolerance for the baseline comparison");
+
+  ///  Fill the search paths for the parameter files
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QW_PRMINPUT"));
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QWANALYSIS") + "/Parity/prminput");
+  QwParameterFile::AppendToSearchPath(getenv_safe_string("QWANALYSIS") + "/Analysis/prminput");
+
+  gQwOptions.SetCommandLine(argc, argv);
+  gQwOptions.SetConfigFile("qwmockdataanalysis.conf");
+
+  gQwHists.ProcessOptions(gQwOptions);
+  gQwLog.ProcessOptions(&gQwOptions);
+
+  Int_t nevents = gQwOptions.GetValue<int>("bench-events");
+  std::string output = gQwOptions.GetValue<std::string>("bench-output");
+  std::string baseline = gQwOptions.GetValue<std::string>("bench-baseline");
+  Double_t tolerance = gQwOptions.GetValue<double>("bench-tolerance");
+
+  std::vector<QwBenchmarkStage> stages;
+  enum EStage { kEncode, kDecode, kProcess, kRing, kArithmetic,
+                kAsymmetry, kLinReg, kTreeFill, kReplay };
+  for (const char* name: {"encode", "decode", "process", "ring", "arithmetic",
+                          "asymmetry", "linreg", "treefill", "replay"})
+    stages.push_back(QwBenchmarkStage(name));
+
+  const UInt_t run = 1;
+  const TString run_label = "bench";
+
+  ///  Generate the mock data run
+  QwEventBuffer writer;
+  writer.ProcessOptions(gQwOptions);
+  TString filename = Form("%sQwBenchmark_%d.log", writer.GetDataDirectory().Data(), getpid());
+  {
+    QwSubsystemArrayParity detectors(gQwOptions);
+    detectors.ProcessOptions(gQwOptions);
+    detectors.LoadMockDataParameters("mock_parameters_list.map");
+
+    QwHelicity* helicity = dynamic_cast<QwHelicity*>(detectors.GetSubsystemByName("Helicity Info"));
+    if (! helicity) {
+      QwError << "No helicity subsystem defined!" << QwLog::endl;
+      return 1;
+    }
+    std::vector<VQwSubsystem*> detarrays = detectors.GetSubsystemByType("QwDetectorArray");
+
+    MQwMockable::Seed(run);
+    if (writer.OpenDataFile(filename,"W") != CODA_OK) {
+      QwError << "Could not open mock data file " << filename << QwLog::endl;
+      return 1;
+    }
+    writer.ResetControlParameters();
+    writer.EncodePrestartEvent(run, 0);
+    writer.EncodeGoEvent();
+
+    helicity->SetEventPatternPhase(-1, -1, -1);
+    helicity->SetFirstBits(24, (0x1234 ^ run) & 0xFFFFFF);
+    for (Int_t event = 0; event < nevents; event++) {
+      stages[kEncode].Start();
+      detectors.ClearEventData();
+      helicity->SetEventPatternPhase(event, event / 64, event % 64 + 1);
+      helicity->RunPredictor();
+      int myhelicity = helicity->GetHelicityActual() ? +1 : -1;
+      detectors.RandomizeEventData(myhelicity, event * detectors.GetWindowPeriod());
+      for (size_t i = 0; i < detarrays.size(); i++) {
+        QwDetectorArray* detarray = dynamic_cast<QwDetectorArray*>(detarrays[i]);
+        detarray->ExchangeProcessedData();
+        detarray->RandomizeMollerEvent(myhelicity);
+      }
+      Int_t status = writer.EncodeSubsystemData(detectors);
+      stages[kEncode].Stop();
+      if (status != CODA_OK) {
+        QwError << "Could not write mock event " << event << QwLog::endl;
+        return 1;
+      }
+    }
+    writer.EncodeEndEvent();
+    writer.CloseDataFile();
+  }
+
+  ///  Replay the mock data run
+  {
+    QwEventBuffer eventbuffer;
+    eventbuffer.ProcessOptions(gQwOptions);
+    if (eventbuffer.OpenDataFile(filename,"R") != CODA_OK) {
+      QwError << "Could not open mock data file " << filename << QwLog::endl;
+      return 1;
+    }
+
+    QwSubsystemArrayParity detectors(gQwOptions);
+    detectors.ProcessOptions(gQwOptions);
+
+    QwHelicityPattern helicitypattern(detectors, run_label);
+    helicitypattern.ProcessOptions(gQwOptions);
+    QwEventRing eventring(gQwOptions, detectors);
+
+    QwSubsystemArrayParity ringoutput(detectors);
+    QwSubsystemArrayParity previous(detectors);
+    QwSubsystemArrayParity scratch(detectors);
+    QwSubsystemArrayParity ratio(detectors);
+    QwSubsystemArrayParity eventsum(detectors);
+
+    ///  Regression on a fixed set of random monitor and detector values,
+    ///  with the dimensions of a typical correction
+    const int nP = 5, nY = 20;
+    LinRegBevPeb linreg;
+    linreg.setDims(nP, nY);
+    linreg.init();
+    std::vector<std::pair<TVectorD,TVectorD> > linreg_input(64);
+    TRandom3 random(run);
+    for (size_t i = 0; i < linreg_input.size(); i++) {
+      linreg_input[i].first.ResizeTo(nP);
+      linreg_input[i].second.ResizeTo(nY);
+      for (int p = 0; p < nP; p++) linreg_input[i].first(p) = random.Gaus();
+      for (int y = 0; y < nY; y++) linreg_input[i].second(y) = random.Gaus();
+    }
+
+    QwRootFile* rootfile = new QwRootFile(run_label);
+    rootfile->ConstructTreeBranches("evt", "MPS event data tree", ringoutput);
+    rootfile->ConstructTreeBranches("mul", "Helicity event data tree", helicitypattern);
+
+    Int_t nphysics = 0;
+    while (eventbuffer.GetNextEvent() == CODA_OK) {
+      if (! eventbuffer.IsPhysicsEvent()) continue;
+
+      stages[kReplay].Start();
+
+      stages[kDecode].Start();
+      eventbuffer.FillSubsystemData(detectors);
+      stages[kDecode].Stop();
+
+      stages[kProcess].Start();
+      detectors.ProcessEvent();
+      Bool_t passed = detectors.ApplySingleEventCuts();
+      stages[kProcess].Stop();
+
+      if (passed) {
+        stages[kRing].Start();
+        eventring.push(detectors);
+        Bool_t ready = eventring.IsReady();
+        if (ready) ringoutput = eventring.pop();
+        stages[kRing].Stop();
+
+        if (ready) {
+          stages[kArithmetic].Start();
+          if (nphysics > 0) {
+            scratch.Sum(ringoutput, previous);
+            scratch.Difference(ringoutput, previous);
+            ratio.Ratio(scratch, previous);
+          }
+          previous = ringoutput;
+          eventsum.AccumulateRunningSum(ringoutput);
+          stages[kArithmetic].Stop();
+
+          stages[kTreeFill].Start();
+          rootfile->FillTreeBranches(ringoutput);
+          rootfile->FillTree("evt");
+          stages[kTreeFill].Stop();
+
+          stages[kLinReg].Start();
+          linreg += linreg_input[nphysics % linreg_input.size()];
+          stages[kLinReg].Stop();
+
+          stages[kAsymmetry].Start();
+          helicitypattern.LoadEventData(ringoutput);
+          Bool_t good = helicitypattern.IsGoodAsymmetry();
+          stages[kAsymmetry].Stop();
+
+          if (good) {
+            stages[kTreeFill].Start();
+            rootfile->FillTreeBranches(helicitypattern);
+            rootfile->FillTree("mul");
+            stages[kTreeFill].Stop();
+
+            helicitypattern.ClearEventData();
+          }
+          nphysics++;
+        }
+      }
+
+      stages[kReplay].Stop();
+    }
+    eventbuffer.CloseDataFile();
+
+    ///  Remove the benchmark output files
+    TString rootfilename = Form("%s/QwBenchmark_%s.root",
+        gQwOptions.GetValue<std::string>("rootfiles").c_str(), run_label.Data());
+    delete rootfile;
+    gSystem->Unlink(rootfilename);
+  }
+  gSystem->Unlink(filename);
+
+  ///  Report the results
+  WriteResults(std::cout, stages, nevents);
+  if (! output.empty()) {
+    std::ofstream file(output.c_str());
+    WriteResults(file, stages, nevents);
+    QwMessage << "Wrote benchmark results to " << output << QwLog::endl;
+  }
+
+  ///  Compare against the baseline
+  if (! baseline.empty()) {
+    std::map<std::string,QwBenchmarkResult> results = ReadResults(baseline);
+    if (results.empty()) {
+      QwError << "No results in benchmark baseline " << baseline << QwLog::endl;
+      return 1;
+    }
+    int nregressions = CompareResults(stages, results, tolerance);
+    if (nregressions > 0) {
+      QwError << nregressions << " benchmark regressions with respect to "
+              << baseline << QwLog::endl;
+      return 1;
+    }
+    QwMessage << "No benchmark regressions with respect to " << baseline << QwLog::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*------------------------------------------------------------------------*//*!
+
+ \file QwBlinderTest.cc
+
+ \ingroup QwAnalysis_BL
+
+ \brief main(...) function for the qwblindertest executable
+
+ Blinds a set of asymmetries, and of differences against their yields, with
+ the span blinding of QwBlinder and one value at a time, for each blinding
+ strategy, and requires that both give the same results bit for bit.
+ Returns non-zero on a mismatch.
+
+*//*-------------------------------------------------------------------------*/
+
+// System headers
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+// Qweak headers
+#include "QwLog.h"
+#include "QwParameterFile.h"
+#include "QwBlinder.h"
+
+Int_t main(Int_t /*argc*/, Char_t* /*argv*/[])
+{
+  //  Blinder parameters without a strategy, so that the strategy passed to
+  //  the constructor is used
+  char dir[] = "/tmp/QwBlinderTest.XXXXXX";
+  if (mkdtemp(dir) == 0) {
+    QwError << "Could not create a directory for the blinder parameters" << QwLog::endl;
+    return 1;
+  }
+  std::string mapfile = std::string(dir) + "/blinder.map";
+  std::ofstream map(mapfile.c_str());
+  map << "seed = span blinding test seed" << std::endl;
+  map << "max_asymmetry = 0.06" << std::endl;
+  map << "max_factor = 0.1" << std::endl;
+  map.close();
+  QwParameterFile::AppendToSearchPath(dir);
+
+  //  Asymmetries of about -1000 to +1000 ppb, and yields around one; an odd
+  //  number of values, so that vectorized loops have a remainder
+  const size_t n = 37;
+  std::vector<Double_t> values(n), yields(n);
+  for (size_t i = 0; i < n; i++) {
+    values[i] = (Double_t(i) - 18.0) * 5.3e-8 + 1.0e-9 / (i + 1);
+    yields[i] = 1.0 + 0.013 * (Double_t(i) - 18.0);
+  }
+
+  Int_t failures = 0;
+  QwBlinder::EQwBlindingStrategy strategies[] = {
+    QwBlinder::kAdditive,
+    QwBlinder::kMultiplicative,
+    QwBlinder::kAdditiveMultiplicative
+  };
+  for (size_t s = 0; s < sizeof(strategies)/sizeof(strategies[0]); s++) {
+    QwBlinder blinder(strategies[s]);
+
+    std::vector<Double_t> span(values), single(values);
+    blinder.BlindValues(span.data(), n);
+    for (size_t i = 0; i < n; i++)
+      blinder.BlindValue(single[i]);
+    if (memcmp(span.data(), single.data(), n * sizeof(Double_t)) != 0) {
+      QwError << "Span blinding of asymmetries differs from the blinding of "
+              << "single values for strategy " << strategies[s] << QwLog::endl;
+      failures++;
+    }
+
+    span = values;
+    single = values;
+    blinder.BlindValues(span.data(), yields.data(), n);
+    for (size_t i = 0; i < n; i++)
+      blinder.BlindValue(single[i], yields[i]);
+    if (memcmp(span.data(), single.data(), n * sizeof(Double_t)) != 0) {
+      QwError << "Span blinding of differences differs from the blinding of "
+              << "single values for strategy " << strategies[s] << QwLog::endl;
+      failures++;
+    }
+  }
+
+  remove(mapfile.c_str());
+  rmdir(dir);
+
+  if (failures == 0)
+    QwMessage << "Span blinding agrees with the blinding of single values" << QwLog::endl;
+  return (failures > 0);
+}
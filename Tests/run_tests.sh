@@ -5,7 +5,8 @@
 #    Executable scripts in the test directory with format [0-9][0-9][0-9]_*.sh
 #    are executed.  Success is indicated by a zero return value, failure by a
 #    non-zero return value.  Regression tests should explicitly return a value
-#    with 'exit [n]'.
+#    with 'exit [n]'.  A test which cannot run in this build (e.g. because an
+#    optional executable was not built) returns 77 and is reported as skipped.
 #
 
 testdir="Tests"
@@ -22,8 +23,13 @@ for test in ${tests} ; do
   fi
 
   echo "Running $test..."
-  if $test ; then
+  $test
+  status=$?
+  if [ $status -eq 0 ] ; then
     echo "$test succeeded."
+  elif [ $status -eq 77 ] ; then
+    echo "$test skipped."
+    skipped="${skipped} ${test}"
   else
     echo "$test failed."
     exit -1
@@ -31,4 +37,7 @@ for test in ${tests} ; do
 
 done
 
+if [ -n "${skipped}" ] ; then
+  echo "Skipped regression tests:${skipped}"
+fi
 echo "All regression tests were successful."
@@ -0,0 +1,136 @@
+/*------------------------------------------------------------------------*//*!
+
+ \file QwSharedMemoryTest.cc
+
+ \ingroup QwAnalysis
+
+ \brief main(...) function for the qwsharedmemorytest executable
+
+ Publishes a histogram with variable bins, a two-dimensional histogram and
+ the entries of a tree object with QwSharedMemoryWriter, reads them back
+ with QwSharedMemory::Reader, and compares the bins, bin edges, entries
+ and tree values with what was written.  Returns non-zero on a mismatch.
+
+*//*-------------------------------------------------------------------------*/
+
+// System headers
+#include <cstddef>
+#include <unistd.h>
+
+// ROOT headers
+#include "TROOT.h"
+#include "TDirectory.h"
+#include "TH1D.h"
+#include "TH2D.h"
+
+// Qweak headers
+#include "QwLog.h"
+#include "QwSharedMemoryWriter.h"
+
+/// Branch vector of the test tree object
+struct Entry {
+  Double_t fValue;
+  Int_t    fCount;
+  Int_t    fPadding;
+};
+
+static Int_t failures = 0;
+
+static void Check(Bool_t ok, const std::string& what)
+{
+  if (ok) return;
+  QwError << "Shared memory round trip: " << what << QwLog::endl;
+  failures++;
+}
+
+Int_t main(Int_t /*argc*/, Char_t* /*argv*/[])
+{
+  std::string name = Form("/QwSharedMemoryTest.%d", getpid());
+
+  //  Histograms, one with variable bins
+  TDirectory* dir = gROOT->mkdir("shmtest");
+  dir->cd();
+  Double_t edges[] = { 0.0, 1.0, 2.5, 5.0, 10.0 };
+  TH1D* h1 = new TH1D("h1", "variable bins", 4, edges);
+  TH2D* h2 = new TH2D("h2", "two dimensions", 3, -1.0, 2.0, 2, 0.0, 4.0);
+  for (Int_t i = 0; i < 20; i++) {
+    h1->Fill(0.55 * i, 1.0 + 0.1 * i);
+    h2->Fill(-1.5 + 0.2 * i, 0.3 * i);
+  }
+
+  Entry entry = { 0.0, 0, 0 };
+  const Int_t nentries = 6;
+  const UInt_t ringsize = 4;
+  {
+    QwSharedMemoryWriter writer(name, ringsize);
+    writer.AddHistograms(dir, "shmtest");
+    // Registering a directory again must not publish its histograms twice
+    writer.AddHistograms(dir, "shmtest");
+    std::vector<std::string> columns = { "value", "count" };
+    std::vector<size_t> offsets = { offsetof(Entry, fValue), offsetof(Entry, fCount) };
+    std::vector<char> types = { 'D', 'I' };
+    Int_t ring = writer.AddRing("evt", &entry, sizeof(entry), columns, offsets, types);
+    for (Int_t n = 0; n < nentries; n++) {
+      entry.fValue = 0.25 * n;
+      entry.fCount = n;
+      writer.PublishEntry(ring);
+    }
+    writer.PublishHistograms();
+
+    //  Read back
+    QwSharedMemory::Reader reader;
+    Check(reader.Attach(name), "region " + name + " could not be attached");
+    if (reader.IsAttached()) {
+      Check(reader.GetNumberOfHistograms() == 2, "expected 2 histograms");
+      for (size_t i = 0; i < reader.GetNumberOfHistograms(); i++) {
+        const QwSharedMemory::Histogram& record = reader.GetHistogram(i);
+        std::string histoname = record.fName;
+        TH1* histo = (histoname == "shmtest/h1")? static_cast<TH1*>(h1):
+                     (histoname == "shmtest/h2")? static_cast<TH1*>(h2): 0;
+        Check(histo != 0, "unexpected histogram " + histoname);
+        if (histo == 0) continue;
+
+        std::vector<double> cells;
+        double entries = 0;
+        Check(reader.ReadHistogram(i, cells, entries), histoname + " could not be read");
+        Check(cells.size() == size_t(histo->GetNcells()), histoname + " has wrong number of cells");
+        for (size_t bin = 0; bin < cells.size() && bin < size_t(histo->GetNcells()); bin++)
+          Check(cells[bin] == histo->GetBinContent(bin), Form("%s bin %zu differs", histoname.c_str(), bin));
+        Check(entries == histo->GetEntries(), histoname + " entries differ");
+
+        std::vector<double> xedges, yedges;
+        reader.ReadEdges(i, xedges, yedges);
+        for (Int_t bin = 1; bin <= histo->GetNbinsX() + 1; bin++)
+          Check(xedges.at(bin - 1) == histo->GetXaxis()->GetBinLowEdge(bin),
+                Form("%s x edge %d differs", histoname.c_str(), bin));
+        Check(yedges.size() == ((histo->GetDimension() == 2)? size_t(histo->GetNbinsY() + 1): 0),
+              histoname + " has wrong number of y edges");
+        for (size_t bin = 0; bin < yedges.size(); bin++)
+          Check(yedges[bin] == histo->GetYaxis()->GetBinLowEdge(bin + 1),
+                Form("%s y edge %zu differs", histoname.c_str(), bin));
+      }
+
+      Check(reader.GetNumberOfRings() == 1, "expected 1 ring");
+      if (reader.GetNumberOfRings() == 1) {
+        std::vector< std::vector<char> > entries;
+        uint64_t head = reader.ReadRing(0, entries);
+        Check(head == uint64_t(nentries), "ring head differs");
+        Check(entries.size() == ringsize, "ring does not hold its capacity of entries");
+        const QwSharedMemory::Ring& record = reader.GetRing(0);
+        for (size_t n = 0; n < entries.size(); n++) {
+          Int_t written = nentries - entries.size() + n;
+          Check(QwSharedMemory::GetValue(entries[n].data(), reader.GetColumn(record, 0)) == 0.25 * written,
+                Form("ring entry %d value differs", written));
+          Check(QwSharedMemory::GetValue(entries[n].data(), reader.GetColumn(record, 1)) == written,
+                Form("ring entry %d count differs", written));
+        }
+      }
+      reader.Detach();
+    }
+  }
+  shm_unlink(name.c_str());
+
+  if (failures == 0)
+    QwMessage << "Shared memory round trip: ok" << QwLog::endl;
+  return (failures == 0)? 0: 1;
+}
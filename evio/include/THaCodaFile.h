@@ -20,6 +20,7 @@
 #include "THaCodaData.h"
 #include "CustomAlloc.h"
 #include <vector>
+#include <cstdint>
 
 
 class THaCodaFile : public THaCodaData {
@@ -42,12 +43,22 @@ public:
   void  setMaxEvFilt(UInt_t max_event);        // max num events to filter
   virtual bool isOpen() const;
 
+  // Random access (memory-mapped EVIO 4 files only)
+  Int_t codaOpenRandomAccess(const char* filename);
+  Int_t codaSeek(UInt_t event_index);           // next codaRead returns this event
+  bool  isRandomAccess() const { return fEventTable != nullptr; }
+  UInt_t getNumEvents() const { return fNumEvents; }
+  UInt_t getNextEventIndex() const { return fNextEvent; }
+
 private:
 
   void init(const char* fname="");
   UInt_t max_to_filt;
   UInt_t maxflist,maxftype;
   std::vector<UInt_t> evlist, evtypes;
+  const uint32_t** fEventTable; //! Pointers to the events in the mapped file
+  UInt_t fNumEvents;            //! Number of events in the mapped file
+  UInt_t fNextEvent;            //! Index of the next event to read
 
   ClassDef(THaCodaFile,0)   //  File of CODA data
 
@@ -25,6 +25,7 @@
 #include <RQ_OBJECT.h>
 #include <TQObject.h>
 #include <vector>
+#include <map>
 #include <TString.h>
 #include <TCut.h>
 #include <TTimer.h>
@@ -35,6 +36,8 @@
 
 #define UPDATETIME 10000
 
+namespace QwSharedMemory { class Reader; }
+
 class OnlineGUI {
   // Class that takes care of the GUI
   RQ_OBJECT("OnlineGUI")
@@ -67,6 +70,15 @@ private:
   TMapFile*                         fMapFile;
   Bool_t                            fIsMapFile;
 #endif
+  // When the configured rootfile is "shm:<name>", histograms and recent
+  // tree entries are read from the shared-memory region published by the
+  // analyzer with --enable-shmem.  The histograms and trees are kept here
+  // and refilled from the region on every update.
+  QwSharedMemory::Reader*           fSharedMemory;
+  Bool_t                            fIsSharedMemory;
+  std::map<TString, TH1*>           fSharedHistos;
+  std::vector<TTree*>               fSharedTrees;
+  std::vector<std::vector<Double_t> > fSharedRows;
   Bool_t                            doGolden;
   std::vector <TTree*>                   fRootTree;
   std::vector <Int_t>                    fTreeEntries;
@@ -144,6 +156,17 @@ public:
   // TMapFile::Get() which clones the object out of shared memory.
   TObject* GetObjectFromFile(const TString& name);
 #endif
+  // Returns kTRUE when path names a shared-memory region ("shm:<name>").
+  static Bool_t LooksLikeSharedMemory(const TString& path);
+  // (Re)attach to the shared-memory region; the producer replaces it
+  // at the start of every run.
+  Bool_t AttachSharedMemory();
+  // List the histograms and trees in the shared-memory region.
+  void GetSharedMemoryObjects();
+  // Refill the trees from the rings in the shared-memory region.
+  void GetSharedMemoryTrees();
+  // Histogram with the current bin contents from the shared-memory region.
+  TH1* GetSharedHistogram(const TString& name);
   void PrintToFile();
   void PrintPages();
   void MyCloseWindow();
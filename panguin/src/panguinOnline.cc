@@ -28,6 +28,7 @@
 #include "TEnv.h"
 #include "TRegexp.h"
 #include "TGraph.h"
+#include "QwSharedMemory.h"
 
 #define OLDTIMERUPDATE
 
@@ -48,6 +49,8 @@ OnlineGUI::OnlineGUI(OnlineConfig& config, Bool_t printonly=0, int ver=0):
   fMapFile(nullptr),
   fIsMapFile(kFALSE),
 #endif
+  fSharedMemory(nullptr),
+  fIsSharedMemory(kFALSE),
   fFileAlive(kFALSE),
   fVerbosity(ver)
 {
@@ -78,6 +81,26 @@ void OnlineGUI::CreateGUI(const TGWindow *p, UInt_t w, UInt_t h)
 
   // Open the RootFile.  Die if it doesn't exist.
   //  unless we're watching a file.
+  fIsSharedMemory = LooksLikeSharedMemory(fConfig->GetRootFile());
+  if(fIsSharedMemory) {
+    fRootFile = NULL;
+    if(!AttachSharedMemory()) {
+      cout << "ERROR:  shared memory: " << fConfig->GetRootFile()
+           << " could not be attached"
+           << endl;
+      if(fConfig->IsMonitor()) {
+        cout << "Will wait... hopefully.." << endl;
+      } else {
+        gApplication->Terminate();
+      }
+    } else {
+      fFileAlive = kTRUE;
+      runNumber  = fConfig->GetRunNumber();
+      GetFileObjects();
+      GetRootTree();
+      GetTreeVars();
+    }
+  } else {
 #ifdef QW_ENABLE_MAPFILE
   fIsMapFile = LooksLikeMapFile(fConfig->GetRootFile());
   if(fIsMapFile) {
@@ -173,7 +196,14 @@ void OnlineGUI::CreateGUI(const TGWindow *p, UInt_t w, UInt_t h)
 
   }
 #endif // QW_ENABLE_MAPFILE
+  }
   TString goldenfilename=fConfig->GetGoldenFile();
+  if(fIsSharedMemory && !goldenfilename.IsNull()) {
+    cout << "NOTE:  goldenrootfile comparison is not supported in shared "
+            "memory mode; ignoring '" << goldenfilename << "'."
+         << endl;
+    goldenfilename = "";
+  }
 #ifdef QW_ENABLE_MAPFILE
   // Golden-file comparison requires "switching back" to the main file via
   // fRootFile->cd(), which is not meaningful with a TMapFile.  Refuse the
@@ -371,7 +401,8 @@ void OnlineGUI::CreateGUI(const TGWindow *p, UInt_t w, UInt_t h)
 
   if(fConfig->IsMonitor()) {
     timer = new TTimer();
-    if(fFileAlive) {
+    // In shared-memory mode TimerUpdate also waits for the producer
+    if(fFileAlive || fIsSharedMemory) {
       timer->Connect(timer,"Timeout()","OnlineGUI",this,"TimerUpdate()");
     } else {
       timer->Connect(timer,"Timeout()","OnlineGUI",this,"CheckRootFile()");
@@ -577,6 +608,128 @@ Bool_t OnlineGUI::IsHistogram(TString objectname)
 
 }
 
+Bool_t OnlineGUI::LooksLikeSharedMemory(const TString& path)
+{
+  // A path is interpreted as a shared-memory region published by the
+  // analyzer (--enable-shmem) when it starts with "shm:", as in
+  // 'rootfile shm:/QwLive'.
+  return path.BeginsWith("shm:");
+}
+
+Bool_t OnlineGUI::AttachSharedMemory()
+{
+  // Attach again on every call: the producer replaces the region at
+  // the start of every run, and a mapping of the old region stays valid.
+  if(fSharedMemory == nullptr) fSharedMemory = new QwSharedMemory::Reader();
+  TString name = fConfig->GetRootFile();
+  name.Remove(0, 4);
+  if(!name.BeginsWith("/")) name.Prepend("/");
+  return fSharedMemory->Attach(name.Data());
+}
+
+void OnlineGUI::GetSharedMemoryObjects()
+{
+  // Histograms are listed by their full path, trees by their ring name.
+  fileObjects.clear();
+  if(fSharedMemory == nullptr || !fSharedMemory->IsAttached()) {
+    fUpdate = kFALSE;
+    return;
+  }
+  for(size_t i=0; i<fSharedMemory->GetNumberOfHistograms(); i++) {
+    const QwSharedMemory::Histogram& histo = fSharedMemory->GetHistogram(i);
+    fileObjects.push_back(make_pair(TString(histo.fName),
+                                    TString(histo.fDimension == 2 ? "TH2D" : "TH1D")));
+  }
+  for(size_t i=0; i<fSharedMemory->GetNumberOfRings(); i++)
+    fileObjects.push_back(make_pair(TString(fSharedMemory->GetRing(i).fName),
+                                    TString("TTree")));
+  fUpdate = (fileObjects.size() > 0);
+}
+
+TH1* OnlineGUI::GetSharedHistogram(const TString& name)
+{
+  // Find the histogram by full path, or by the end of its path, and copy
+  // the current bin contents into the histogram kept for it.
+  if(fSharedMemory == nullptr || !fSharedMemory->IsAttached()) return nullptr;
+  for(size_t i=0; i<fSharedMemory->GetNumberOfHistograms(); i++) {
+    const QwSharedMemory::Histogram& record = fSharedMemory->GetHistogram(i);
+    TString histoname = record.fName;
+    if(histoname != name && !histoname.EndsWith("/" + name)) continue;
+
+    TH1* histo = fSharedHistos[histoname];
+    if(histo == nullptr
+       || histo->GetNcells() != Int_t(record.fNumberOfCells)
+       || histo->GetDimension() != Int_t(record.fDimension)) {
+      delete histo;
+      // Rebuild with the stored bin edges, so that variable bins survive
+      std::vector<double> xedges, yedges;
+      fSharedMemory->ReadEdges(i, xedges, yedges);
+      if(record.fDimension == 2)
+        histo = new TH2D(histoname, record.fTitle,
+                         record.fNbinsX, xedges.data(),
+                         record.fNbinsY, yedges.data());
+      else
+        histo = new TH1D(histoname, record.fTitle,
+                         record.fNbinsX, xedges.data());
+      histo->SetDirectory(0);
+      fSharedHistos[histoname] = histo;
+    }
+    std::vector<double> cells;
+    double entries = 0;
+    if(!fSharedMemory->ReadHistogram(i, cells, entries)) {
+      // The producer holds the histogram (or died while writing it);
+      // show the bins of the previous update
+      if(fVerbosity>=1)
+        cout << "Shared memory histogram " << histoname
+             << " not updated: producer busy" << endl;
+      return histo;
+    }
+    for(size_t bin=0; bin<cells.size(); bin++)
+      histo->SetBinContent(bin, cells[bin]);
+    histo->SetEntries(entries);
+    return histo;
+  }
+  return nullptr;
+}
+
+void OnlineGUI::GetSharedMemoryTrees()
+{
+  // Every ring becomes an in-memory tree with one branch per column,
+  // filled with the entries currently in the ring.
+  for(auto *t : fSharedTrees) delete t;
+  fSharedTrees.clear();
+  fSharedRows.clear();
+  fRootTree.clear();
+  fTreeEntries.clear();
+  if(fSharedMemory == nullptr || !fSharedMemory->IsAttached()) return;
+
+  fSharedRows.resize(fSharedMemory->GetNumberOfRings());
+  for(size_t r=0; r<fSharedMemory->GetNumberOfRings(); r++) {
+    const QwSharedMemory::Ring& ring = fSharedMemory->GetRing(r);
+    TString treename = ring.fName;
+    treename.ReplaceAll("/", "_");
+    TTree* tree = new TTree(treename, ring.fName);
+    tree->SetDirectory(0);
+    std::vector<Double_t>& row = fSharedRows[r];
+    row.resize(ring.fNumberOfColumns);
+    for(size_t c=0; c<ring.fNumberOfColumns; c++) {
+      TString column = fSharedMemory->GetColumn(ring, c).fName;
+      tree->Branch(column, &row[c], column + "/D");
+    }
+    std::vector< std::vector<char> > entries;
+    fSharedMemory->ReadRing(r, entries);
+    for(size_t e=0; e<entries.size(); e++) {
+      for(size_t c=0; c<ring.fNumberOfColumns; c++)
+        row[c] = QwSharedMemory::GetValue(entries[e].data(),
+                                          fSharedMemory->GetColumn(ring, c));
+      tree->Fill();
+    }
+    fSharedTrees.push_back(tree);
+    fRootTree.push_back(tree);
+    fTreeEntries.push_back(0);
+  }
+}
+
 #ifdef QW_ENABLE_MAPFILE
 Bool_t OnlineGUI::LooksLikeMapFile(const TString& path)
 {
@@ -606,6 +759,10 @@ void OnlineGUI::GetFileObjects()
   // Utility to find all of the objects within a File (TTree, TH1F, etc).
   //  The pair stored in the vector is <ObjName, ObjType>
   //  If there's no good keys.. do nothing.
+  if(fIsSharedMemory) {
+    GetSharedMemoryObjects();
+    return;
+  }
 #ifdef QW_ENABLE_MAPFILE
   if(fIsMapFile) {
     // A TMapFile is not a TDirectory and has no key dictionary; instead
@@ -705,6 +862,10 @@ void OnlineGUI::GetTreeVars()
 void OnlineGUI::GetRootTree() {
   // Utility to search a ROOT File for ROOT Trees
   // Fills the fRootTree vector
+  if(fIsSharedMemory) {
+    GetSharedMemoryTrees();
+    return;
+  }
 #ifdef QW_ENABLE_MAPFILE
   // In mapfile mode TMapFile::Get returns caller-owned clones; release the
   // previous batch before fetching a fresh snapshot, otherwise every refresh
@@ -1017,6 +1178,20 @@ void OnlineGUI::TimerUpdate() {
   if(fVerbosity>=1)
     cout<<__PRETTY_FUNCTION__<<"\t"<<__LINE__<<endl;
 
+  if(fIsSharedMemory) {
+    // Nothing is streamed: reattach (the region is replaced for every run),
+    // list the objects and refill the trees from the rings.  Histograms
+    // are refilled from the region when they are drawn.
+    if(AttachSharedMemory()) {
+      GetFileObjects();
+      GetRootTree();
+      GetTreeVars();
+      if(fUpdate) DoDraw();
+    }
+    timer->Reset();
+    return;
+  }
+
 #ifdef QW_ENABLE_MAPFILE
   if(fIsMapFile) {
     // TMapFile points at a live, producer-updated shared-memory region.
@@ -1263,6 +1438,9 @@ void OnlineGUI::HistDraw(vector <TString> command) {
   for(UInt_t i=0; i<fileObjects.size(); i++) {
     if (fileObjects[i].first.Contains(command[0])) {
       if(fileObjects[i].second.Contains("TH1")) {
+	if(fIsSharedMemory) {
+	  mytemp1d = (TH1D*)GetSharedHistogram(command[0]);
+	} else {
 #ifdef QW_ENABLE_MAPFILE
 	if(fIsMapFile) {
 	  mytemp1d = (TH1D*)GetObjectFromFile(command[0]);
@@ -1274,6 +1452,7 @@ void OnlineGUI::HistDraw(vector <TString> command) {
 	if(showGolden) fRootFile->cd();
 	mytemp1d = (TH1D*)gDirectory->Get(command[0]);
 #endif
+	}
 	if(mytemp1d==NULL || mytemp1d->GetEntries()==0) {
 	  BadDraw("Empty Histogram");
 	} else {
@@ -1295,6 +1474,9 @@ void OnlineGUI::HistDraw(vector <TString> command) {
 	break;
       }
       if(fileObjects[i].second.Contains("TH2")) {
+	if(fIsSharedMemory) {
+	  mytemp2d = (TH2D*)GetSharedHistogram(command[0]);
+	} else {
 #ifdef QW_ENABLE_MAPFILE
 	if(fIsMapFile) {
 	  mytemp2d = (TH2D*)GetObjectFromFile(command[0]);
@@ -1306,6 +1488,7 @@ void OnlineGUI::HistDraw(vector <TString> command) {
 	if(showGolden) fRootFile->cd();
 	mytemp2d = (TH2D*)gDirectory->Get(command[0]);
 #endif
+	}
 	if(mytemp2d==NULL || mytemp2d->GetEntries()==0) {
 	  BadDraw("Empty Histogram");
 	} else {
@@ -1658,6 +1841,19 @@ void OnlineGUI::PrintPages() {
 
   // Open the RootFile
   //  unless we're watching a file.
+  fIsSharedMemory = LooksLikeSharedMemory(fConfig->GetRootFile());
+  if(fIsSharedMemory) {
+    if(!AttachSharedMemory()) {
+      cout << "ERROR:  shared memory: " << fConfig->GetRootFile()
+           << " could not be attached" << endl;
+      gApplication->Terminate();
+    } else {
+      fFileAlive = kTRUE;
+      GetFileObjects();
+      GetRootTree();
+      GetTreeVars();
+    }
+  } else {
 #ifdef QW_ENABLE_MAPFILE
   fIsMapFile = LooksLikeMapFile(fConfig->GetRootFile());
   if(fIsMapFile) {
@@ -1708,7 +1904,13 @@ void OnlineGUI::PrintPages() {
 #ifdef QW_ENABLE_MAPFILE
   }
 #endif
+  }
   TString goldenfilename=fConfig->GetGoldenFile();
+  if(fIsSharedMemory && !goldenfilename.IsNull()) {
+    cout << "NOTE:  goldenrootfile comparison is not supported in shared "
+            "memory mode; ignoring '" << goldenfilename << "'." << endl;
+    goldenfilename = "";
+  }
 #ifdef QW_ENABLE_MAPFILE
   if(fIsMapFile && !goldenfilename.IsNull()) {
     cout << "NOTE:  goldenrootfile comparison is not supported in TMapFile "
@@ -2052,6 +2254,13 @@ OnlineGUI::~OnlineGUI()
   delete fMain;
   if(fGoldenFile!=NULL) delete fGoldenFile;
   if(fRootFile!=NULL) delete fRootFile;
+  // Shared-memory trees and histograms are owned here
+  for(auto *t : fSharedTrees) delete t;
+  fSharedTrees.clear();
+  for(auto &h : fSharedHistos) delete h.second;
+  fSharedHistos.clear();
+  delete fSharedMemory;
+  fSharedMemory = nullptr;
 #ifdef QW_ENABLE_MAPFILE
   // Mapfile-resident TTree clones are caller-owned; release them before
   // detaching from the shared-memory region.